@@ -0,0 +1,157 @@
+#ifndef __ADDRESS_HASH_MAP_H__
+#define __ADDRESS_HASH_MAP_H__
+
+#include <assert.h>
+
+#include "fixed_types.h"
+
+// Map from (cache line) addresses to small values, for the coherence
+// controllers' per-address bookkeeping.
+// Open addressing with linear probing in one flat array; erased slots are
+// refilled by shifting the rest of the cluster back, so there are no
+// tombstones. Lookups of absent keys stop at the first empty slot.
+// INVALID_ADDRESS is reserved as the empty key.
+// Pointers and references to values are invalidated by insert() and erase()
+template <class V>
+class AddressHashMap
+{
+   private:
+      struct Slot
+      {
+         IntPtr key;
+         V value;
+      };
+
+      Slot* m_slots;
+      UInt32 m_log_capacity;
+      UInt32 m_mask;
+      UInt32 m_size;
+
+      UInt32 hash(IntPtr key)
+      {
+         // Fibonacci hashing: the low bits of line addresses are all zero
+         return (UInt32) ((((UInt64) key) * 0x9e3779b97f4a7c15ULL) >> (64 - m_log_capacity));
+      }
+
+      void allocate(UInt32 log_capacity)
+      {
+         m_log_capacity = log_capacity;
+         m_mask = (1 << log_capacity) - 1;
+         m_slots = new Slot[1 << log_capacity];
+         for (UInt32 i = 0; i <= m_mask; i++)
+            m_slots[i].key = INVALID_ADDRESS;
+      }
+
+      void grow()
+      {
+         Slot* old_slots = m_slots;
+         UInt32 old_capacity = m_mask + 1;
+
+         allocate(m_log_capacity + 1);
+         for (UInt32 i = 0; i < old_capacity; i++)
+         {
+            if (old_slots[i].key == INVALID_ADDRESS)
+               continue;
+            UInt32 index = hash(old_slots[i].key);
+            while (m_slots[index].key != INVALID_ADDRESS)
+               index = (index + 1) & m_mask;
+            m_slots[index] = old_slots[i];
+         }
+         delete [] old_slots;
+      }
+
+   public:
+      AddressHashMap(UInt32 log_capacity = 6):
+         m_size(0)
+      {
+         allocate(log_capacity);
+      }
+      ~AddressHashMap()
+      {
+         delete [] m_slots;
+      }
+
+      UInt32 size() { return m_size; }
+      // Empties the map; the capacity is kept
+      void clear()
+      {
+         for (UInt32 i = 0; i <= m_mask; i++)
+            m_slots[i].key = INVALID_ADDRESS;
+         m_size = 0;
+      }
+
+      // Iteration over the slots; empty slots have the key INVALID_ADDRESS
+      UInt32 capacity() { return m_mask + 1; }
+      IntPtr keyAt(UInt32 index) { return m_slots[index].key; }
+      V& valueAt(UInt32 index) { return m_slots[index].value; }
+
+      // NULL if 'key' is not present
+      V* find(IntPtr key)
+      {
+         for (UInt32 index = hash(key); m_slots[index].key != INVALID_ADDRESS; index = (index + 1) & m_mask)
+         {
+            if (m_slots[index].key == key)
+               return &m_slots[index].value;
+         }
+         return (V*) NULL;
+      }
+
+      UInt32 count(IntPtr key)
+      {
+         return (find(key) != NULL) ? 1 : 0;
+      }
+
+      // Inserts a value-initialized entry if 'key' is not present
+      V& operator[](IntPtr key)
+      {
+         assert(key != INVALID_ADDRESS);
+
+         UInt32 index = hash(key);
+         for ( ; m_slots[index].key != INVALID_ADDRESS; index = (index + 1) & m_mask)
+         {
+            if (m_slots[index].key == key)
+               return m_slots[index].value;
+         }
+
+         // Keep the load factor at most 1/2
+         if (2 * (m_size + 1) > m_mask + 1)
+         {
+            grow();
+            index = hash(key);
+            while (m_slots[index].key != INVALID_ADDRESS)
+               index = (index + 1) & m_mask;
+         }
+
+         m_slots[index].key = key;
+         m_slots[index].value = V();
+         m_size ++;
+         return m_slots[index].value;
+      }
+
+      void erase(IntPtr key)
+      {
+         UInt32 index = hash(key);
+         for ( ; m_slots[index].key != key; index = (index + 1) & m_mask)
+         {
+            if (m_slots[index].key == INVALID_ADDRESS)
+               return;
+         }
+
+         // Move back the entries of the cluster that the hole now separates
+         // from their home slot
+         UInt32 hole = index;
+         for (index = (hole + 1) & m_mask; m_slots[index].key != INVALID_ADDRESS; index = (index + 1) & m_mask)
+         {
+            UInt32 home = hash(m_slots[index].key);
+            if (((index - home) & m_mask) >= ((index - hole) & m_mask))
+            {
+               m_slots[hole] = m_slots[index];
+               hole = index;
+            }
+         }
+         m_slots[hole].key = INVALID_ADDRESS;
+         m_size --;
+      }
+};
+
+#endif /* __ADDRESS_HASH_MAP_H__ */
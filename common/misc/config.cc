@@ -19,6 +19,10 @@ bool Config::m_knob_enable_performance_modeling;
 bool Config::m_knob_enable_dcache_modeling;
 bool Config::m_knob_enable_icache_modeling;
 bool Config::m_knob_enable_power_modeling;
+bool Config::m_knob_enable_data_storage;
+bool Config::m_knob_enable_pep_cores;
+std::string Config::m_knob_snapshot_save_dir;
+std::string Config::m_knob_snapshot_load_dir;
 
 using namespace std;
 
@@ -46,6 +50,10 @@ Config::Config()
       m_knob_enable_dcache_modeling = Sim()->getCfg()->getBool("general/enable_dcache_modeling");
       m_knob_enable_icache_modeling = Sim()->getCfg()->getBool("general/enable_icache_modeling");
       m_knob_enable_power_modeling = Sim()->getCfg()->getBool("general/enable_power_modeling");
+      m_knob_enable_data_storage = Sim()->getCfg()->getBool("general/enable_data_storage", true);
+      m_knob_enable_pep_cores = Sim()->getCfg()->getBool("general/enable_pep_cores", false);
+      m_knob_snapshot_save_dir = Sim()->getCfg()->getString("snapshot/save_dir", "");
+      m_knob_snapshot_load_dir = Sim()->getCfg()->getString("snapshot/load_dir", "");
 
       // Simulation Mode
       m_simulation_mode = parseSimulationMode(Sim()->getCfg()->getString("general/mode"));
@@ -66,6 +74,20 @@ Config::Config()
       exit(EXIT_FAILURE);
    }
 
+   // In full mode, the memory system is the only copy of the application's data
+   if ((m_simulation_mode == FULL) && (!m_knob_enable_data_storage))
+   {
+      fprintf(stderr, "ERROR: general/enable_data_storage can be false only in lite mode\n");
+      exit(EXIT_FAILURE);
+   }
+
+   // The PEP cores share the L2 Caches of the main cores
+   if (m_knob_enable_pep_cores && (!m_knob_simarch_has_shared_mem))
+   {
+      fprintf(stderr, "ERROR: general/enable_pep_cores needs general/enable_shared_mem\n");
+      exit(EXIT_FAILURE);
+   }
+
    m_singleton = this;
 
    assert(m_num_processes > 0);
@@ -318,6 +340,26 @@ bool Config::getEnablePowerModeling() const
    return (bool)m_knob_enable_power_modeling;
 }
 
+bool Config::getEnableDataStorage() const
+{
+   return (bool)m_knob_enable_data_storage;
+}
+
+bool Config::getEnablePepCores() const
+{
+   return (bool)m_knob_enable_pep_cores;
+}
+
+std::string Config::getSnapshotSaveDir() const
+{
+   return m_knob_snapshot_save_dir;
+}
+
+std::string Config::getSnapshotLoadDir() const
+{
+   return m_knob_snapshot_load_dir;
+}
+
 std::string Config::getOutputFileName() const
 {
    return formatOutputFileName(m_knob_output_file);
@@ -162,6 +162,12 @@ public:
    bool getEnableDCacheModeling() const;
    bool getEnableICacheModeling() const;
    bool getEnablePowerModeling() const;
+   bool getEnableDataStorage() const;
+   bool getEnablePepCores() const;
+
+   // Memory system snapshots (empty if disabled)
+   std::string getSnapshotSaveDir() const;
+   std::string getSnapshotLoadDir() const;
 
    // Logging
    std::string getOutputFileName() const;
@@ -212,6 +218,10 @@ private:
    static bool m_knob_enable_dcache_modeling;
    static bool m_knob_enable_icache_modeling;
    static bool m_knob_enable_power_modeling;
+   static bool m_knob_enable_data_storage;
+   static bool m_knob_enable_pep_cores;
+   static std::string m_knob_snapshot_save_dir;
+   static std::string m_knob_snapshot_load_dir;
 
    // Get Tile & Network Parameters
    void parseCoreParameters();
@@ -22,7 +22,9 @@ typedef uintptr_t carbon_reg_t;
 
 // The core_type_t enum allows you to add additional cores per tile.
 // To do so, add a class that derives from the Core class, and instantiate it from the Tile constructor.
-typedef enum core_type_t { MAIN_CORE_TYPE = 0 } core_type_t;
+// The PEP core (present if [general] enable_pep_cores is set) runs a helper
+// thread with its own L1 Caches, on the L2 Cache of the main core.
+typedef enum core_type_t { MAIN_CORE_TYPE = 0, PEP_CORE_TYPE } core_type_t;
 
 // Cores are labeled by core_id_t, which identify the tile that contains them, and their type. 
 typedef struct {
@@ -0,0 +1,251 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <deque>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "lock.h"
+#include "fixed_types.h"
+
+// Multi-producer, single-consumer FIFO queue of small items (pointers).
+// Producers claim the cells of a bounded ring with a compare-and-swap and
+// never take a lock while the ring has room. When it is full, they fall back
+// on a locked overflow list; the items of a producer stay in order.
+// An empty queue makes the consumer spin for a while and then sleep on a
+// futex. Producers only make a system call when the consumer is asleep.
+template <class T>
+class MpscQueue
+{
+   public:
+      // 'capacity' must be a power of 2
+      MpscQueue(UInt32 capacity);
+      ~MpscQueue();
+
+      // Any thread
+      void push(const T& item);
+
+      // The consumer only
+      bool tryPop(T& item);
+      T pop();
+      // Waits for at least one item, then takes the ones queued, up to 'max_items'
+      UInt32 popBatch(T* items, UInt32 max_items);
+      bool empty();
+
+   private:
+      struct Cell
+      {
+         volatile UInt64 seq_num;
+         T item;
+      };
+
+      static const UInt32 MIN_SPIN_COUNT = 16;
+      static const UInt32 MAX_SPIN_COUNT = 4096;
+
+      Cell* m_cells;
+      UInt64 m_mask;
+
+      // Producers
+      volatile UInt64 m_tail;
+      Byte m_padding[64];
+
+      // Consumer
+      UInt64 m_head;
+      UInt32 m_spin_count;
+      // Overflow items taken out of the overflow list, ahead of the ring
+      std::deque<T> m_drained;
+
+      std::deque<T> m_overflow;
+      volatile bool m_overflowed;
+      // Ring tail when the overflow list got its first item. The cells
+      // before it may still be claimed but not yet written, and are taken
+      // before the overflow list
+      UInt64 m_overflow_tail;
+      Lock m_overflow_lock;
+
+      // 1 while the consumer sleeps
+      volatile int m_futx;
+
+      bool tryPushRing(const T& item);
+      void wakeConsumer();
+};
+
+template <class T>
+MpscQueue<T>::MpscQueue(UInt32 capacity)
+   : m_mask(capacity - 1)
+   , m_tail(0)
+   , m_head(0)
+   , m_spin_count(MIN_SPIN_COUNT)
+   , m_overflowed(false)
+   , m_overflow_tail(0)
+   , m_futx(0)
+{
+   assert((capacity > 0) && ((capacity & (capacity - 1)) == 0));
+
+   m_cells = new Cell[capacity];
+   for (UInt32 i = 0; i < capacity; i++)
+      m_cells[i].seq_num = i;
+}
+
+template <class T>
+MpscQueue<T>::~MpscQueue()
+{
+   delete [] m_cells;
+}
+
+template <class T>
+bool MpscQueue<T>::tryPushRing(const T& item)
+{
+   UInt64 pos = m_tail;
+   Cell* cell;
+   while (true)
+   {
+      cell = &m_cells[pos & m_mask];
+      SInt64 diff = (SInt64) cell->seq_num - (SInt64) pos;
+      if (diff == 0)
+      {
+         if (__sync_bool_compare_and_swap(&m_tail, pos, pos + 1))
+            break;
+         pos = m_tail;
+      }
+      else if (diff < 0)
+      {
+         // Full
+         return false;
+      }
+      else
+      {
+         pos = m_tail;
+      }
+   }
+
+   cell->item = item;
+   __sync_synchronize();
+   cell->seq_num = pos + 1;
+   return true;
+}
+
+template <class T>
+void MpscQueue<T>::push(const T& item)
+{
+   // While the overflow list holds items, all the producers append to it:
+   // the items of each producer stay in order
+   if (m_overflowed || !tryPushRing(item))
+   {
+      m_overflow_lock.acquire();
+      if (!m_overflowed)
+         m_overflow_tail = m_tail;
+      m_overflow.push_back(item);
+      m_overflowed = true;
+      m_overflow_lock.release();
+   }
+
+   wakeConsumer();
+}
+
+template <class T>
+void MpscQueue<T>::wakeConsumer()
+{
+   __sync_synchronize();
+   if ((m_futx == 1) && __sync_bool_compare_and_swap(&m_futx, 1, 0))
+      syscall(SYS_futex, (void*) &m_futx, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+template <class T>
+bool MpscQueue<T>::tryPop(T& item)
+{
+   if (!m_drained.empty())
+   {
+      item = m_drained.front();
+      m_drained.pop_front();
+      return true;
+   }
+
+   Cell* cell = &m_cells[m_head & m_mask];
+   if (cell->seq_num == m_head + 1)
+   {
+      __sync_synchronize();
+      item = cell->item;
+      __sync_synchronize();
+      cell->seq_num = m_head + m_mask + 1;
+      m_head ++;
+      return true;
+   }
+
+   // The overflow items are newer than the ring cells claimed before the
+   // overflow started; a producer may not have written its cell yet
+   if (m_overflowed)
+   {
+      m_overflow_lock.acquire();
+      if (m_head >= m_overflow_tail)
+      {
+         m_drained.swap(m_overflow);
+         m_overflowed = false;
+      }
+      m_overflow_lock.release();
+
+      if (!m_drained.empty())
+      {
+         item = m_drained.front();
+         m_drained.pop_front();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+template <class T>
+T MpscQueue<T>::pop()
+{
+   T item;
+
+   // Spin longer when spinning paid off the last time, shorter when it did not
+   for (UInt32 i = 0; i < m_spin_count; i++)
+   {
+      if (tryPop(item))
+      {
+         if ((i > 0) && (m_spin_count < MAX_SPIN_COUNT))
+            m_spin_count <<= 1;
+         return item;
+      }
+   }
+   if (m_spin_count > MIN_SPIN_COUNT)
+      m_spin_count >>= 1;
+
+   while (true)
+   {
+      m_futx = 1;
+      __sync_synchronize();
+      if (tryPop(item))
+      {
+         m_futx = 0;
+         return item;
+      }
+      syscall(SYS_futex, (void*) &m_futx, FUTEX_WAIT, 1, NULL, NULL, 0);
+   }
+}
+
+template <class T>
+UInt32 MpscQueue<T>::popBatch(T* items, UInt32 max_items)
+{
+   assert(max_items > 0);
+
+   items[0] = pop();
+   UInt32 num_items = 1;
+   while ((num_items < max_items) && tryPop(items[num_items]))
+      num_items ++;
+   return num_items;
+}
+
+template <class T>
+bool MpscQueue<T>::empty()
+{
+   return (m_drained.empty() &&
+           (m_cells[m_head & m_mask].seq_num != m_head + 1) &&
+           !m_overflowed);
+}
+
+#endif // MPSC_QUEUE_H
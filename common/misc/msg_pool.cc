@@ -0,0 +1,112 @@
+#include <assert.h>
+
+#include "msg_pool.h"
+#include "tls.h"
+
+TLS* MsgPool::m_thread_cache_tls = NULL;
+std::vector<MsgPool::ThreadCache*> MsgPool::m_thread_caches;
+Lock MsgPool::m_thread_caches_lock;
+
+void MsgPool::allocate()
+{
+   assert(m_thread_cache_tls == NULL);
+   m_thread_cache_tls = TLS::create();
+}
+
+void MsgPool::release()
+{
+   assert(m_thread_cache_tls);
+
+   // Buffers freed from now on go straight back to the heap
+   TLS* thread_cache_tls = m_thread_cache_tls;
+   m_thread_cache_tls = NULL;
+   delete thread_cache_tls;
+
+   for (UInt32 i = 0; i < m_thread_caches.size(); i++)
+   {
+      for (UInt32 c = 0; c < NUM_SIZE_CLASSES; c++)
+      {
+         std::vector<Byte*>& free_list = m_thread_caches[i]->free_lists[c];
+         for (UInt32 j = 0; j < free_list.size(); j++)
+            delete [] free_list[j];
+      }
+      delete m_thread_caches[i];
+   }
+   m_thread_caches.clear();
+}
+
+UInt32 MsgPool::getSizeClass(UInt32 size)
+{
+   UInt32 size_class = 0;
+   UInt32 class_size = MIN_BUFFER_SIZE;
+   while ((class_size < size) && (size_class < NUM_SIZE_CLASSES))
+   {
+      class_size <<= 1;
+      size_class ++;
+   }
+   return size_class;
+}
+
+MsgPool::ThreadCache* MsgPool::getThreadCache()
+{
+   if (m_thread_cache_tls == NULL)
+      return NULL;
+
+   ThreadCache* thread_cache = m_thread_cache_tls->getPtr<ThreadCache>();
+   if (thread_cache == NULL)
+   {
+      thread_cache = new ThreadCache();
+      m_thread_cache_tls->set(thread_cache);
+
+      ScopedLock sl(m_thread_caches_lock);
+      m_thread_caches.push_back(thread_cache);
+   }
+   return thread_cache;
+}
+
+Byte* MsgPool::allocBuffer(UInt32 size)
+{
+   UInt32 size_class = getSizeClass(size);
+   Byte* raw_buffer = NULL;
+
+   if (size_class == OVERSIZED)
+   {
+      raw_buffer = new Byte[sizeof(BufferHeader) + size];
+   }
+   else
+   {
+      ThreadCache* thread_cache = getThreadCache();
+      if ((thread_cache != NULL) && (!thread_cache->free_lists[size_class].empty()))
+      {
+         raw_buffer = thread_cache->free_lists[size_class].back();
+         thread_cache->free_lists[size_class].pop_back();
+      }
+      else
+      {
+         raw_buffer = new Byte[sizeof(BufferHeader) + (MIN_BUFFER_SIZE << size_class)];
+      }
+   }
+
+   ((BufferHeader*) raw_buffer)->size_class = size_class;
+   return raw_buffer + sizeof(BufferHeader);
+}
+
+void MsgPool::freeBuffer(const void* buffer)
+{
+   assert(buffer);
+   Byte* raw_buffer = ((Byte*) buffer) - sizeof(BufferHeader);
+   UInt32 size_class = ((BufferHeader*) raw_buffer)->size_class;
+   assert(size_class <= OVERSIZED);
+
+   if (size_class != OVERSIZED)
+   {
+      ThreadCache* thread_cache = getThreadCache();
+      if ((thread_cache != NULL) && (thread_cache->free_lists[size_class].size() < MAX_FREE_BUFFERS))
+      {
+         thread_cache->free_lists[size_class].push_back(raw_buffer);
+         return;
+      }
+   }
+
+   delete [] raw_buffer;
+}
@@ -0,0 +1,52 @@
+#ifndef MSG_POOL_H
+#define MSG_POOL_H
+
+#include <vector>
+
+#include "fixed_types.h"
+#include "lock.h"
+
+class TLS;
+
+// Size-classed pool of network message buffers.
+// Every thread keeps its own free list per size class, so allocating and
+// freeing a buffer takes no lock. A buffer is usually allocated by the
+// sending thread and freed by the receiving one; it then simply joins the
+// receiver's free list. Free lists are capped, the excess goes back to the heap.
+class MsgPool
+{
+   public:
+      static void allocate();
+      static void release();
+
+      static Byte* allocBuffer(UInt32 size);
+      static void freeBuffer(const void* buffer);
+
+   private:
+      static const UInt32 NUM_SIZE_CLASSES = 7;
+      static const UInt32 MIN_BUFFER_SIZE = 64;
+      static const UInt32 MAX_FREE_BUFFERS = 1024;
+      // Buffers larger than the biggest size class are not pooled
+      static const UInt32 OVERSIZED = NUM_SIZE_CLASSES;
+
+      // In front of every buffer; 16 bytes keep the payload 16-byte aligned
+      struct BufferHeader
+      {
+         UInt32 size_class;
+         UInt32 padding[3];
+      };
+
+      struct ThreadCache
+      {
+         std::vector<Byte*> free_lists[NUM_SIZE_CLASSES];
+      };
+
+      static TLS* m_thread_cache_tls;
+      static std::vector<ThreadCache*> m_thread_caches;
+      static Lock m_thread_caches_lock;
+
+      static UInt32 getSizeClass(UInt32 size);
+      static ThreadCache* getThreadCache();
+};
+
+#endif // MSG_POOL_H
@@ -152,8 +152,6 @@ NetworkModelEClos::computeAction(const NetPacket& pkt)
 void
 NetworkModelEClos::routePacket(const NetPacket& pkt, vector<Hop>& next_hops)
 {
-   ScopedLock sl(_lock);
-
    Stage curr_stage = (pkt.specific == (UInt32) -1) ? (SENDING_CORE) : ((Stage) pkt.specific);
 
    Stage next_stage = NUM_STAGES;
@@ -189,23 +187,56 @@ NetworkModelEClos::routePacket(const NetPacket& pkt, vector<Hop>& next_hops)
 
       case MIDDLE_ROUTER:
          {
-            SInt32 egress_router_idx = (pkt.receiver.tile_id != NetPacket::BROADCAST) ? (pkt.receiver.tile_id / _m) : -1;
             next_stage = EGRESS_ROUTER;
 
             EClosNode* eclos_node = _eclos_node_list[MIDDLE_ROUTER];
             assert(eclos_node);
-            eclos_node->process(pkt.time, num_flits, egress_router_idx, next_dest_info_vec);
+            if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+            {
+               // The egress routers of the destinations
+               vector<tile_id_t> dests;
+               getMulticastDests(pkt, dests);
+               vector<SInt32> egress_router_idx_list;
+               for (UInt32 i = 0; i < dests.size(); i++)
+               {
+                  SInt32 egress_router_idx = dests[i] / _m;
+                  if (egress_router_idx_list.empty() || (egress_router_idx_list.back() != egress_router_idx))
+                     egress_router_idx_list.push_back(egress_router_idx);
+               }
+               eclos_node->process(pkt.time, num_flits, egress_router_idx_list, next_dest_info_vec);
+            }
+            else
+            {
+               SInt32 egress_router_idx = (pkt.receiver.tile_id != NetPacket::BROADCAST) ? (pkt.receiver.tile_id / _m) : -1;
+               eclos_node->process(pkt.time, num_flits, egress_router_idx, next_dest_info_vec);
+            }
          }
          break;
 
       case EGRESS_ROUTER:
          {
-            SInt32 receiving_node_idx = (pkt.receiver.tile_id != NetPacket::BROADCAST) ? (pkt.receiver.tile_id % _m) : -1;
             next_stage = RECEIVING_CORE;
             
             EClosNode* eclos_node = _eclos_node_list[EGRESS_ROUTER];
             assert(eclos_node);
-            eclos_node->process(pkt.time, num_flits, receiving_node_idx, next_dest_info_vec);
+            if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+            {
+               // The destinations connected to this router
+               vector<tile_id_t> dests;
+               getMulticastDests(pkt, dests);
+               vector<SInt32> receiving_node_idx_list;
+               for (UInt32 i = 0; i < dests.size(); i++)
+               {
+                  if ((dests[i] / _m) == eclos_node->getRouterIdx())
+                     receiving_node_idx_list.push_back(dests[i] % _m);
+               }
+               eclos_node->process(pkt.time, num_flits, receiving_node_idx_list, next_dest_info_vec);
+            }
+            else
+            {
+               SInt32 receiving_node_idx = (pkt.receiver.tile_id != NetPacket::BROADCAST) ? (pkt.receiver.tile_id % _m) : -1;
+               eclos_node->process(pkt.time, num_flits, receiving_node_idx, next_dest_info_vec);
+            }
          }
          break;
 
@@ -227,6 +258,9 @@ NetworkModelEClos::routePacket(const NetPacket& pkt, vector<Hop>& next_hops)
       {
          SInt32 curr_router_idx = _eclos_node_list[EGRESS_ROUTER]->getRouterIdx();
          hop.next_dest.tile_id = (curr_router_idx * _m) + next_router_idx;
+         // Each destination of a multicast gets a unicast packet
+         if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+            hop.final_dest.tile_id = hop.next_dest.tile_id;
       }
       else
       {
@@ -272,12 +306,12 @@ NetworkModelEClos::getName(Stage stage)
 void
 NetworkModelEClos::processReceivedPacket(NetPacket& pkt)
 {
-   ScopedLock sl(_lock);
-
    pair<bool,bool> modeled = isModeled(pkt);
    if ( (modeled.first == true) || 
         ((modeled.second == true) && isApplicationTile(getNetwork()->getTile()->getId())) )
    {
+      ScopedLock sl(_lock);
+
       SInt32 pkt_length = getNetwork()->getModeledLength(pkt);
       SInt32 num_flits = computeProcessingTime(pkt_length);
 
@@ -324,7 +358,21 @@ NetworkModelEClos::processCornerCases(const NetPacket& pkt, vector<Hop>& next_ho
    }
    else // both elements are false
    {
-      if (pkt.receiver.tile_id == NetPacket::BROADCAST)
+      if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+      {
+         vector<tile_id_t> dests;
+         getMulticastDests(pkt, dests);
+         for (UInt32 i = 0; i < dests.size(); i++)
+         {
+            Hop hop;
+            hop.next_dest.tile_id = dests[i];
+            hop.final_dest.tile_id = dests[i];
+            hop.specific = RECEIVING_CORE;
+            hop.time = pkt.time;
+            next_hops.push_back(hop);
+         }
+      }
+      else if (pkt.receiver.tile_id == NetPacket::BROADCAST)
       {
          for (UInt32 i = 0; i < Config::getSingleton()->getTotalTiles(); i++)
          {
@@ -368,7 +416,14 @@ NetworkModelEClos::isModeled(const NetPacket& pkt)
    }
    else if (_enabled && isApplicationTile(requester) && isApplicationTile(pkt.sender.tile_id))
    {
-      if (isApplicationTile(pkt.receiver.tile_id))
+      if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+      {
+         // Modeled if all the destinations are application tiles
+         vector<tile_id_t> dests;
+         getMulticastDests(pkt, dests);
+         return make_pair<bool,bool>(isApplicationTile(dests.back()), false);
+      }
+      else if (isApplicationTile(pkt.receiver.tile_id))
          return make_pair<bool,bool>(true, false);
       else if (pkt.receiver.tile_id == NetPacket::BROADCAST)
          return make_pair<bool,bool>(false, true);
@@ -381,6 +436,17 @@ NetworkModelEClos::isModeled(const NetPacket& pkt)
    }
 }
 
+// In increasing order
+void
+NetworkModelEClos::getMulticastDests(const NetPacket& pkt, vector<tile_id_t>& dests)
+{
+   for (tile_id_t i = 0; i < (tile_id_t) Config::getSingleton()->getTotalTiles(); i++)
+   {
+      if (pkt.isMulticastDest(i))
+         dests.push_back(i);
+   }
+}
+
 bool
 NetworkModelEClos::isApplicationTile(tile_id_t tile_id)
 {
@@ -391,7 +457,9 @@ SInt32
 NetworkModelEClos::getRandNum(SInt32 start, SInt32 end)
 {
    double result;
+   _rand_lock.acquire();
    drand48_r(&_rand_data_buffer, &result);
+   _rand_lock.release();
    return (SInt32) (start + result * (end - start));
 }
 
@@ -488,6 +556,7 @@ NetworkModelEClos::EClosNode::EClosNode(SInt32 router_idx,
       for (SInt32 i = 0; i < output_ports; i++)
          _contention_models.push_back(QueueModel::create(contention_model_type, 1));
    }
+   _contention_model_locks = new Lock[output_ports];
 
    _router_model = ElectricalNetworkRouterModel::create(input_ports, output_ports, 
          num_flits_per_output_port, flit_width);
@@ -511,35 +580,46 @@ NetworkModelEClos::EClosNode::~EClosNode()
       for (SInt32 i = 0; i < _output_ports; i++)
          delete _contention_models[i];
    }
+   delete [] _contention_model_locks;
 }
 
+// output_link_id == -1 sends the packet on all the output links
 void
 NetworkModelEClos::EClosNode::process(UInt64 pkt_time, SInt32 num_flits, SInt32 output_link_id,
       vector<pair<SInt32,UInt64> >& next_dest_info_vec)
 {
-   SInt32 num_output_links = (output_link_id == -1) ? _output_ports : 1;
-
+   vector<SInt32> output_link_ids;
    if (output_link_id != -1)
    {
+      output_link_ids.push_back(output_link_id);
+   }
+   else
+   {
+      for (SInt32 i = 0; i < _output_ports; i++)
+         output_link_ids.push_back(i);
+   }
+   process(pkt_time, num_flits, output_link_ids, next_dest_info_vec);
+}
+
+void
+NetworkModelEClos::EClosNode::process(UInt64 pkt_time, SInt32 num_flits, const vector<SInt32>& output_link_ids,
+      vector<pair<SInt32,UInt64> >& next_dest_info_vec)
+{
+   SInt32 num_output_links = output_link_ids.size();
+
+   for (SInt32 i = 0; i < num_output_links; i++)
+   {
+      SInt32 output_link_id = output_link_ids[i];
       assert((output_link_id >= 0) && (output_link_id < _output_ports));
       // Calculate Output Link Contention
       UInt64 contention_delay = _contention_model_enabled ? 
-         _contention_models[output_link_id]->computeQueueDelay(pkt_time, num_flits) : 0;
+         computeContentionDelay(output_link_id, pkt_time, num_flits) : 0;
       
       next_dest_info_vec.push_back(make_pair<SInt32,UInt64>(output_link_id,
                contention_delay + _router_delay + _link_delay));
    }
-   else
-   {
-      for (SInt32 i = 0; i < _output_ports; i++)
-      {
-         UInt64 contention_delay = _contention_model_enabled ? 
-            _contention_models[i]->computeQueueDelay(pkt_time, num_flits) : 0;
-         
-         next_dest_info_vec.push_back(make_pair<SInt32,UInt64>(i,
-                  contention_delay + _router_delay + _link_delay));
-      }
-   }
+
+   ScopedLock sl(_lock);
    
    if (Config::getSingleton()->getEnablePowerModeling())
    {
@@ -565,12 +645,20 @@ NetworkModelEClos::EClosNode::process(UInt64 pkt_time, SInt32 num_flits, SInt32
 
    _switch_allocator_arbitrates ++;
    _crossbar_traversals_unicast += (num_output_links == 1) ? num_flits : 0;
-   _crossbar_traversals_broadcast += (num_output_links == _output_ports) ? num_flits : 0;
+   // Multicasts are counted as broadcasts
+   _crossbar_traversals_broadcast += ((num_output_links == _output_ports) || (num_output_links > 1)) ? num_flits : 0;
    _buffer_writes += (num_output_links * num_flits);
    _buffer_reads += (num_output_links * num_flits);
    _output_link_traversals += (num_output_links * num_flits);
 }
 
+UInt64
+NetworkModelEClos::EClosNode::computeContentionDelay(SInt32 output_link_id, UInt64 pkt_time, SInt32 num_flits)
+{
+   ScopedLock sl(_contention_model_locks[output_link_id]);
+   return _contention_models[output_link_id]->computeQueueDelay(pkt_time, num_flits);
+}
+
 void
 NetworkModelEClos::EClosNode::outputSummary(ostream& out)
 {
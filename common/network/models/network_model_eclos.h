@@ -33,6 +33,7 @@ class NetworkModelEClos : public NetworkModel
       UInt32 computeAction(const NetPacket& pkt);
       void routePacket(const NetPacket& pkt, vector<Hop>& next_hops);
       void processReceivedPacket(NetPacket& pkt);
+      bool isMulticastSupported() { return true; }
 
       void outputSummary(ostream& out);
 
@@ -57,18 +58,23 @@ class NetworkModelEClos : public NetworkModel
             SInt32 getRouterIdx() { return _router_idx; }
             void process(UInt64 pkt_time, SInt32 num_flits, SInt32 output_link_id,
                   vector<pair<SInt32,UInt64> >& next_dest_info_vec);
+            void process(UInt64 pkt_time, SInt32 num_flits, const vector<SInt32>& output_link_ids,
+                  vector<pair<SInt32,UInt64> >& next_dest_info_vec);
             void outputSummary(ostream& out);
             static void dummyOutputSummary(ostream& out);
 
          private:
+            UInt64 computeContentionDelay(SInt32 output_link_id, UInt64 pkt_time, SInt32 num_flits);
+
             SInt32 _router_idx;
             SInt32 _input_ports;
             SInt32 _output_ports;
             SInt32 _flit_width;
             
-            // Router (Output Link) Contention Models
+            // Router (Output Link) Contention Models, each guarded by its own lock
             bool _contention_model_enabled;
             vector<QueueModel*> _contention_models;
+            Lock* _contention_model_locks;
 
             // Router and Link Delays
             UInt64 _router_delay;
@@ -78,6 +84,9 @@ class NetworkModelEClos : public NetworkModel
             ElectricalNetworkRouterModel* _router_model;
             ElectricalNetworkLinkModel* _link_model;
             
+            // Guards the power models & the event counters
+            Lock _lock;
+
             // Event Counters
             UInt64 _switch_allocator_arbitrates;
             UInt64 _crossbar_traversals_unicast;
@@ -103,9 +112,8 @@ class NetworkModelEClos : public NetworkModel
 
       bool _enabled;
 
+      // Performance Counters (guarded by _lock)
       Lock _lock;
-
-      // Performance Counters
       UInt64 _total_packets_received;
       UInt64 _total_bytes_received;
       UInt64 _total_contention_delay;
@@ -113,9 +121,11 @@ class NetworkModelEClos : public NetworkModel
 
       // Rand Data Buffer
       drand48_data _rand_data_buffer;
+      Lock _rand_lock;
 
       // Private Functions
       bool processCornerCases(const NetPacket& pkt, vector<Hop>& next_hops);
+      void getMulticastDests(const NetPacket& pkt, vector<tile_id_t>& dests);
       static void readTopologyParams(SInt32& m, SInt32& n, SInt32& r);
       SInt32 getRandNum(SInt32 start, SInt32 end);
       SInt32 computeProcessingTime(SInt32 pkt_length);
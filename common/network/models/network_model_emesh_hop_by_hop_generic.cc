@@ -14,6 +14,7 @@ using namespace std;
 
 SInt32 NetworkModelEMeshHopByHopGeneric::m_mesh_width = 0;
 SInt32 NetworkModelEMeshHopByHopGeneric::m_mesh_height = 0;
+vector<NetworkModelEMeshHopByHopGeneric::Route> NetworkModelEMeshHopByHopGeneric::m_routes;
 
 NetworkModelEMeshHopByHopGeneric::NetworkModelEMeshHopByHopGeneric(Network* net, SInt32 network_id):
    NetworkModel(net, network_id),
@@ -60,6 +61,60 @@ NetworkModelEMeshHopByHopGeneric::initializeEMeshTopologyParams()
    LOG_ASSERT_ERROR(total_tiles == (m_mesh_width * m_mesh_height),
          "total_tiles(%i), m_mesh_width(%i), m_mesh_height(%i)",
          total_tiles, m_mesh_width, m_mesh_height);
+
+   initializeRoutingTables();
+}
+
+void
+NetworkModelEMeshHopByHopGeneric::initializeRoutingTables()
+{
+   // Called once per static network at startup
+   SInt32 total_tiles = m_mesh_width * m_mesh_height;
+   if (m_routes.size() == (size_t) (total_tiles * total_tiles))
+      return;
+
+   m_routes.resize(total_tiles * total_tiles);
+   for (tile_id_t sender = 0; sender < total_tiles; sender++)
+   {
+      SInt32 sx, sy;
+      computePosition(sender, sx, sy);
+
+      for (tile_id_t receiver = 0; receiver < total_tiles; receiver++)
+      {
+         SInt32 dx, dy;
+         computePosition(receiver, dx, dy);
+
+         // Do dimension-order routing
+         Route& route = m_routes[sender * total_tiles + receiver];
+         route.num_hops = abs(sx - dx) + abs(sy - dy);
+         if (sx > dx)
+         {
+            route.direction = LEFT;
+            route.next_dest = computeTileId(sx-1,sy);
+         }
+         else if (sx < dx)
+         {
+            route.direction = RIGHT;
+            route.next_dest = computeTileId(sx+1,sy);
+         }
+         else if (sy > dy)
+         {
+            route.direction = DOWN;
+            route.next_dest = computeTileId(sx,sy-1);
+         }
+         else if (sy < dy)
+         {
+            route.direction = UP;
+            route.next_dest = computeTileId(sx,sy+1);
+         }
+         else
+         {
+            // A send to itself
+            route.direction = SELF;
+            route.next_dest = sender;
+         }
+      }
+   }
 }
 
 void
@@ -161,10 +216,13 @@ void
 NetworkModelEMeshHopByHopGeneric::initializeActivityCounters()
 {
    // Initialize Activity Counters
-   m_switch_allocator_traversals = 0;
-   m_crossbar_traversals = 0;
-   m_buffer_accesses = 0;
-   m_link_traversals = 0;
+   for (UInt32 port = 0; port < NUM_PORTS; port++)
+   {
+      m_activity_counters[port].switch_allocator_traversals = 0;
+      m_activity_counters[port].crossbar_traversals = 0;
+      m_activity_counters[port].buffer_accesses = 0;
+      m_activity_counters[port].link_traversals = 0;
+   }
 }
 
 void
@@ -192,6 +250,22 @@ NetworkModelEMeshHopByHopGeneric::computeAction(const NetPacket& pkt)
          return (RoutingAction::FORWARD | RoutingAction::RECEIVE);
       }
    }
+   else if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+   {
+      if (pkt.sender.tile_id == m_tile_id)
+      {
+         // Dont call routePacket() recursively
+         return RoutingAction::RECEIVE;
+      }
+
+      UInt32 outputs = computeMulticastOutputs(pkt);
+      UInt32 action = 0;
+      if (outputs & (1 << SELF))
+         action |= RoutingAction::RECEIVE;
+      if (outputs & ~(1 << SELF))
+         action |= RoutingAction::FORWARD;
+      return action;
+   }
    else if (pkt.receiver.tile_id == m_tile_id)
    {
       return RoutingAction::RECEIVE;
@@ -202,11 +276,63 @@ NetworkModelEMeshHopByHopGeneric::computeAction(const NetPacket& pkt)
    }
 }
 
+// Output directions (bits) of a multicast packet at this tile. The packet
+// follows the dimension-order routes to all its destinations, i.e., a tree:
+// along the row of the sender first, then up & down the columns
+UInt32
+NetworkModelEMeshHopByHopGeneric::computeMulticastOutputs(const NetPacket& pkt)
+{
+   SInt32 sx, sy, cx, cy;
+   computePosition(pkt.sender.tile_id, sx, sy);
+   computePosition(m_tile_id, cx, cy);
+
+   UInt32 outputs = 0;
+   UInt32 num_bytes = NetPacket::getMulticastDestsSize();
+   for (UInt32 i = 0; i < num_bytes; i++)
+   {
+      if (pkt.multicast_dests[i] == 0)
+         continue;
+
+      for (UInt32 j = 0; j < 8; j++)
+      {
+         if (((pkt.multicast_dests[i] >> j) & 1) == 0)
+            continue;
+
+         SInt32 dx, dy;
+         computePosition((i << 3) + j, dx, dy);
+
+         if (dx != cx)
+         {
+            // Further along the row of the sender, away from the sender
+            if (cy == sy)
+            {
+               if ((dx < cx) && (cx <= sx))
+                  outputs |= (1 << LEFT);
+               else if ((dx > cx) && (cx >= sx))
+                  outputs |= (1 << RIGHT);
+            }
+         }
+         else if (dy == cy)
+         {
+            outputs |= (1 << SELF);
+         }
+         // Further along this column, away from the row of the sender
+         else if ((dy < cy) && (cy <= sy))
+         {
+            outputs |= (1 << DOWN);
+         }
+         else if ((dy > cy) && (cy >= sy))
+         {
+            outputs |= (1 << UP);
+         }
+      }
+   }
+   return outputs;
+}
+
 void
 NetworkModelEMeshHopByHopGeneric::routePacket(const NetPacket &pkt, vector<Hop> &nextHops)
 {
-   ScopedLock sl(m_lock);
-
    //tile_id_t requester = INVALID_TILE_ID;
 
    //if ((pkt.type == SHARED_MEM_1) || (pkt.type == SHARED_MEM_2))
@@ -275,6 +401,31 @@ NetworkModelEMeshHopByHopGeneric::routePacket(const NetPacket &pkt, vector<Hop>
          }
       }
    }
+   else if (pkt.receiver.tile_id == NetPacket::MULTICAST)
+   {
+      // Injection Port Modeling
+      UInt64 injection_port_queue_delay = 0;
+      if (pkt.sender.tile_id == m_tile_id)
+         injection_port_queue_delay = computeInjectionPortQueueDelay(pkt.receiver.tile_id, pkt.time, pkt_length);
+      UInt64 curr_time = pkt.time + injection_port_queue_delay;
+
+      // A copy of the packet for each branch of the multicast tree
+      SInt32 cx, cy;
+      computePosition(m_tile_id, cx, cy);
+      UInt32 outputs = computeMulticastOutputs(pkt);
+
+      if (outputs & (1 << UP))
+         addHop(UP, NetPacket::MULTICAST, computeTileId(cx,cy+1), pkt, curr_time, pkt_length, nextHops, requester);
+      if (outputs & (1 << DOWN))
+         addHop(DOWN, NetPacket::MULTICAST, computeTileId(cx,cy-1), pkt, curr_time, pkt_length, nextHops, requester);
+      if (outputs & (1 << RIGHT))
+         addHop(RIGHT, NetPacket::MULTICAST, computeTileId(cx+1,cy), pkt, curr_time, pkt_length, nextHops, requester);
+      if (outputs & (1 << LEFT))
+         addHop(LEFT, NetPacket::MULTICAST, computeTileId(cx-1,cy), pkt, curr_time, pkt_length, nextHops, requester);
+      // The other destinations receive the packet as they forward it
+      if ((outputs & (1 << SELF)) && (pkt.sender.tile_id == m_tile_id))
+         addHop(SELF, NetPacket::MULTICAST, m_tile_id, pkt, curr_time, pkt_length, nextHops, requester);
+   }
    else
    {
       // Injection Port Modeling
@@ -291,10 +442,31 @@ NetworkModelEMeshHopByHopGeneric::routePacket(const NetPacket &pkt, vector<Hop>
    }
 }
 
+void
+NetworkModelEMeshHopByHopGeneric::routeUnicastPacket(const NetPacket &pkt, Hop &nextHop)
+{
+   LOG_ASSERT_ERROR(pkt.receiver.tile_id != NetPacket::BROADCAST, "Only unicasts allowed here");
+
+   tile_id_t requester = getRequester(pkt);
+   UInt32 pkt_length = getNetwork()->getModeledLength(pkt);
+
+   // Injection Port Modeling
+   UInt64 injection_port_queue_delay = 0;
+   if (pkt.sender.tile_id == m_tile_id)
+      injection_port_queue_delay = computeInjectionPortQueueDelay(pkt.receiver.tile_id, pkt.time, pkt_length);
+   UInt64 curr_time = pkt.time + injection_port_queue_delay;
+
+   OutputDirection direction;
+   tile_id_t next_dest = getNextDest(pkt.receiver.tile_id, direction);
+
+   bool routed = computeHop(direction, pkt.receiver.tile_id, next_dest, pkt, curr_time, pkt_length, requester, nextHop);
+   LOG_ASSERT_ERROR(routed, "No route from tile(%i) to tile(%i)", m_tile_id, pkt.receiver.tile_id);
+}
+
 void
 NetworkModelEMeshHopByHopGeneric::processReceivedPacket(NetPacket& pkt)
 {
-   ScopedLock sl(m_lock);
+   ScopedLock sl(m_port_locks[EJECTION_PORT]);
    
    //UInt32 pkt_length = getNetwork()->getModeledLength(pkt);
 
@@ -340,34 +512,40 @@ NetworkModelEMeshHopByHopGeneric::addHop(OutputDirection direction,
       const NetPacket& pkt,
       UInt64 pkt_time, UInt32 pkt_length,
       vector<Hop>& nextHops, tile_id_t requester)
+{
+   Hop h;
+   if (computeHop(direction, final_dest, next_dest, pkt, pkt_time, pkt_length, requester, h))
+      nextHops.push_back(h);
+}
+
+bool
+NetworkModelEMeshHopByHopGeneric::computeHop(OutputDirection direction,
+      tile_id_t final_dest, tile_id_t next_dest,
+      const NetPacket& pkt,
+      UInt64 pkt_time, UInt32 pkt_length,
+      tile_id_t requester, Hop& hop)
 {
    LOG_ASSERT_ERROR((direction == SELF) || ((direction >= 0) && (direction < NUM_OUTPUT_DIRECTIONS)),
          "Invalid Direction(%u)", direction);
 
-   if ((direction == SELF) || m_queue_models[direction])
-   {
-      Hop h;
-      h.final_dest.tile_id = final_dest;
-      h.next_dest.tile_id = next_dest;
+   if ((direction != SELF) && !m_queue_models[direction])
+      return false;
 
-      if (direction == SELF)
-         h.time = pkt_time;
-      else
-         h.time = pkt_time + computeLatency(direction, pkt, pkt_time, pkt_length, requester);
+   hop.final_dest.tile_id = final_dest;
+   hop.next_dest.tile_id = next_dest;
 
-      nextHops.push_back(h);
-   }
+   if (direction == SELF)
+      hop.time = pkt_time;
+   else
+      hop.time = pkt_time + computeLatency(direction, pkt, pkt_time, pkt_length, requester);
+
+   return true;
 }
 
 SInt32
 NetworkModelEMeshHopByHopGeneric::computeDistance(tile_id_t sender, tile_id_t receiver)
 {
-   SInt32 sx, sy, dx, dy;
-
-   computePosition(sender, sx, sy);
-   computePosition(receiver, dx, dy);
-
-   return abs(sx - dx) + abs(sy - dy);
+   return getRoute(sender, receiver).num_hops;
 }
 
 void
@@ -394,13 +572,16 @@ NetworkModelEMeshHopByHopGeneric::computeLatency(OutputDirection direction, cons
 
    UInt64 processing_time = computeProcessingTime(pkt_length);
 
+   ScopedLock sl(m_port_locks[direction]);
+
    // Calculate the contention delay
    UInt64 queue_delay = 0;
    if (m_queue_model_enabled)
       queue_delay = m_queue_models[direction]->computeQueueDelay(pkt_time, processing_time);
 
    // Update Dynamic Energy State of the Router & Link
-   updateDynamicEnergy(pkt       /* Packet */,        \
+   updateDynamicEnergy(direction, \
+         pkt       /* Packet */,        \
          queue_delay             /* is_buffered */,   \
          m_num_router_ports/2    /* contention */     );
 
@@ -420,6 +601,8 @@ NetworkModelEMeshHopByHopGeneric::computeInjectionPortQueueDelay(tile_id_t recei
       return 0;
 
    UInt64 processing_time = computeProcessingTime(pkt_length);
+
+   ScopedLock sl(m_port_locks[INJECTION_PORT]);
    return m_injection_port_queue_model->computeQueueDelay(pkt_time, processing_time);
 }
 
@@ -433,7 +616,8 @@ NetworkModelEMeshHopByHopGeneric::computeEjectionPortQueueDelay(const NetPacket&
    UInt64 ejection_port_queue_delay =  m_ejection_port_queue_model->computeQueueDelay(pkt_time, processing_time);
 
    // Update Dynamic Energy State of the Router & Link
-   updateDynamicEnergy(pkt /* Packet */,              \
+   updateDynamicEnergy(EJECTION_PORT, \
+         pkt /* Packet */,              \
          ejection_port_queue_delay /* is_buffered */, \
          m_num_router_ports/2 /* contention */);
 
@@ -455,41 +639,12 @@ NetworkModelEMeshHopByHopGeneric::computeProcessingTime(UInt32 pkt_length)
 SInt32
 NetworkModelEMeshHopByHopGeneric::getNextDest(SInt32 final_dest, OutputDirection& direction)
 {
-   // Do dimension-order routing
+   // Do dimension-order routing (see initializeRoutingTables())
    // Curently, do store-and-forward routing
    // FIXME: Should change this to wormhole routing eventually
-   
-   SInt32 sx, sy, dx, dy;
-
-   computePosition(m_tile_id, sx, sy);
-   computePosition(final_dest, dx, dy);
-
-   if (sx > dx)
-   {
-      direction = LEFT;
-      return computeTileId(sx-1,sy);
-   }
-   else if (sx < dx)
-   {
-      direction = RIGHT;
-      return computeTileId(sx+1,sy);
-   }
-   else if (sy > dy)
-   {
-      direction = DOWN;
-      return computeTileId(sx,sy-1);
-   }
-   else if (sy < dy)
-   {
-      direction = UP;
-      return computeTileId(sx,sy+1);
-   }
-   else
-   {
-      // A send to itself
-      direction = SELF;
-      return m_tile_id;
-   }
+   const Route& route = getRoute(m_tile_id, final_dest);
+   direction = (OutputDirection) route.direction;
+   return route.next_dest;
 }
 
 tile_id_t
@@ -784,6 +939,10 @@ NetworkModelEMeshHopByHopGeneric::computeProcessToTileMapping()
 SInt32
 NetworkModelEMeshHopByHopGeneric::computeNumHops(tile_id_t sender, tile_id_t receiver)
 {
+   // The routing tables are only built when an electrical mesh network is used
+   if (!m_routes.empty())
+      return getRoute(sender, receiver).num_hops;
+
    SInt32 tile_count = Config::getSingleton()->getTotalTiles();
 
    SInt32 mesh_width = (SInt32) floor (sqrt(tile_count));
@@ -799,8 +958,9 @@ NetworkModelEMeshHopByHopGeneric::computeNumHops(tile_id_t sender, tile_id_t rec
    return abs(sx - dx) + abs(sy - dy);
 }
 
+// Must be called with the lock of 'port' held
 void
-NetworkModelEMeshHopByHopGeneric::updateDynamicEnergy(const NetPacket& pkt,
+NetworkModelEMeshHopByHopGeneric::updateDynamicEnergy(UInt32 port, const NetPacket& pkt,
       bool is_buffered, UInt32 contention)
 {
    tile_id_t requester = getRequester(pkt);
@@ -811,8 +971,19 @@ NetworkModelEMeshHopByHopGeneric::updateDynamicEnergy(const NetPacket& pkt,
    UInt32 pkt_length = getNetwork()->getModeledLength(pkt);
    // For now, assume that half of the bits in the packet flip
    UInt32 num_flits = computeProcessingTime(pkt_length);
-      
+
+   ActivityCounters& activity_counters = m_activity_counters[port];
+   activity_counters.switch_allocator_traversals ++;
+   activity_counters.crossbar_traversals += num_flits;
+   if (is_buffered)
+      activity_counters.buffer_accesses += num_flits;
+   activity_counters.link_traversals += num_flits;
+
+   if (!Config::getSingleton()->getEnablePowerModeling())
+      return;
+
    // Dynamic Energy Dissipated
+   ScopedLock sl(m_power_model_lock);
 
    // 1) Electrical Router
    // For every activity, update the dynamic energy due to the clock
@@ -820,46 +991,29 @@ NetworkModelEMeshHopByHopGeneric::updateDynamicEnergy(const NetPacket& pkt,
    // Assume half of the input ports are contending for the same output port
    // Switch allocation is only done for the head flit. All the other flits just follow.
    // So, we dont need to update dynamic energies again
-   if (Config::getSingleton()->getEnablePowerModeling())
-   {
-      m_electrical_router_model->updateDynamicEnergySwitchAllocator(contention);
-      m_electrical_router_model->updateDynamicEnergyClock();
-   }
-   m_switch_allocator_traversals ++;
+   m_electrical_router_model->updateDynamicEnergySwitchAllocator(contention);
+   m_electrical_router_model->updateDynamicEnergyClock();
 
    // Assume half of the bits flip while crossing the crossbar 
-   if (Config::getSingleton()->getEnablePowerModeling())
-   {
-      m_electrical_router_model->updateDynamicEnergyCrossbar(m_link_width/2, num_flits); 
-      m_electrical_router_model->updateDynamicEnergyClock(num_flits);
-   }
-   m_crossbar_traversals += num_flits;
+   m_electrical_router_model->updateDynamicEnergyCrossbar(m_link_width/2, num_flits); 
+   m_electrical_router_model->updateDynamicEnergyClock(num_flits);
   
    // Add the flit_buffer dynamic power. We need to write once and read once
    if (is_buffered)
    {
-      if (Config::getSingleton()->getEnablePowerModeling())
-      {
-         // Buffer Write Energy
-         m_electrical_router_model->updateDynamicEnergyBuffer(ElectricalNetworkRouterModel::BufferAccess::WRITE, \
-               m_link_width/2, num_flits);
-         m_electrical_router_model->updateDynamicEnergyClock(num_flits);
-    
-         // Buffer Read Energy
-         m_electrical_router_model->updateDynamicEnergyBuffer(ElectricalNetworkRouterModel::BufferAccess::READ, \
-               m_link_width/2, num_flits);
-         m_electrical_router_model->updateDynamicEnergyClock(num_flits);
-      }
-
-      m_buffer_accesses += num_flits;
+      // Buffer Write Energy
+      m_electrical_router_model->updateDynamicEnergyBuffer(ElectricalNetworkRouterModel::BufferAccess::WRITE, \
+            m_link_width/2, num_flits);
+      m_electrical_router_model->updateDynamicEnergyClock(num_flits);
+ 
+      // Buffer Read Energy
+      m_electrical_router_model->updateDynamicEnergyBuffer(ElectricalNetworkRouterModel::BufferAccess::READ, \
+            m_link_width/2, num_flits);
+      m_electrical_router_model->updateDynamicEnergyClock(num_flits);
    }
 
    // 2) Electrical Link
-   if (Config::getSingleton()->getEnablePowerModeling())
-   {
-      m_electrical_link_model->updateDynamicEnergy(m_link_width/2, num_flits);
-   }
-   m_link_traversals += num_flits;
+   m_electrical_link_model->updateDynamicEnergy(m_link_width/2, num_flits);
 }
 
 void
@@ -875,9 +1029,18 @@ NetworkModelEMeshHopByHopGeneric::outputPowerSummary(ostream& out)
       out << "    Dynamic Energy: " << dynamic_energy << endl;
    }
 
+   ActivityCounters total_activity_counters = {0, 0, 0, 0};
+   for (UInt32 port = 0; port < NUM_PORTS; port++)
+   {
+      total_activity_counters.switch_allocator_traversals += m_activity_counters[port].switch_allocator_traversals;
+      total_activity_counters.crossbar_traversals += m_activity_counters[port].crossbar_traversals;
+      total_activity_counters.buffer_accesses += m_activity_counters[port].buffer_accesses;
+      total_activity_counters.link_traversals += m_activity_counters[port].link_traversals;
+   }
+
    out << "  Activity Counters:" << endl;
-   out << "    Switch Allocator Traversals: " << m_switch_allocator_traversals << endl;
-   out << "    Crossbar Traversals: " << m_crossbar_traversals << endl;
-   out << "    Buffer Accesses: " << m_buffer_accesses << endl;
-   out << "    Link Traversals: " << m_link_traversals << endl;
+   out << "    Switch Allocator Traversals: " << total_activity_counters.switch_allocator_traversals << endl;
+   out << "    Crossbar Traversals: " << total_activity_counters.crossbar_traversals << endl;
+   out << "    Buffer Accesses: " << total_activity_counters.buffer_accesses << endl;
+   out << "    Link Traversals: " << total_activity_counters.link_traversals << endl;
 }
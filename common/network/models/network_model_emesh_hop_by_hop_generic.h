@@ -23,10 +23,20 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
       } OutputDirection;
 
    private:
+      // Dimension-order route from one tile to another
+      struct Route
+      {
+         tile_id_t next_dest;
+         UInt16 num_hops;
+         UInt8 direction;
+      };
+
       // Fields
       tile_id_t m_tile_id;
       static SInt32 m_mesh_width;
       static SInt32 m_mesh_height;
+      // Routes between all pairs of tiles, indexed by (sender * num tiles + receiver)
+      static std::vector<Route> m_routes;
 
       // Router & Link Parameters
       UInt32 m_num_router_ports;
@@ -35,14 +45,34 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
       ElectricalNetworkRouterModel* m_electrical_router_model;
       ElectricalNetworkLinkModel* m_electrical_link_model;
 
+      // Router ports: the output directions, the injection & the ejection port
+      enum
+      {
+         INJECTION_PORT = NUM_OUTPUT_DIRECTIONS,
+         EJECTION_PORT,
+         NUM_PORTS
+      };
+
+      struct ActivityCounters
+      {
+         UInt64 switch_allocator_traversals;
+         UInt64 crossbar_traversals;
+         UInt64 buffer_accesses;
+         UInt64 link_traversals;
+      };
+
       QueueModel* m_queue_models[NUM_OUTPUT_DIRECTIONS];
       QueueModel* m_injection_port_queue_model;
       QueueModel* m_ejection_port_queue_model;
 
       bool m_enabled;
 
-      // Lock
-      Lock m_lock;
+      // Locks
+      // A port lock guards the queue model & the activity counters of the port,
+      // so that packets using different ports do not serialize on the router.
+      // The ejection port lock also guards the performance counters
+      Lock m_port_locks[NUM_PORTS];
+      Lock m_power_model_lock;
 
       // Performance Counters
       UInt64 m_total_bytes_received;
@@ -50,26 +80,27 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
       UInt64 m_total_contention_delay;
       UInt64 m_total_packet_latency;
 
-      // Activity Counters
-      UInt64 m_switch_allocator_traversals;
-      UInt64 m_crossbar_traversals;
-      UInt64 m_buffer_accesses;
-      UInt64 m_link_traversals;
+      // Activity Counters of each port, summed up in outputPowerSummary()
+      ActivityCounters m_activity_counters[NUM_PORTS];
 
       // Functions
-      void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
-      tile_id_t computeTileId(SInt32 x, SInt32 y);
+      static void computePosition(tile_id_t tile, SInt32 &x, SInt32 &y);
+      static tile_id_t computeTileId(SInt32 x, SInt32 y);
       SInt32 computeDistance(tile_id_t sender, tile_id_t receiver);
 
       void addHop(OutputDirection direction, tile_id_t final_dest, tile_id_t next_dest, \
             const NetPacket& pkt, UInt64 pkt_time, UInt32 pkt_length, \
             std::vector<Hop>& nextHops, \
             tile_id_t requester);
+      bool computeHop(OutputDirection direction, tile_id_t final_dest, tile_id_t next_dest, \
+            const NetPacket& pkt, UInt64 pkt_time, UInt32 pkt_length, \
+            tile_id_t requester, Hop& hop);
       UInt64 computeLatency(OutputDirection direction, \
             const NetPacket& pkt, UInt64 pkt_time, UInt32 pkt_length, \
             tile_id_t requester);
       UInt64 computeProcessingTime(UInt32 pkt_length);
       tile_id_t getNextDest(tile_id_t final_dest, OutputDirection& direction);
+      UInt32 computeMulticastOutputs(const NetPacket& pkt);
       tile_id_t getRequester(const NetPacket& pkt);
 
       // Injection & Ejection Port Queue Models
@@ -77,6 +108,9 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
       UInt64 computeEjectionPortQueueDelay(const NetPacket& pkt, UInt64 pkt_time, UInt32 pkt_length);
 
       static void initializeEMeshTopologyParams();
+      static void initializeRoutingTables();
+      static const Route& getRoute(tile_id_t sender, tile_id_t receiver)
+      { return m_routes[sender * (m_mesh_width * m_mesh_height) + receiver]; }
       void createQueueModels();
       void destroyQueueModels();
       void resetQueueModels();
@@ -91,7 +125,7 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
       void initializeActivityCounters();
       
       // Update Dynamic Energy
-      void updateDynamicEnergy(const NetPacket& pkt, bool is_buffered, UInt32 contention);
+      void updateDynamicEnergy(UInt32 port, const NetPacket& pkt, bool is_buffered, UInt32 contention);
       void outputPowerSummary(std::ostream& out);
 
    protected:
@@ -122,7 +156,9 @@ class NetworkModelEMeshHopByHopGeneric : public NetworkModel
 
       UInt32 computeAction(const NetPacket& pkt);
       void routePacket(const NetPacket &pkt, std::vector<Hop> &nextHops);
+      void routeUnicastPacket(const NetPacket &pkt, Hop &nextHop);
       void processReceivedPacket(NetPacket &pkt);
+      bool isMulticastSupported() { return true; }
 
       static std::pair<bool,std::vector<tile_id_t> > computeMemoryControllerPositions(SInt32 num_memory_controllers, SInt32 tile_count);
       static std::pair<bool,SInt32> computeTileCountConstraints(SInt32 tile_count);
@@ -8,10 +8,29 @@
 #include "tile_manager.h"
 #include "clock_converter.h"
 #include "fxsupport.h"
+#include "msg_pool.h"
 #include "log.h"
 
 using namespace std;
 
+// Every receiving core type has its own queues; the broadcasts go to the last ones
+static const SInt32 BROADCAST_RECEIVER = PEP_CORE_TYPE + 1;
+static const SInt32 NUM_RECEIVERS = BROADCAST_RECEIVER + 1;
+
+// A netRecv() call waiting for a packet
+struct NetRecvWaiter
+{
+   const NetMatch* match;
+   core_type_t core_type;
+   ConditionVariable cond;
+
+   NetRecvWaiter(const NetMatch* m, core_type_t t)
+      : match(m)
+      , core_type(t)
+   {
+   }
+};
+
 // FIXME: Rework netCreateBuf and netExPacket. We don't need to
 // duplicate the sender/receiver info the packet. This should be known
 // by the transport layer and given to us. We also should be more
@@ -29,6 +48,9 @@ Network::Network(Tile *tile)
 
    _transport = Transport::getSingleton()->createNode(_tile->getId());
 
+   _netQueues.resize(NUM_RECEIVERS * NUM_PACKET_TYPES);
+   _netQueueSeqNum = 0;
+
    _callbacks = new NetworkCallback [NUM_PACKET_TYPES];
    _callbackObjs = new void* [NUM_PACKET_TYPES];
    for (SInt32 i = 0; i < NUM_PACKET_TYPES; i++)
@@ -85,108 +107,150 @@ void Network::outputSummary(std::ostream &out) const
 
 void Network::netPullFromTransport()
 {
+   Byte* buffers[MAX_RECV_BATCH_SIZE];
    do
    {
       LOG_PRINT("Entering netPullFromTransport");
 
-      NetPacket packet(_transport->recv());
-
-      LOG_PRINT("Pull packet : type %i, from {%i, %i}, time %llu", (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time);
-      LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
-            "Invalid Packet Sender(%i)", packet.sender);
-      LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
-            "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
+      UInt32 num_buffers = _transport->recvBatch(buffers, MAX_RECV_BATCH_SIZE);
+      for (UInt32 i = 0; i < num_buffers; i++)
+         processBuffer(buffers[i]);
+   }
+   while (_transport->query());
+}
 
-      NetworkModel* model = getNetworkModelFromPacketType(packet.type);
-     
-      UInt32 action = model->computeAction(packet);
-      
-      if (action & NetworkModel::RoutingAction::FORWARD)
+void Network::processBuffer(Byte* buffer)
+{
+   // The payload stays in the transport buffer while the packet is handled
+   NetPacket packet(buffer);
+
+   LOG_PRINT("Pull packet : type %i, from {%i, %i}, time %llu", (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.time);
+   LOG_ASSERT_ERROR(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod,
+         "Invalid Packet Sender(%i)", packet.sender);
+   LOG_ASSERT_ERROR(0 <= packet.type && packet.type < NUM_PACKET_TYPES,
+         "Packet type: %d not between 0 and %d", packet.type, NUM_PACKET_TYPES);
+
+   NetworkModel* model = getNetworkModelFromPacketType(packet.type);
+  
+   UInt32 action = model->computeAction(packet);
+   
+   if (action & NetworkModel::RoutingAction::FORWARD)
+   {
+      LOG_PRINT("Forwarding packet : type %i, from {%i, %i}, to {%i, %i}, tile_id %i, time %llu.", 
+            (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
+      if (action & NetworkModel::RoutingAction::RECEIVE)
       {
-         LOG_PRINT("Forwarding packet : type %i, from {%i, %i}, to {%i, %i}, tile_id %i, time %llu.", 
-               (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
-         forwardPacket(packet);
+         // This tile still needs the payload
+         forwardPacket(packet, packet.makeBuffer());
       }
-      
-      if (action & NetworkModel::RoutingAction::RECEIVE)
+      else
       {
-         LOG_PRINT("Before Processing Received Packet: packet.time(%llu)", packet.time);
-         
-         // I have accepted the packet - process the received packet
-         model->processReceivedPacket(packet);
-
-         LOG_PRINT("After Processing Received Packet: packet.time(%llu)", packet.time);
-         
-         // Convert from network cycle count to core cycle count
-         packet.time = convertCycleCount(packet.time, \
-               getNetworkModelFromPacketType(packet.type)->getFrequency(), \
-               _tile->getCore()->getPerformanceModel()->getFrequency());
-    
-         LOG_PRINT("After Converting Cycle Count: packet.time(%llu)", packet.time);
-         
-         // asynchronous I/O support
-         NetworkCallback callback = _callbacks[packet.type];
-
-         if (callback != NULL)
-         {
-            LOG_PRINT("Executing callback on packet : type %i, from {%i, %i}, to {%i, %i}, tile_id %i, cycle_count %llu", 
-                  (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
-            assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
-            assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
-
-            callback(_callbackObjs[packet.type], packet);
+         // Passed on as is
+         forwardPacket(packet, buffer);
+         buffer = NULL;
+      }
+   }
+   
+   if (action & NetworkModel::RoutingAction::RECEIVE)
+   {
+      // A multicast packet is received as a unicast to this tile
+      if (packet.receiver.tile_id == NetPacket::MULTICAST)
+      {
+         packet.receiver.tile_id = _tile->getId();
+         packet.multicast_dests = NULL;
+      }
 
-            if (packet.length > 0)
-               delete [] (Byte*) packet.data;
-         }
+      LOG_PRINT("Before Processing Received Packet: packet.time(%llu)", packet.time);
+      
+      // I have accepted the packet - process the received packet
+      model->processReceivedPacket(packet);
 
-         // synchronous I/O support
-         else
-         {
-            LOG_PRINT("Enqueuing packet : type %i, from {%i, %i}, to {%i, %i}, core_id %i, cycle_count %llu", 
-                  (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
+      LOG_PRINT("After Processing Received Packet: packet.time(%llu)", packet.time);
+      
+      // Convert from network cycle count to core cycle count
+      packet.time = convertCycleCount(packet.time, \
+            getNetworkModelFromPacketType(packet.type)->getFrequency(), \
+            _tile->getCore()->getPerformanceModel()->getFrequency());
+ 
+      LOG_PRINT("After Converting Cycle Count: packet.time(%llu)", packet.time);
+      
+      // asynchronous I/O support
+      NetworkCallback callback = _callbacks[packet.type];
 
-            _netQueueLock.acquire();
-            _netQueue.push_back(packet);
-            _netQueueLock.release();
+      if (callback != NULL)
+      {
+         LOG_PRINT("Executing callback on packet : type %i, from {%i, %i}, to {%i, %i}, tile_id %i, cycle_count %llu", 
+               (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
+         assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
+         assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
 
-            _netQueueCond.broadcast();
-         }
+         callback(_callbackObjs[packet.type], packet);
       }
-      else // if ((action & NetworkModel::RoutingAction::RECEIVE) == 0)
+
+      // synchronous I/O support
+      else
       {
+         LOG_PRINT("Enqueuing packet : type %i, from {%i, %i}, to {%i, %i}, core_id %i, cycle_count %llu", 
+               (SInt32)packet.type, packet.sender.tile_id, packet.sender.core_type, packet.receiver.tile_id, packet.receiver.core_type, _tile->getId(), packet.time);
+
+         // netRecv() callers own (and delete) the payload
          if (packet.length > 0)
-            delete [] (Byte*) packet.data;
+         {
+            Byte* data = new Byte[packet.length];
+            memcpy(data, packet.data, packet.length);
+            packet.data = data;
+         }
+
+         _netQueueLock.acquire();
+         enqueuePacket(packet);
+         _netQueueLock.release();
       }
    }
-   while (_transport->query());
+
+   if (buffer != NULL)
+      MsgPool::freeBuffer(buffer);
 }
 
-SInt32 Network::forwardPacket(const NetPacket& packet)
+SInt32 Network::forwardPacket(const NetPacket& packet, Byte* buffer)
 {
-   // Create a buffer suitable for forwarding
-   Byte* buffer = packet.makeBuffer();
-   NetPacket* buff_pkt = (NetPacket*) buffer;
+   LOG_ASSERT_ERROR((packet.type >= 0) && (packet.type < NUM_PACKET_TYPES),
+         "packet.type(%u)", packet.type);
 
-   LOG_ASSERT_ERROR((buff_pkt->type >= 0) && (buff_pkt->type < NUM_PACKET_TYPES),
-         "buff_pkt->type(%u)", buff_pkt->type);
+   memcpy(buffer, &packet, sizeof(packet));
+   UInt32 buffer_size = packet.bufferSize();
 
-   NetworkModel *model = getNetworkModelFromPacketType(buff_pkt->type);
+   NetworkModel *model = getNetworkModelFromPacketType(packet.type);
 
    vector<NetworkModel::Hop> hopVec;
-   model->routePacket(*buff_pkt, hopVec);
+   model->routePacket(packet, hopVec);
+
+   if (hopVec.empty())
+      MsgPool::freeBuffer(buffer);
 
    for (UInt32 i = 0; i < hopVec.size(); i++)
    {
+      // The transport takes over the buffer it is given, and every hop gets
+      // its own header; all but the last hop get a copy
+      Byte* hop_buffer = buffer;
+      if (i + 1 < hopVec.size())
+      {
+         hop_buffer = MsgPool::allocBuffer(buffer_size);
+         memcpy(hop_buffer, buffer, buffer_size);
+      }
+      NetPacket* buff_pkt = (NetPacket*) hop_buffer;
+
       LOG_PRINT("Send packet : type %i, from {%i,%i}, to {%i, %i}, next_hop %i, tile_id %i, time %llu", \
             (SInt32) buff_pkt->type, buff_pkt->sender.tile_id, buff_pkt->sender.core_type, hopVec[i].final_dest.tile_id, hopVec[i].final_dest.core_type, hopVec[i].next_dest.tile_id, \
             _tile->getId(), hopVec[i].time);
 
       // Do a shared memory shortcut here
-      if ((Config::getSingleton()->getProcessCount() == 1) && (hopVec[i].final_dest.tile_id != NetPacket::BROADCAST))
+      if ((Config::getSingleton()->getProcessCount() == 1) &&
+          (hopVec[i].final_dest.tile_id != NetPacket::BROADCAST) &&
+          (hopVec[i].final_dest.tile_id != NetPacket::MULTICAST))
       {
          // 1) Process Count = 1
          // 2) The broadcast tree network model is not used
+         // 3) Not a multicast tree
          while (1)
          {
             buff_pkt->time = hopVec[i].time;
@@ -207,12 +271,7 @@ SInt32 Network::forwardPacket(const NetPacket& packet)
                break;
             }
             
-            vector<NetworkModel::Hop> localHopVec;
-            remote_network_model->routePacket(*buff_pkt, localHopVec);
-            LOG_ASSERT_ERROR(localHopVec.size() == 1, "Only unicasts allowed in this routing loop(%u)",
-                  localHopVec.size());
-
-            hopVec[i] = localHopVec[0];
+            remote_network_model->routeUnicastPacket(*buff_pkt, hopVec[i]);
          }
       }
 
@@ -221,13 +280,11 @@ SInt32 Network::forwardPacket(const NetPacket& packet)
       buff_pkt->receiver.core_type = hopVec[i].final_dest.core_type;
       buff_pkt->specific = hopVec[i].specific;
 
-      _transport->send(hopVec[i].next_dest.tile_id, buffer, packet.bufferSize());
+      _transport->sendBuffer(hopVec[i].next_dest.tile_id, hop_buffer, buffer_size);
       
       LOG_PRINT("Sent packet");
    }
 
-   delete [] buffer;
-
    return packet.length;
 }
 
@@ -239,7 +296,40 @@ NetworkModel* Network::getNetworkModelFromPacketType(PacketType packet_type)
 SInt32 Network::netSend(NetPacket& packet)
 {
    // Interface for sending packets on a network
+   return sendPacket(packet, false);
+}
+
+SInt32 Network::netSendBuffer(NetPacket& packet)
+{
+   return sendPacket(packet, true);
+}
+
+SInt32 Network::netMulticastBuffer(NetPacket& packet, const vector<tile_id_t>& receivers)
+{
+   LOG_ASSERT_ERROR(receivers.size() >= 2, "Multicast to %u receivers", (UInt32) receivers.size());
+   LOG_ASSERT_ERROR(isMulticastSupported(packet.type), "No multicast on packet type(%u)", packet.type);
+
+   // The bitmap goes after the payload, in the same buffer
+   Byte* multicast_dests = ((Byte*) packet.data) + packet.length;
+   memset(multicast_dests, 0, NetPacket::getMulticastDestsSize());
+   for (UInt32 i = 0; i < receivers.size(); i++)
+   {
+      LOG_ASSERT_ERROR((receivers[i] >= 0) && (receivers[i] < _numMod), "Invalid receiver(%i)", receivers[i]);
+      multicast_dests[receivers[i] >> 3] |= (1 << (receivers[i] & 7));
+   }
 
+   packet.receiver.tile_id = NetPacket::MULTICAST;
+   packet.multicast_dests = multicast_dests;
+   return sendPacket(packet, true);
+}
+
+bool Network::isMulticastSupported(PacketType type)
+{
+   return getNetworkModelFromPacketType(type)->isMulticastSupported();
+}
+
+SInt32 Network::sendPacket(NetPacket& packet, bool payload_in_buffer)
+{
    // Floating Point Save/Restore
    FloatingPointHandler floating_point_handler;
 
@@ -253,185 +343,136 @@ SInt32 Network::netSend(NetPacket& packet)
    // Note the start time
    packet.start_time = packet.time;
 
-   // Call forwardPacket(packet)
-   return forwardPacket(packet);
+   Byte* buffer = payload_in_buffer ? (((Byte*) packet.data) - sizeof(NetPacket)) : packet.makeBuffer();
+   return forwardPacket(packet, buffer);
 }
 
-// Stupid helper class to eliminate special cases for empty
-// sender/type vectors in a NetMatch
-class NetRecvIterator
+NetQueue* Network::getNetQueue(SInt32 receiver, PacketType type)
 {
-   public:
-      NetRecvIterator(UInt32 i)
-            : _mode(INT)
-            , _max(i)
-            , _i(0)
-            , _core_type(MAIN_CORE_TYPE)
-      {
-      }
-      NetRecvIterator(const std::vector<core_id_t> &v)
-            : _mode(SENDER_VECTOR)
-            , _senders(&v)
-            , _i(0)
-            , _core_type(MAIN_CORE_TYPE)
-      {
-      }
-      NetRecvIterator(const std::vector<PacketType> &v)
-            : _mode(TYPE_VECTOR)
-            , _types(&v)
-            , _i(0)
-      {
-      }
+   return &_netQueues[receiver * NUM_PACKET_TYPES + type];
+}
 
-      inline UInt32 get()
-      {
-         switch (_mode)
-         {
-         case INT:
-            return _i;
-         case TYPE_VECTOR:
-            return (UInt32)_types->at(_i);
-         default:
-            assert(false);
-            return (UInt32)-1;
-         };
-      }
+// Must be called with _netQueueLock held
+void Network::enqueuePacket(const NetPacket& packet)
+{
+   SInt32 receiver = BROADCAST_RECEIVER;
+   if (packet.receiver.tile_id != NetPacket::BROADCAST)
+   {
+      LOG_ASSERT_ERROR(packet.receiver.tile_id == _tile->getId(),
+            "packet.receiver.tile_id(%i), tile_id(%i)", packet.receiver.tile_id, _tile->getId());
+      receiver = packet.receiver.core_type;
+   }
 
-      inline core_id_t getCoreId()
-      {
-         switch (_mode)
-         {
-         case SENDER_VECTOR:
-            return (core_id_t)_senders->at(_i);
-         case INT:
-            return Sim()->getTileManager()->getMainCoreId(_i);
-         default:
-            assert(false);
-            return INVALID_CORE_ID;
-         };
-      }
-      inline Boolean done()
-      {
-         switch (_mode)
-         {
-         case INT:
-            return _i >= _max;
-         case SENDER_VECTOR:
-            return _i >= _senders->size();
-         case TYPE_VECTOR:
-            return _i >= _types->size();
-         default:
-            assert(false);
-            return true;
-         };
-      }
+   NetQueue* queue = getNetQueue(receiver, packet.type);
+   NetQueueKey key(packet.time, _netQueueSeqNum ++);
+   queue->packets.insert(make_pair(key, packet));
+   queue->sender_keys[NetQueue::SenderKey(packet.sender.tile_id, packet.sender.core_type)].insert(key);
 
-      inline void next()
-      {
-         ++_i;
-      }
+   for (list<NetRecvWaiter*>::iterator it = _netRecvWaiters.begin(); it != _netRecvWaiters.end(); it++)
+   {
+      if (((receiver == BROADCAST_RECEIVER) || (receiver == (*it)->core_type)) && (*it)->match->matches(packet))
+         (*it)->cond.signal();
+   }
+}
 
-      inline void reset()
-      {
-         _i = 0;
-      }
+// Finds the earliest packet that matches. Must be called with _netQueueLock held
+bool Network::findPacket(const NetMatch& match, core_type_t core_type, NetQueue** queue, NetQueueKey* key)
+{
+   bool found = false;
 
-   private:
-      enum
+   SInt32 receivers[] = { core_type, BROADCAST_RECEIVER };
+   UInt32 num_types = match.types.empty() ? (UInt32) NUM_PACKET_TYPES : match.types.size();
+   for (UInt32 r = 0; r < 2; r++)
+   {
+      for (UInt32 t = 0; t < num_types; t++)
       {
-         INT, SENDER_VECTOR, TYPE_VECTOR
-      } _mode;
+         PacketType type = match.types.empty() ? (PacketType) t : match.types[t];
+         NetQueue* net_queue = getNetQueue(receivers[r], type);
+         if (net_queue->packets.empty())
+            continue;
 
-      union
-      {
-         UInt32 _max;
-         const std::vector<core_id_t> *_senders;
-         const std::vector<PacketType> *_types;
-      };
+         if (match.senders.empty())
+         {
+            NetQueueKey earliest_key = net_queue->packets.begin()->first;
+            if (!found || (earliest_key < *key))
+            {
+               *queue = net_queue;
+               *key = earliest_key;
+               found = true;
+            }
+            continue;
+         }
 
-      UInt32 _i;
-      core_type_t _core_type;
-};
+         for (UInt32 s = 0; s < match.senders.size(); s++)
+         {
+            map<NetQueue::SenderKey, set<NetQueueKey> >::iterator sender_it =
+               net_queue->sender_keys.find(NetQueue::SenderKey(match.senders[s].tile_id, match.senders[s].core_type));
+            if (sender_it == net_queue->sender_keys.end())
+               continue;
+
+            NetQueueKey earliest_key = *(sender_it->second.begin());
+            if (!found || (earliest_key < *key))
+            {
+               *queue = net_queue;
+               *key = earliest_key;
+               found = true;
+            }
+         }
+      }
+   }
+
+   return found;
+}
 
 NetPacket Network::netRecv(const NetMatch &match)
 {
    LOG_PRINT("Entering netRecv.");
 
-   // Track via iterator to minimize copying
-   NetQueue::iterator itr;
-   Boolean found;
-
-   found = false;
-
-   NetRecvIterator sender = match.senders.empty()
-                            ? NetRecvIterator(_numMod)
-                            : NetRecvIterator(match.senders);
-
-   NetRecvIterator type = match.types.empty()
-                          ? NetRecvIterator((UInt32)NUM_PACKET_TYPES)
-                          : NetRecvIterator(match.types);
-
    LOG_ASSERT_ERROR(_tile && _tile->getCore()->getPerformanceModel(),
                     "Tile and/or performance model not initialized.");
    UInt64 start_time = _tile->getCore()->getPerformanceModel()->getCycleCount();
 
    _netQueueLock.acquire();
 
-   while (!found)
-   {
-      itr = _netQueue.end();
-
-      // check every entry in the queue
-      for (NetQueue::iterator i = _netQueue.begin();
-            i != _netQueue.end();
-            i++)
-      {
-         // make sure that this core is the proper destination core for this tile
-         if (i->receiver.tile_id != _tile->getId() || i->receiver.core_type != _tile->getCurrentCore()->getCoreType())
-            if (i->receiver.tile_id != NetPacket::BROADCAST)
-               continue;
-
-         // only find packets that match
-         for (sender.reset(); !sender.done(); sender.next())
-         {
-            if (i->sender.tile_id != sender.getCoreId().tile_id || i->sender.core_type != sender.getCoreId().core_type)
-               continue;
-
-            for (type.reset(); !type.done(); type.next())
-            {
-               if (i->type != (PacketType)type.get())
-                  continue;
-
-               found = true;
+   // make sure that this core is the proper destination core for this tile
+   core_type_t core_type = (core_type_t) _tile->getCurrentCore()->getCoreType();
 
-               // find the earliest packet
-               if (itr == _netQueue.end() ||
-                     itr->time > i->time)
-               {
-                  itr = i;
-               }
-            }
-         }
-      }
-
-      // go to sleep until a packet arrives if none have been found
-      if (!found)
+   NetQueue* queue = NULL;
+   NetQueueKey key;
+   NetRecvWaiter waiter(&match, core_type);
+   bool waiting = false;
+   while (!findPacket(match, core_type, &queue, &key))
+   {
+      // go to sleep until a matching packet arrives
+      if (!waiting)
       {
-            _netQueueCond.wait(_netQueueLock);
+         _netRecvWaiters.push_back(&waiter);
+         waiting = true;
       }
+      waiter.cond.wait(_netQueueLock);
    }
+   if (waiting)
+      _netRecvWaiters.remove(&waiter);
 
-   assert(found == true && itr != _netQueue.end());
-   assert(0 <= itr->sender.tile_id && itr->sender.tile_id < _numMod);
-   assert(0 <= itr->type && itr->type < NUM_PACKET_TYPES);
-   assert((itr->receiver.tile_id == _tile->getId()) || (itr->receiver.tile_id == NetPacket::BROADCAST));
+   map<NetQueueKey, NetPacket>::iterator itr = queue->packets.find(key);
+   assert(itr != queue->packets.end());
 
    // Copy result
-   NetPacket packet = *itr;
-   _netQueue.erase(itr);
+   NetPacket packet = itr->second;
+   queue->packets.erase(itr);
+
+   NetQueue::SenderKey sender_key(packet.sender.tile_id, packet.sender.core_type);
+   set<NetQueueKey>& sender_keys = queue->sender_keys[sender_key];
+   sender_keys.erase(key);
+   if (sender_keys.empty())
+      queue->sender_keys.erase(sender_key);
 
    _netQueueLock.release();
 
+   assert(0 <= packet.sender.tile_id && packet.sender.tile_id < _numMod);
+   assert(0 <= packet.type && packet.type < NUM_PACKET_TYPES);
+   assert((packet.receiver.tile_id == _tile->getId()) || (packet.receiver.tile_id == NetPacket::BROADCAST));
+
    LOG_PRINT("packet.time(%llu), start_time(%llu)", packet.time, start_time);
 
    if (packet.time > start_time)
@@ -546,6 +587,24 @@ UInt32 Network::getModeledLength(const NetPacket& pkt)
    }
 }
 
+// -- NetMatch
+
+bool NetMatch::matches(const NetPacket& packet) const
+{
+   bool sender_matches = senders.empty();
+   for (UInt32 i = 0; (i < senders.size()) && !sender_matches; i++)
+   {
+      sender_matches = (senders[i].tile_id == packet.sender.tile_id) &&
+                       (senders[i].core_type == packet.sender.core_type);
+   }
+
+   bool type_matches = types.empty();
+   for (UInt32 i = 0; (i < types.size()) && !type_matches; i++)
+      type_matches = (types[i] == packet.type);
+
+   return (sender_matches && type_matches);
+}
+
 // -- NetPacket
 
 NetPacket::NetPacket()
@@ -557,6 +616,7 @@ NetPacket::NetPacket()
    , specific(-1)
    , length(0)
    , data(0)
+   , multicast_dests(NULL)
 {
 }
 
@@ -568,6 +628,7 @@ NetPacket::NetPacket(UInt64 t, PacketType ty, SInt32 s,
    , specific(0)
    , length(l)
    , data(d)
+   , multicast_dests(NULL)
 {
    sender = Sim()->getTileManager()->getMainCoreId(s);
    receiver = Sim()->getTileManager()->getMainCoreId(r);
@@ -584,6 +645,7 @@ NetPacket::NetPacket(UInt64 t, PacketType ty, core_id_t s,
    , specific(-1)
    , length(l)
    , data(d)
+   , multicast_dests(NULL)
 {
 }
 
@@ -591,16 +653,8 @@ NetPacket::NetPacket(UInt64 t, PacketType ty, core_id_t s,
 NetPacket::NetPacket(Byte *buffer)
 {
    memcpy(this, buffer, sizeof(*this));
-
-   // LOG_ASSERT_ERROR(length > 0, "type(%u), sender(%i), receiver(%i), length(%u)", type, sender, receiver, length);
-   if (length > 0)
-   {
-      Byte* data_buffer = new Byte[length];
-      memcpy(data_buffer, buffer + sizeof(*this), length);
-      data = data_buffer;
-   }
-
-   delete [] buffer;
+   data = (length > 0) ? (buffer + sizeof(*this)) : NULL;
+   multicast_dests = (receiver.tile_id == MULTICAST) ? (buffer + sizeof(*this) + length) : NULL;
 }
 
 // This implementation is slightly wasteful because there is no need
@@ -608,7 +662,10 @@ NetPacket::NetPacket(Byte *buffer)
 // but I don't see this as a major issue.
 UInt32 NetPacket::bufferSize() const
 {
-   return (sizeof(*this) + length);
+   UInt32 size = sizeof(*this) + length;
+   if (receiver.tile_id == MULTICAST)
+      size += getMulticastDestsSize();
+   return size;
 }
 
 Byte* NetPacket::makeBuffer() const
@@ -616,10 +673,27 @@ Byte* NetPacket::makeBuffer() const
    UInt32 size = bufferSize();
    assert(size >= sizeof(NetPacket));
 
-   Byte *buffer = new Byte[size];
+   Byte *buffer = MsgPool::allocBuffer(size);
 
    memcpy(buffer, this, sizeof(*this));
    memcpy(buffer + sizeof(*this), data, length);
+   if (receiver.tile_id == MULTICAST)
+      memcpy(buffer + sizeof(*this) + length, multicast_dests, getMulticastDestsSize());
 
    return buffer;
 }
+
+Byte* NetPacket::allocPayload(UInt32 length)
+{
+   return MsgPool::allocBuffer(sizeof(NetPacket) + length) + sizeof(NetPacket);
+}
+
+Byte* NetPacket::allocMulticastPayload(UInt32 length)
+{
+   return allocPayload(length + getMulticastDestsSize());
+}
+
+UInt32 NetPacket::getMulticastDestsSize()
+{
+   return (Config::getSingleton()->getTotalTiles() + 7) / 8;
+}
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
 #include "packet_type.h"
 #include "fixed_types.h"
 #include "cond.h"
@@ -11,9 +13,6 @@
 #include "transport.h"
 #include "network_model.h"
 
-// TODO: Do we need to support multicast to some (but not all)
-// destinations?
-
 class Tile;
 class Network;
 
@@ -38,8 +37,12 @@ public:
    
    UInt32 length;
    const void *data;
+   // Multicast packets (receiver.tile_id == MULTICAST) carry a bitmap of
+   // their destination tiles, after the payload in their buffers
+   const Byte *multicast_dests;
 
    NetPacket();
+   // Header of a received transport buffer; 'data' points into the buffer
    explicit NetPacket(Byte*);
    NetPacket(UInt64 time, PacketType type, core_id_t sender, 
              core_id_t receiver, UInt32 length, const void *data);
@@ -47,13 +50,24 @@ public:
              SInt32 receiver, UInt32 length, const void *data);
 
    UInt32 bufferSize() const;
+   // Copies the header and the payload into a new MsgPool buffer
    Byte *makeBuffer() const;
 
+   // Payload of a MsgPool buffer with room for the header in front; the
+   // caller fills it in and passes it to Network::netSendBuffer()
+   static Byte *allocPayload(UInt32 length);
+   // Same, with room for the destination bitmap after the payload; for
+   // Network::netMulticastBuffer()
+   static Byte *allocMulticastPayload(UInt32 length);
+
+   bool isMulticastDest(tile_id_t tile_id) const
+   { return (multicast_dests[tile_id >> 3] >> (tile_id & 7)) & 1; }
+   static UInt32 getMulticastDestsSize();
+
    static const SInt32 BROADCAST = 0xDEADBABE;
+   static const SInt32 MULTICAST = 0xDEADBEEF;
 };
 
-typedef std::list<NetPacket> NetQueue;
-
 // -- Network Matches -- //
 
 class NetMatch
@@ -63,8 +77,27 @@ class NetMatch
       std::vector<core_id_t> senders;
       std::vector<PacketType> types;
       //std::vector<core_type_t> core_types;
+
+      bool matches(const NetPacket& packet) const;
+};
+
+// -- Network Queues -- //
+
+// Received packets of one type for one receiving core, in (time, arrival)
+// order. Directed receives find the packets of a sender through its keys.
+typedef std::pair<UInt64, UInt64> NetQueueKey;
+
+class NetQueue
+{
+   public:
+      typedef std::pair<tile_id_t, SInt32> SenderKey;
+
+      std::map<NetQueueKey, NetPacket> packets;
+      std::map<SenderKey, std::set<NetQueueKey> > sender_keys;
 };
 
+struct NetRecvWaiter;
+
 // -- Network -- //
 
 // This is the managing class that interacts with the physical
@@ -90,11 +123,22 @@ class Network
 
       void outputSummary(std::ostream &out) const;
 
+      // Handles the packets received by the transport, taking the ones
+      // queued in batches
       void netPullFromTransport();
 
       // -- Main interface -- //
 
       SInt32 netSend(NetPacket& packet);
+      // Sends a payload obtained from NetPacket::allocPayload() without
+      // copying it; the network takes it over
+      SInt32 netSendBuffer(NetPacket& packet);
+      // Sends a payload obtained from NetPacket::allocMulticastPayload() to
+      // each of the 'receivers' tiles (on the core type of packet.receiver)
+      // as a single packet, routed as a tree. The network model of the packet
+      // type must support multicast; the network takes the payload over
+      SInt32 netMulticastBuffer(NetPacket& packet, const std::vector<tile_id_t>& receivers);
+      bool isMulticastSupported(PacketType type);
       NetPacket netRecv(const NetMatch &match);
 
       // -- Wrappers -- //
@@ -127,13 +171,28 @@ class Network
       SInt32 _tid;
       SInt32 _numMod;
 
-      NetQueue _netQueue;
+      // Received packets waiting for netRecv(): a queue per receiving core
+      // type (and one for the broadcasts) and packet type
+      std::vector<NetQueue> _netQueues;
+      UInt64 _netQueueSeqNum;
       Lock _netQueueLock;
-      ConditionVariable _netQueueCond;
+      // Only the waiters that match an arriving packet are woken up
+      std::list<NetRecvWaiter*> _netRecvWaiters;
       ConditionVariable _netHelperQueueCond;
       Semaphore _netQueueSem;
 
-      SInt32 forwardPacket(const NetPacket& packet);
+      NetQueue* getNetQueue(SInt32 receiver, PacketType type);
+      void enqueuePacket(const NetPacket& packet);
+      bool findPacket(const NetMatch& match, core_type_t core_type, NetQueue** queue, NetQueueKey* key);
+
+      static const UInt32 MAX_RECV_BATCH_SIZE = 32;
+
+      void processBuffer(Byte* buffer);
+
+      SInt32 sendPacket(NetPacket& packet, bool payload_in_buffer);
+      // 'buffer' has room for the header followed by the payload and is
+      // handed over to the transport
+      SInt32 forwardPacket(const NetPacket& packet, Byte* buffer);
 };
 
 #endif // NETWORK_H
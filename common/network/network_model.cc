@@ -30,6 +30,15 @@ NetworkModel::NetworkModel(Network *network, SInt32 network_id):
       LOG_PRINT_ERROR("Unrecognized Network Num(%u)", network_id);
 }
 
+void
+NetworkModel::routeUnicastPacket(const NetPacket &pkt, Hop &nextHop)
+{
+   vector<Hop> nextHops;
+   routePacket(pkt, nextHops);
+   LOG_ASSERT_ERROR(nextHops.size() == 1, "Only unicasts allowed here(%u)", nextHops.size());
+   nextHop = nextHops[0];
+}
+
 NetworkModel*
 NetworkModel::createModel(Network *net, SInt32 network_id, UInt32 model_type)
 {
@@ -73,7 +73,12 @@ class NetworkModel
       virtual UInt32 computeAction(const NetPacket& pkt) = 0;
       virtual void routePacket(const NetPacket &pkt,
                                std::vector<Hop> &nextHops) = 0;
+      // Route a unicast packet that has exactly one next hop (used by the
+      // single-process routing loop)
+      virtual void routeUnicastPacket(const NetPacket &pkt, Hop &nextHop);
       virtual void processReceivedPacket(NetPacket &pkt) = 0;
+      // Whether routePacket() handles NetPacket::MULTICAST packets
+      virtual bool isMulticastSupported() { return false; }
 
       virtual void outputSummary(std::ostream &out) = 0;
 
@@ -123,6 +123,5 @@ void LCP::updateCommId(void *vp)
                  /*length*/ 0,
                  /*data*/ NULL);
    Byte *buffer = ack.makeBuffer();
-   m_transport->send(update->tile_id, buffer, ack.bufferSize());
-   delete [] buffer;
+   m_transport->sendBuffer(update->tile_id, buffer, ack.bufferSize());
 }
@@ -11,6 +11,7 @@
 #include "syscall.h"
 #include "thread_manager.h"
 #include "perf_counter_manager.h"
+#include "address_home_lookup.h"
 
 using namespace std;
 
@@ -127,6 +128,10 @@ void MCP::processPacket()
       Sim()->getPerfCounterManager()->disableCacheCounters(recv_pkt.sender.tile_id);
       break;
 
+   case MCP_MESSAGE_HOME_LOOKUP_FIRST_TOUCH:
+      mapHomePage(recv_pkt.sender);
+      break;
+
    default:
       LOG_PRINT_ERROR("Unhandled MCP message type: %i from %i", msg_type, recv_pkt.sender);
    }
@@ -136,6 +141,18 @@ void MCP::processPacket()
    LOG_PRINT("Finished processing message -- type : %d", (int)msg_type);
 }
 
+// First touch of a page by a tile in another process (see AddressHomeLookup).
+// The page keeps the home proposed by the first tile to touch it
+void MCP::mapHomePage(core_id_t sender)
+{
+   IntPtr address;
+   tile_id_t home;
+   m_recv_buff >> address >> home;
+
+   home = AddressHomeLookup::getPageTable()->insert(address, home);
+   m_network.netSend(sender, MCP_RESPONSE_TYPE, &home, sizeof(home));
+}
+
 void MCP::finish()
 {
    LOG_PRINT("Send MCP quit message");
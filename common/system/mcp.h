@@ -27,6 +27,8 @@ class MCP : public Runnable
       ClockSkewMinimizationServer* getClockSkewMinimizationServer() { return m_clock_skew_minimization_server; }
 
    private:
+      void mapHomePage(core_id_t sender);
+
       Boolean m_finished;
       Network & m_network;
       UnstructuredBuffer m_send_buff;
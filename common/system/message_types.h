@@ -22,7 +22,8 @@ typedef enum
    MCP_MESSAGE_THREAD_JOIN_REQUEST,
    MCP_MESSAGE_CLOCK_SKEW_MINIMIZATION,
    MCP_MESSAGE_RESET_CACHE_COUNTERS,
-   MCP_MESSAGE_DISABLE_CACHE_COUNTERS
+   MCP_MESSAGE_DISABLE_CACHE_COUNTERS,
+   MCP_MESSAGE_HOME_LOOKUP_FIRST_TOUCH
 } MCPMessageTypes;
 
 typedef enum
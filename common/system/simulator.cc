@@ -12,8 +12,35 @@
 #include "sim_thread_manager.h"
 #include "clock_skew_minimization_object.h"
 #include "fxsupport.h"
+#include "msg_pool.h"
+#include "thread.h"
+#include "semaphore.h"
+#include "memory_manager_base.h"
+#include "snapshot.h"
 #include "contrib/orion/orion.h"
 
+// Saves the memory system snapshot of one tile, then signals 'done'
+class TileSnapshotSaver : public Runnable
+{
+public:
+   TileSnapshotSaver(Tile* tile, std::string filename, Semaphore* done)
+      : m_tile(tile)
+      , m_filename(filename)
+      , m_done(done)
+   {}
+
+   void run()
+   {
+      m_tile->getMemoryManager()->saveSnapshot(m_filename);
+      m_done->signal();
+   }
+
+private:
+   Tile* m_tile;
+   std::string m_filename;
+   Semaphore* m_done;
+};
+
 Simulator *Simulator::m_singleton;
 config::Config *Simulator::m_config_file;
 
@@ -61,6 +88,7 @@ Simulator::Simulator()
    , m_perf_counter_manager(NULL)
    , m_sim_thread_manager(NULL)
    , m_clock_skew_minimization_manager(NULL)
+   , m_snapshot_saved(false)
    , m_finished(false)
    , m_boot_time(getTime())
    , m_start_time(0)
@@ -82,6 +110,7 @@ void Simulator::start()
    OrionConfig::allocate(orion_cfg_file);
    //OrionConfig::getSingleton()->print_config(cout);
  
+   MsgPool::allocate();
    m_transport = Transport::create();
    m_tile_manager = new TileManager();
    m_thread_manager = new ThreadManager(m_tile_manager);
@@ -147,6 +176,13 @@ Simulator::~Simulator()
       assert(temp.str().length() == 0);
    }
 
+   // The snapshot threads signal completion just before they exit
+   for (UInt32 i = 0; i < m_snapshot_threads.size(); i++)
+   {
+      delete m_snapshot_threads[i];
+      delete m_snapshot_savers[i];
+   }
+
    delete m_lcp_thread;
    delete m_mcp_thread;
    delete m_lcp;
@@ -156,6 +192,7 @@ Simulator::~Simulator()
    delete m_thread_manager;
    delete m_tile_manager;
    delete m_transport;
+   MsgPool::release();
 
    // Delete Orion Config Object
    OrionConfig::release();
@@ -243,8 +280,39 @@ bool Simulator::finished()
    return m_finished;
 }
 
+void Simulator::saveSnapshotInCurrentProcess()
+{
+   std::string snapshot_save_dir = m_config.getSnapshotSaveDir();
+   if ((snapshot_save_dir == "") || m_snapshot_saved)
+      return;
+   m_snapshot_saved = true;
+
+   Semaphore done(0);
+   UInt32 num_savers = 0;
+   for (UInt32 i = 0; i < m_config.getNumLocalTiles(); i++)
+   {
+      Tile* tile = m_tile_manager->getTileFromIndex(i);
+      if (tile->getMemoryManager() == NULL)
+         continue;
+
+      Runnable* saver = new TileSnapshotSaver(tile, Snapshot::getFilename(snapshot_save_dir, tile->getId()), &done);
+      Thread* thread = Thread::create(saver);
+      m_snapshot_savers.push_back(saver);
+      m_snapshot_threads.push_back(thread);
+      thread->run();
+      num_savers ++;
+   }
+
+   for (UInt32 i = 0; i < num_savers; i++)
+      done.wait();
+
+   LOG_PRINT("Saved the memory system snapshot of %u tiles to %s", num_savers, snapshot_save_dir.c_str());
+}
+
 void Simulator::enablePerformanceModelsInCurrentProcess()
 {
+   // The snapshot holds the warmed state that a run restoring it starts its models from
+   Sim()->saveSnapshotInCurrentProcess();
    Sim()->startTimer();
    for (UInt32 i = 0; i < Sim()->getConfig()->getNumLocalTiles(); i++)
       Sim()->getTileManager()->getTileFromIndex(i)->enablePerformanceModels();
@@ -5,11 +5,14 @@
 #include "log.h"
 #include "config.hpp"
 
+#include <vector>
+
 class MCP;
 class LCP;
 class Transport;
 class TileManager;
 class Thread;
+class Runnable;
 class ThreadManager;
 class PerfCounterManager;
 class SimThreadManager;
@@ -51,6 +54,9 @@ private:
    void startMCP();
    void endMCP();
 
+   // Writes the memory system snapshot of every local tile, one thread per tile
+   void saveSnapshotInCurrentProcess();
+
    // handle synchronization of shutdown for distributed simulator objects
    void broadcastFinish();
    void handleFinish(); // slave processes
@@ -72,6 +78,10 @@ private:
    SimThreadManager *m_sim_thread_manager;
    ClockSkewMinimizationManager *m_clock_skew_minimization_manager;
 
+   bool m_snapshot_saved;
+   std::vector<Runnable*> m_snapshot_savers;
+   std::vector<Thread*> m_snapshot_threads;
+
    static Simulator *m_singleton;
 
    bool m_finished;
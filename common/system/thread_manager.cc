@@ -90,6 +90,14 @@ void ThreadManager::onThreadStart(ThreadSpawnRequest *req)
 
    // Set the CoreState to 'RUNNING'
    m_tile_manager->getCurrentCore()->setState(Core::RUNNING);
+
+   // Helper threads are spawned locally; the master does not track them
+   if (req->destination.core_type == PEP_CORE_TYPE)
+   {
+      CoreModel *pm = m_tile_manager->getCurrentCore()->getPerformanceModel();
+      pm->queueDynamicInstruction(new SpawnInstruction(convertCycleCount(req->time, 1.0, pm->getFrequency())));
+      return;
+   }
  
    // send ack to master
    LOG_PRINT("(5) onThreadStart -- send ack to master; req : { %p, %p, {%i, %i}, {%i, %i} }",
@@ -139,6 +147,10 @@ void ThreadManager::onThreadExit()
    // on that tile
    m_tile_manager->terminateThread();
 
+   // The joining main thread polls the state of the PEP core
+   if (core->getCoreType() == PEP_CORE_TYPE)
+      return;
+
    // update global thread state
    net->netSend(Config::getSingleton()->getMCPCoreId(),
                 MCP_REQUEST_TYPE,
@@ -218,6 +230,40 @@ SInt32 ThreadManager::spawnThread(thread_func_t func, void *arg)
    return core_id.tile_id;
 }
 
+SInt32 ThreadManager::spawnHelperThread(thread_func_t func, void *arg)
+{
+   // Floating Point Save/Restore
+   FloatingPointHandler floating_point_handler;
+
+   LOG_PRINT("spawnHelperThread with func: %p and arg: %p", func, arg);
+
+   Core *core = m_tile_manager->getCurrentCore();
+   Core *pep_core = m_tile_manager->getCurrentTile()->getPepCore();
+   LOG_ASSERT_ERROR(pep_core, "Tile %i has no PEP core (general/enable_pep_cores)", core->getTileId());
+   LOG_ASSERT_ERROR(core->getCoreType() == MAIN_CORE_TYPE, "Only the main thread of tile %i can spawn a helper thread", core->getTileId());
+   LOG_ASSERT_ERROR(pep_core->getState() == Core::IDLE, "Helper thread already running on tile %i", core->getTileId());
+
+   pep_core->setState(Core::INITIALIZING);
+
+   // Tile Clock to Global Clock
+   UInt64 global_cycle_count = convertCycleCount(core->getPerformanceModel()->getCycleCount(), \
+         core->getPerformanceModel()->getFrequency(), 1.0);
+
+   // The thread spawner of this process starts the thread (steps 3 - 5)
+   ThreadSpawnRequest *req = new ThreadSpawnRequest;
+   req->msg_type = MCP_MESSAGE_THREAD_SPAWN_REQUEST_FROM_REQUESTER;
+   req->func = func;
+   req->arg = arg;
+   req->requester = core->getCoreId();
+   req->destination = pep_core->getCoreId();
+   req->time = global_cycle_count;
+
+   insertThreadSpawnRequest(req);
+   m_thread_spawn_sem.signal();
+
+   return pep_core->getCoreId().tile_id;
+}
+
 void ThreadManager::masterSpawnThread(ThreadSpawnRequest *req)
 {
    // step 2
@@ -404,6 +450,31 @@ void ThreadManager::joinThread(tile_id_t tile_id)
    LOG_PRINT("Exiting join main thread.");
 }
 
+void ThreadManager::joinHelperThread(tile_id_t tile_id)
+{
+   LOG_PRINT("Joining helper thread on tile: %d", tile_id);
+
+   Core *core = m_tile_manager->getCurrentCore();
+   LOG_ASSERT_ERROR(tile_id == core->getTileId(), "Helper thread on tile %i joined from tile %i", tile_id, core->getTileId());
+   Core *pep_core = m_tile_manager->getCurrentTile()->getPepCore();
+   LOG_ASSERT_ERROR(pep_core, "Tile %i has no PEP core (general/enable_pep_cores)", tile_id);
+
+   core->setState(Core::STALLED);
+
+   while (pep_core->getState() != Core::IDLE)
+      sched_yield();
+
+   core->setState(Core::WAKING_UP);
+
+   // The main thread waits until the helper thread finishes
+   CoreModel *pm = core->getPerformanceModel();
+   UInt64 helper_cycle_count = pep_core->getPerformanceModel()->getCycleCount();
+   if (helper_cycle_count > pm->getCycleCount())
+      pm->queueDynamicInstruction(new SyncInstruction(helper_cycle_count - pm->getCycleCount()));
+
+   LOG_PRINT("Exiting join helper thread.");
+}
+
 void ThreadManager::masterJoinThread(ThreadJoinRequest *req, UInt64 time)
 {
    LOG_ASSERT_ERROR(m_master, "masterJoinThread should only be called on master.");
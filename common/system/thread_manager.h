@@ -24,6 +24,10 @@ public:
    // services
    SInt32 spawnThread(thread_func_t func, void *arg);
    void joinThread(tile_id_t tile_id);
+
+   // Helper threads run on the PEP core of the caller's tile
+   SInt32 spawnHelperThread(thread_func_t func, void *arg);
+   void joinHelperThread(tile_id_t tile_id);
    
    void getThreadToSpawn(ThreadSpawnRequest *req);
    ThreadSpawnRequest* getThreadSpawnReq();
@@ -125,6 +125,14 @@ void TileManager::initializeThread(core_id_t core_id)
       tile_id_t local_tile_id = tile_list.at(i);
       if (local_tile_id == core_id.tile_id)
       {
+         // Helper threads run on the PEP core, next to the app thread of the tile
+         if (core_id.core_type == PEP_CORE_TYPE)
+         {
+            LOG_ASSERT_ERROR(m_tiles.at(i)->getPepCore(), "initializeThread -- tile %d has no PEP core", core_id.tile_id);
+            doInitializeThread(i, PEP_CORE_TYPE);
+            return;
+         }
+
          if (m_initialized_cores.at(i))
             LOG_PRINT_ERROR("initializeThread -- main core at %d/%d already mapped", i, Config::getSingleton()->getNumLocalTiles());
 
@@ -136,13 +144,21 @@ void TileManager::initializeThread(core_id_t core_id)
    LOG_PRINT_ERROR("initializeThread - Requested tile %d does not live on process %d.", core_id.tile_id, Config::getSingleton()->getCurrentProcessNum());
 }
 
-void TileManager::doInitializeThread(UInt32 tile_index)
+void TileManager::doInitializeThread(UInt32 tile_index, core_type_t core_type)
 {
     m_tile_tls->set(m_tiles.at(tile_index));
     m_tile_index_tls->setInt(tile_index);
-    m_thread_type_tls->setInt(APP_THREAD);
-    m_initialized_cores.at(tile_index) = true;
-    LOG_PRINT("Initialize app thread : index %d mapped to tile (id): %p (%d)", tile_index, m_tiles.at(tile_index), m_tiles.at(tile_index)->getId());
+    if (core_type == PEP_CORE_TYPE)
+    {
+       m_thread_type_tls->setInt(HELPER_THREAD);
+    }
+    else
+    {
+       m_thread_type_tls->setInt(APP_THREAD);
+       m_initialized_cores.at(tile_index) = true;
+    }
+    LOG_PRINT("Initialize %s thread : index %d mapped to tile (id): %p (%d)", (core_type == PEP_CORE_TYPE) ? "helper" : "app",
+              tile_index, m_tiles.at(tile_index), m_tiles.at(tile_index)->getId());
     LOG_ASSERT_ERROR(m_tile_tls->get() == (void*)(m_tiles.at(tile_index)),
                      "TLS appears to be broken. %p != %p", m_tile_tls->get(), (void*)(m_tiles.at(tile_index)));
 }
@@ -152,7 +168,8 @@ void TileManager::terminateThread()
    LOG_ASSERT_WARNING(m_tile_tls->get() != NULL, "Thread not initialized while terminating.");
 
    tile_id_t tile_index = m_tile_index_tls->getInt();
-   m_initialized_cores.at(tile_index) = false;
+   if (m_thread_type_tls->getInt() == APP_THREAD)
+      m_initialized_cores.at(tile_index) = false;
 
    m_tile_tls->set(NULL);
    m_tile_index_tls->setInt(-1);
@@ -281,6 +298,8 @@ Core *TileManager::getCore(Tile *tile)
 
    if (m_thread_type_tls->getInt() == APP_THREAD)
       return tile->getCore();
+   else if (m_thread_type_tls->getInt() == HELPER_THREAD)
+      return tile->getPepCore();
    else
    {
       LOG_PRINT_ERROR("Incorrect thread type!");
@@ -325,3 +344,8 @@ bool TileManager::amiUserThread()
     return m_thread_type_tls->getInt() == APP_THREAD;
 }
 
+bool TileManager::amiHelperThread()
+{
+    return m_thread_type_tls->getInt() == HELPER_THREAD;
+}
+
@@ -47,10 +47,11 @@ class TileManager
 
       bool amiUserThread();
       bool amiSimThread();
+      bool amiHelperThread();
 
    private:
 
-      void doInitializeThread(UInt32 tile_index);
+      void doInitializeThread(UInt32 tile_index, core_type_t core_type = MAIN_CORE_TYPE);
 
       UInt32 *tid_map;
       TLS *m_tile_tls;
@@ -60,7 +61,8 @@ class TileManager
       enum ThreadType {
           INVALID,
           APP_THREAD,
-          SIM_THREAD
+          SIM_THREAD,
+          HELPER_THREAD
       };
 
 
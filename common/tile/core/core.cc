@@ -1,5 +1,6 @@
 #include "core.h"
 #include "main_core.h"
+#include "pep_core.h"
 #include "tile.h"
 #include "network.h"
 #include "syscall_model.h"
@@ -18,7 +19,18 @@ Lock Core::m_global_core_lock;
 
 Core * Core::create(Tile* tile, core_type_t core_type)
 {
-   return new MainCore(tile); 
+   switch (core_type)
+   {
+      case MAIN_CORE_TYPE:
+         return new MainCore(tile); 
+
+      case PEP_CORE_TYPE:
+         return new PepCore(tile);
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized core type(%u)", core_type);
+         return NULL;
+   }
 }
 
 Core::Core(Tile *tile)
@@ -30,7 +42,7 @@ Core::Core(Tile *tile)
 
 Core::~Core()
 {
-   LOG_PRINT("Deleting main core on tile %d", this->getCoreId().tile_id);
+   LOG_PRINT("Deleting core(%u) on tile %d", this->getCoreType(), this->getCoreId().tile_id);
 
    delete m_sync_client;
 }
@@ -126,6 +138,72 @@ Core::nativeMemOp(lock_signal_t lock_signal, mem_op_t mem_op_type, IntPtr d_addr
 }
 
 
+pair<UInt32, UInt64>
+Core::initiateMemoryAccess(MemComponent::component_t mem_component, 
+      lock_signal_t lock_signal, 
+      mem_op_t mem_op_type, 
+      IntPtr address, 
+      Byte* data_buf, UInt32 data_size,
+      bool modeled,
+      UInt64 time)
+{
+   if (data_size <= 0)
+   {
+      if (modeled)
+      {
+         DynamicInstructionInfo info = DynamicInstructionInfo::createMemoryInfo(0, address, (mem_op_type == WRITE) ? Operand::WRITE : Operand::READ, 0);
+         m_core_model->pushDynamicInstructionInfo(info);
+      }
+      return make_pair<UInt32, UInt64>(0,0);
+   }
+
+   // Setting the initial time
+   UInt64 initial_time = time;
+   if (time == 0)
+      initial_time = getPerformanceModel()->getCycleCount();
+
+   getShmemPerfModel()->setCycleCount(initial_time);
+
+   LOG_PRINT("Time(%llu), %s - ADDR(0x%x), data_size(%u), START",
+        initial_time,
+        ((mem_op_type == READ) ? "READ" : "WRITE"), 
+        address, data_size);
+
+   // Resolves the lines that hit together and issues the misses in order
+   UInt32 num_misses = getMemoryManager()->coreInitiateMemoryAccessRange(
+         mem_component,
+         lock_signal,
+         mem_op_type,
+         address,
+         data_buf, data_size,
+         modeled);
+
+   // Get the final cycle time
+   UInt64 final_time = getShmemPerfModel()->getCycleCount();
+   LOG_ASSERT_ERROR(final_time >= initial_time,
+         "final_time(%llu) < initial_time(%llu)",
+         final_time, initial_time);
+   
+   LOG_PRINT("Time(%llu), %s - ADDR(0x%x), data_size(%u), END\n", 
+        final_time,
+        ((mem_op_type == READ) ? "READ" : "WRITE"), 
+        address, data_size);
+
+   // Calculate the round-trip time
+   UInt64 memory_access_latency = final_time - initial_time;
+
+   if (modeled)
+   {
+      DynamicInstructionInfo info = DynamicInstructionInfo::createMemoryInfo(memory_access_latency, address, (mem_op_type == WRITE) ? Operand::WRITE : Operand::READ, num_misses);
+
+      m_core_model->pushDynamicInstructionInfo(info);
+
+      getShmemPerfModel()->incrTotalMemoryAccessLatency(memory_access_latency);
+   }
+
+   return make_pair<UInt32, UInt64>(num_misses, memory_access_latency);
+}
+
 int Core::getTileId() 
 { 
    return m_tile->getId(); 
@@ -0,0 +1,51 @@
+#include "tile.h"
+#include "core.h"
+#include "pep_core.h"
+#include "network.h"
+#include "memory_manager_base.h"
+#include "pin_memory_manager.h"
+#include "core_model.h"
+#include "syscall_model.h"
+#include "sync_client.h"
+#include "simulator.h"
+#include "log.h"
+
+using namespace std;
+
+PepCore::PepCore(Tile* tile) : Core(tile)
+{
+   m_core_id = tile->getPepCoreId();
+   m_core_model = CoreModel::createMainPerfModel((Core *) this);
+
+   // The main core creates the memory models of the tile
+   LOG_ASSERT_ERROR(tile->getMemoryManager() != NULL, "PEP core needs the memory manager of the main core");
+   m_shmem_perf_model = tile->getShmemPerfModel();
+   m_memory_manager = tile->getMemoryManager();
+
+   m_pin_memory_manager = new PinMemoryManager(this);
+   m_syscall_model = new SyscallMdl(m_tile->getNetwork());
+}
+
+PepCore::~PepCore()
+{
+   delete m_core_model;
+   delete m_pin_memory_manager;
+   delete m_syscall_model;
+}
+
+pair<UInt32, UInt64>
+PepCore::accessMemory(lock_signal_t lock_signal, mem_op_t mem_op_type, IntPtr d_addr, char* data_buffer, UInt32 data_size, bool modeled)
+{
+   return initiateMemoryAccess(MemComponent::L1_PEP_DCACHE, lock_signal, mem_op_type, d_addr, (Byte*) data_buffer, data_size, modeled);
+}
+
+UInt64
+PepCore::readInstructionMemory(IntPtr address, UInt32 instruction_size)
+{
+   LOG_PRINT("Instruction: Address(0x%x), Size(%u), Start READ", 
+           address, instruction_size);
+
+   Byte buf[instruction_size];
+   return (initiateMemoryAccess(MemComponent::L1_PEP_ICACHE,
+         Core::NONE, Core::READ, address, buf, instruction_size).second);
+}
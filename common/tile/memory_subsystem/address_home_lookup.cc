@@ -1,12 +1,32 @@
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+
 #include "address_home_lookup.h"
+#include "simulator.h"
+#include "config.h"
+#include "message_types.h"
+#include "packetize.h"
+#include "network_model_emesh_hop_by_hop_generic.h"
+#include "utils.h"
 #include "log.h"
 
+HomePageTable* AddressHomeLookup::s_page_table = NULL;
+bool AddressHomeLookup::s_map_file_loaded = false;
+Lock AddressHomeLookup::s_page_table_lock;
+
 AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param,
       vector<tile_id_t>& tile_list,
-      UInt32 cache_block_size):
+      UInt32 cache_block_size,
+      tile_id_t tile_id,
+      Network* network):
    m_ahl_param(ahl_param),
    m_tile_list(tile_list),
-   m_cache_block_size(cache_block_size)
+   m_cache_block_size(cache_block_size),
+   m_page_table(NULL),
+   m_nearest_home(INVALID_TILE_ID),
+   m_first_touch_via_mcp(false),
+   m_network(network)
 {
 
    // Each Block Address is as follows:
@@ -18,18 +38,204 @@ AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param,
          "AHL param(%u) must be >= Cache Block Size(%u)",
          m_ahl_param, m_cache_block_size);
    m_total_modules = tile_list.size();
+
+   UInt32 page_size = 0;
+   std::string map_filename;
+   try
+   {
+      m_policy = parseHomePolicy(Sim()->getCfg()->getString("perf_model/dram_directory/home_lookup/policy", "interleaved"));
+      page_size = Sim()->getCfg()->getInt("perf_model/dram_directory/home_lookup/page_size", 4096);
+      map_filename = Sim()->getCfg()->getString("perf_model/dram_directory/home_lookup/map_file", "");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [perf_model/dram_directory/home_lookup] params from the config file");
+   }
+
+   LOG_ASSERT_ERROR(isPower2(page_size) && (page_size >= m_cache_block_size),
+         "Home lookup page size(%u) must be a power of 2 and >= Cache Block Size(%u)",
+         page_size, m_cache_block_size);
+   m_log_page_size = floorLog2(page_size);
+
+   if ((m_policy == FIRST_TOUCH) || (m_policy == PAGE_MAP_FILE))
+      m_page_table = getPageTable();
+
+   if (m_policy == FIRST_TOUCH)
+   {
+      m_nearest_home = getNearestHome(tile_id);
+
+      Config* config = Config::getSingleton();
+      m_first_touch_via_mcp = (config->getCurrentProcessNum() != config->getProcessNumForTile(config->getMCPTileNum()));
+   }
+   else if (m_policy == PAGE_MAP_FILE)
+   {
+      // The tiles of a process share the page table; the first one fills it
+      ScopedLock sl(s_page_table_lock);
+      if (!s_map_file_loaded)
+      {
+         loadMapFile(map_filename);
+         s_map_file_loaded = true;
+      }
+   }
 }
 
 AddressHomeLookup::~AddressHomeLookup()
 {
-   // There is no memory to deallocate, so destructor has no function
+   // The page table is shared by the tiles of the process
+}
+
+tile_id_t
+AddressHomeLookup::getHome(IntPtr address)
+{
+   switch (m_policy)
+   {
+      case INTERLEAVED:
+         {
+            SInt32 module_num = (address >> m_ahl_param) % m_total_modules;
+            LOG_ASSERT_ERROR(0 <= module_num && module_num < (SInt32) m_total_modules, "module_num(%i), total_modules(%u)", module_num, m_total_modules);
+
+            LOG_PRINT("address(0x%x), module_num(%i)", address, module_num);
+            return (m_tile_list[module_num]);
+         }
+
+      case PAGE_ROUND_ROBIN:
+         return getPageRoundRobinHome(address);
+
+      case FIRST_TOUCH:
+         {
+            tile_id_t home = m_page_table->lookup(address);
+            if (home == INVALID_TILE_ID)
+            {
+               // Within one process, any tile can map the page
+               LOG_ASSERT_ERROR(!m_first_touch_via_mcp, "address(0x%x): page not touched yet", address);
+               home = m_page_table->insert(address, m_nearest_home);
+            }
+            return home;
+         }
+
+      case PAGE_MAP_FILE:
+         {
+            tile_id_t home = m_page_table->lookup(address);
+            return (home == INVALID_TILE_ID) ? getPageRoundRobinHome(address) : home;
+         }
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized home policy(%u)", m_policy);
+         return INVALID_TILE_ID;
+   }
+}
+
+void
+AddressHomeLookup::touch(IntPtr address)
+{
+   if ((m_policy != FIRST_TOUCH) || (m_page_table->lookup(address) != INVALID_TILE_ID))
+      return;
+
+   if (!m_first_touch_via_mcp)
+   {
+      m_page_table->insert(address, m_nearest_home);
+      return;
+   }
+
+   // The MCP keeps the pages of all the processes consistent: it returns
+   // the home chosen by the first tile to touch the page
+   UnstructuredBuffer send_buff;
+   int msg_type = MCP_MESSAGE_HOME_LOOKUP_FIRST_TOUCH;
+   send_buff << msg_type << address << m_nearest_home;
+   m_network->netSend(Config::getSingleton()->getMCPCoreId(), MCP_REQUEST_TYPE, send_buff.getBuffer(), send_buff.size());
+
+   NetPacket recv_pkt = m_network->netRecv(Config::getSingleton()->getMCPCoreId(), MCP_RESPONSE_TYPE);
+   assert(recv_pkt.length == sizeof(tile_id_t));
+   tile_id_t home = *((tile_id_t*) recv_pkt.data);
+   delete [] (Byte*) recv_pkt.data;
+
+   m_page_table->insert(address, home);
+}
+
+bool
+AddressHomeLookup::isHomeKnown(IntPtr address)
+{
+   return ((m_policy != FIRST_TOUCH) || (!m_first_touch_via_mcp) ||
+           (m_page_table->lookup(address) != INVALID_TILE_ID));
+}
+
+tile_id_t
+AddressHomeLookup::getNearestHome(tile_id_t tile_id)
+{
+   // Distances are measured on the electrical mesh
+   tile_id_t nearest_home = m_tile_list[0];
+   SInt32 min_num_hops = NetworkModelEMeshHopByHopGeneric::computeNumHops(tile_id, nearest_home);
+   for (UInt32 i = 1; i < m_tile_list.size(); i++)
+   {
+      SInt32 num_hops = NetworkModelEMeshHopByHopGeneric::computeNumHops(tile_id, m_tile_list[i]);
+      if (num_hops < min_num_hops)
+      {
+         nearest_home = m_tile_list[i];
+         min_num_hops = num_hops;
+      }
+   }
+   return nearest_home;
+}
+
+void
+AddressHomeLookup::loadMapFile(std::string filename)
+{
+   std::ifstream map_file(filename.c_str());
+   LOG_ASSERT_ERROR(map_file.good(), "Could not open home map file(%s)", filename.c_str());
+
+   std::string line;
+   while (std::getline(map_file, line))
+   {
+      if ((line.size() == 0) || (line[0] == '#'))
+         continue;
+
+      unsigned long long address;
+      tile_id_t home;
+      LOG_ASSERT_ERROR(sscanf(line.c_str(), "%llx %i", &address, &home) == 2,
+            "Home map file(%s): could not parse line(%s)", filename.c_str(), line.c_str());
+      LOG_ASSERT_ERROR(std::find(m_tile_list.begin(), m_tile_list.end(), home) != m_tile_list.end(),
+            "Home map file(%s): tile(%i) has no memory controller", filename.c_str(), home);
+
+      tile_id_t mapped_home = m_page_table->insert((IntPtr) address, home);
+      LOG_ASSERT_ERROR(mapped_home == home, "Home map file(%s): address(%#llx) mapped twice",
+            filename.c_str(), address);
+   }
+}
+
+HomePageTable*
+AddressHomeLookup::getPageTable()
+{
+   ScopedLock sl(s_page_table_lock);
+   if (s_page_table == NULL)
+   {
+      UInt32 page_size = 0;
+      try
+      {
+         page_size = Sim()->getCfg()->getInt("perf_model/dram_directory/home_lookup/page_size", 4096);
+      }
+      catch (...)
+      {
+         LOG_PRINT_ERROR("Could not read perf_model/dram_directory/home_lookup/page_size from the config file");
+      }
+      s_page_table = new HomePageTable(floorLog2(page_size));
+   }
+   return s_page_table;
 }
 
-tile_id_t AddressHomeLookup::getHome(IntPtr address) const
+AddressHomeLookup::HomePolicy
+AddressHomeLookup::parseHomePolicy(std::string policy_str)
 {
-   SInt32 module_num = (address >> m_ahl_param) % m_total_modules;
-   LOG_ASSERT_ERROR(0 <= module_num && module_num < (SInt32) m_total_modules, "module_num(%i), total_modules(%u)", module_num, m_total_modules);
-   
-   LOG_PRINT("address(0x%x), module_num(%i)", address, module_num);
-   return (m_tile_list[module_num]);
+   if (policy_str == "interleaved")
+      return INTERLEAVED;
+   else if (policy_str == "page_round_robin")
+      return PAGE_ROUND_ROBIN;
+   else if (policy_str == "first_touch")
+      return FIRST_TOUCH;
+   else if (policy_str == "map_file")
+      return PAGE_MAP_FILE;
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized home lookup policy(%s)", policy_str.c_str());
+      return NUM_HOME_POLICIES;
+   }
 }
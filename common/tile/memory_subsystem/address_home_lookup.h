@@ -1,12 +1,16 @@
 #ifndef __ADDRESS_HOME_LOOKUP_H__
 #define __ADDRESS_HOME_LOOKUP_H__
 
+#include <string>
 #include <vector>
 using namespace std;
 
+#include "home_page_table.h"
+#include "network.h"
+#include "lock.h"
 #include "fixed_types.h"
 
-/* 
+/*
  * TODO abstract MMU stuff to a configure file to allow
  * user to specify number of memory controllers, and
  * the address space that each is in charge of.  Default behavior:
@@ -19,20 +23,68 @@ using namespace std;
  * Maybe allow the ability to have public and private memory space?
  */
 
+// Home policies ([perf_model/dram_directory/home_lookup]):
+//    interleaved       - blocks of 2^ahl_param bytes, round-robin
+//    page_round_robin  - pages, round-robin
+//    first_touch       - a page lives with the memory controller nearest to
+//                        the first tile that misses on it
+//    map_file          - pages listed in a file ("<address> <tile>" lines),
+//                        the rest round-robin
+// The page homes are kept in a HomePageTable shared by the tiles of the
+// process. With several processes, first touches are arbitrated by the MCP
 class AddressHomeLookup
 {
    public:
+      enum HomePolicy
+      {
+         INTERLEAVED = 0,
+         PAGE_ROUND_ROBIN,
+         FIRST_TOUCH,
+         PAGE_MAP_FILE,
+         NUM_HOME_POLICIES
+      };
+
       AddressHomeLookup(UInt32 ahl_param,
             vector<tile_id_t>& tile_list,
-            UInt32 cache_block_size);
+            UInt32 cache_block_size,
+            tile_id_t tile_id,
+            Network* network);
       ~AddressHomeLookup();
-      tile_id_t getHome(IntPtr address) const;
+
+      tile_id_t getHome(IntPtr address);
+      // Maps a page on its first touch (first_touch). May wait for the MCP,
+      // so it must be called from the user thread with no cache lock held
+      void touch(IntPtr address);
+      // False if the page of 'address' has to be touched before getHome()
+      bool isHomeKnown(IntPtr address);
+
+      // The page table of this process (also used by the MCP)
+      static HomePageTable* getPageTable();
+      static HomePolicy parseHomePolicy(std::string policy_str);
 
    private:
       UInt32 m_ahl_param;
       vector<tile_id_t> m_tile_list;
       UInt32 m_total_modules;
       UInt32 m_cache_block_size;
+
+      HomePolicy m_policy;
+      UInt32 m_log_page_size;
+      HomePageTable* m_page_table;
+      // Memory controller nearest to this tile (first_touch)
+      tile_id_t m_nearest_home;
+      // First touches are sent to the MCP (it runs in another process)
+      bool m_first_touch_via_mcp;
+      Network* m_network;
+
+      static HomePageTable* s_page_table;
+      static bool s_map_file_loaded;
+      static Lock s_page_table_lock;
+
+      tile_id_t getPageRoundRobinHome(IntPtr address)
+      { return m_tile_list[(address >> m_log_page_size) % m_total_modules]; }
+      tile_id_t getNearestHome(tile_id_t tile_id);
+      void loadMapFile(std::string filename);
 };
 
 #endif /* __ADDRESS_HOME_LOOKUP_H__ */
@@ -10,16 +10,25 @@ Cache::Cache(string name,
       UInt32 cache_size,
       UInt32 associativity, UInt32 cache_block_size,
       string replacement_policy,
-      cache_t cache_type) :
+      cache_t cache_type,
+      bool data_storage_enabled) :
       
    CacheBase(name, cache_size, associativity, cache_block_size),
    m_enabled(false),
-   m_cache_type(cache_type)
+   m_cache_type(cache_type),
+   m_replacement_policy(replacement_policy),
+   m_policy(CacheSet::parsePolicyType(replacement_policy)),
+   m_data_storage_enabled(data_storage_enabled),
+   m_stack_distance_profiler(NULL),
+   m_heatmap(NULL)
 {
+   m_set_dueling_monitor = (m_policy == DRRIP) ? new SetDuelingMonitor(m_num_sets) : NULL;
+
    m_sets = new CacheSet*[m_num_sets];
    for (UInt32 i = 0; i < m_num_sets; i++)
    {
-      m_sets[i] = CacheSet::createCacheSet(replacement_policy, m_cache_type, m_associativity, m_blocksize);
+      m_sets[i] = CacheSet::createCacheSet(replacement_policy, m_cache_type, m_associativity, m_blocksize, data_storage_enabled,
+            i, m_set_dueling_monitor);
    }
 
    // Initialize Cache Counters
@@ -31,6 +40,9 @@ Cache::~Cache()
    for (SInt32 i = 0; i < (SInt32) m_num_sets; i++)
       delete m_sets[i];
    delete [] m_sets;
+   delete m_set_dueling_monitor;
+   delete m_stack_distance_profiler;
+   delete m_heatmap;
 }
 
 bool 
@@ -42,81 +54,248 @@ Cache::invalidateSingleLine(IntPtr addr)
    splitAddress(addr, tag, set_index);
    assert(set_index < m_num_sets);
 
-   return m_sets[set_index]->invalidate(tag);
+   bool invalidated = m_sets[set_index]->invalidate(tag);
+   if (invalidated && (m_heatmap != NULL))
+      m_heatmap->invalidate(addr);
+   return invalidated;
 }
 
+// Single line cache access at addr
 CacheBlockInfo* 
-Cache::accessSingleLine(IntPtr addr, access_t access_type, 
-      Byte* buff, UInt32 bytes)
+Cache::peekSingleLine(IntPtr addr)
 {
-   assert((buff == NULL) == (bytes == 0));
+   IntPtr tag;
+   UInt32 set_index;
+   splitAddress(addr, tag, set_index);
 
+   return m_sets[set_index]->find(tag);
+}
+
+bool
+Cache::readSingleLine(IntPtr addr, Byte* buff, UInt32 bytes)
+{
    IntPtr tag;
    UInt32 set_index;
    UInt32 line_index = -1;
    UInt32 block_offset;
-
    splitAddress(addr, tag, set_index, block_offset);
 
-   CacheSet* set = m_sets[set_index];
-   CacheBlockInfo* cache_block_info = set->find(tag, &line_index);
-
-   if (cache_block_info == NULL)
-      return NULL;
-
-   if (access_type == LOAD)
-      set->read_line(line_index, block_offset, buff, bytes);
-   else
-      set->write_line(line_index, block_offset, buff, bytes);
-
-   return cache_block_info;
+   if (m_sets[set_index]->find(tag, &line_index) == NULL)
+      return false;
+   m_sets[set_index]->readLineData(line_index, block_offset, buff, bytes);
+   return true;
 }
 
-void 
-Cache::insertSingleLine(IntPtr addr, Byte* fill_buff,
-      bool* eviction, IntPtr* evict_addr, 
-      CacheBlockInfo* evict_block_info, Byte* evict_buff)
+template <class SetType>
+void
+Cache::touchSingleLineAs(IntPtr addr)
 {
    IntPtr tag;
    UInt32 set_index;
+   UInt32 line_index = -1;
    splitAddress(addr, tag, set_index);
 
-   CacheBlockInfo* cache_block_info = CacheBlockInfo::create(m_cache_type);
-   cache_block_info->setTag(tag);
-
-   m_sets[set_index]->insert(cache_block_info, fill_buff, 
-         eviction, evict_block_info, evict_buff);
-   *evict_addr = tagToAddress(evict_block_info->getTag());
-   delete cache_block_info;
+   // The line may have been invalidated since the hit
+   SetType* set = static_cast<SetType*>(m_sets[set_index]);
+   if (set->find(tag, &line_index) != NULL)
+      set->updateReplacementIndex(line_index);
 }
 
+void
+Cache::touchSingleLine(IntPtr addr)
+{
+   switch (m_policy)
+   {
+      case ROUND_ROBIN:
+         touchSingleLineAs<CacheSetRoundRobin>(addr);
+         break;
+      case LRU:
+         touchSingleLineAs<CacheSetLRU>(addr);
+         break;
+      case PLRU:
+         touchSingleLineAs<CacheSetPLRU>(addr);
+         break;
+      case SRRIP:
+      case BRRIP:
+      case DRRIP:
+         touchSingleLineAs<CacheSetRRIP>(addr);
+         break;
+      default:
+         touchSingleLineAs<CacheSetRandom>(addr);
+         break;
+   }
+}
 
-// Single line cache access at addr
-CacheBlockInfo* 
-Cache::peekSingleLine(IntPtr addr)
+void
+Cache::setStackDistanceProfiler(StackDistanceProfiler* stack_distance_profiler)
 {
-   IntPtr tag;
-   UInt32 set_index;
-   splitAddress(addr, tag, set_index);
+   delete m_stack_distance_profiler;
+   m_stack_distance_profiler = stack_distance_profiler;
+}
 
-   return m_sets[set_index]->find(tag);
+void
+Cache::setHeatmap(CacheHeatmap* heatmap)
+{
+   delete m_heatmap;
+   m_heatmap = heatmap;
 }
 
 void
-Cache::updateCounters(bool cache_hit)
+Cache::updateCounters(IntPtr addr, bool cache_hit, bool lock_free)
 {
    if (m_enabled)
    {
       m_num_accesses ++;
       if (cache_hit)
          m_num_hits ++;
+      if (lock_free)
+         m_num_lock_free_hits ++;
+   }
+
+   if (m_heatmap != NULL)
+   {
+      IntPtr tag;
+      UInt32 set_index;
+      splitAddress(addr, tag, set_index);
+      bool tag_present = cache_hit || (m_sets[set_index]->find(tag) != NULL);
+      m_heatmap->access(set_index, addr, cache_hit, tag_present);
    }
 }
 
+void
+Cache::enable()
+{
+   m_enabled = true;
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->enable();
+   if (m_heatmap != NULL)
+      m_heatmap->enable();
+}
+
+void
+Cache::disable()
+{
+   m_enabled = false;
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->disable();
+   if (m_heatmap != NULL)
+      m_heatmap->disable();
+}
+
 void
 Cache::reset()
 {
    initializePerformanceCounters();
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->reset();
+   if (m_heatmap != NULL)
+      m_heatmap->reset();
+}
+
+template <class SetType>
+void
+Cache::saveReplacementStateAs(SnapshotWriter& writer)
+{
+   for (UInt32 i = 0; i < m_num_sets; i++)
+      static_cast<SetType*>(m_sets[i])->saveReplacementState(writer);
+}
+
+template <class SetType>
+void
+Cache::loadReplacementStateAs(SnapshotReader& reader)
+{
+   for (UInt32 i = 0; i < m_num_sets; i++)
+      static_cast<SetType*>(m_sets[i])->loadReplacementState(reader);
+}
+
+void
+Cache::saveSnapshot(SnapshotWriter& writer)
+{
+   writer.write<UInt32>(m_num_sets);
+   writer.write<UInt32>(m_associativity);
+   writer.write<UInt32>(m_blocksize);
+   writer.write<bool>(m_data_storage_enabled);
+   for (UInt32 i = 0; i < m_num_sets; i++)
+      m_sets[i]->saveSnapshot(writer);
+
+   writer.writeString(m_replacement_policy);
+   UInt64 section = writer.beginSection();
+   if (m_set_dueling_monitor != NULL)
+      m_set_dueling_monitor->saveSnapshot(writer);
+   switch (m_policy)
+   {
+      case ROUND_ROBIN:
+         saveReplacementStateAs<CacheSetRoundRobin>(writer);
+         break;
+      case LRU:
+         saveReplacementStateAs<CacheSetLRU>(writer);
+         break;
+      case PLRU:
+         saveReplacementStateAs<CacheSetPLRU>(writer);
+         break;
+      case SRRIP:
+      case BRRIP:
+      case DRRIP:
+         saveReplacementStateAs<CacheSetRRIP>(writer);
+         break;
+      default:
+         saveReplacementStateAs<CacheSetRandom>(writer);
+         break;
+   }
+   writer.endSection(section);
+}
+
+void
+Cache::loadSnapshot(SnapshotReader& reader)
+{
+   UInt32 num_sets = reader.read<UInt32>();
+   UInt32 associativity = reader.read<UInt32>();
+   UInt32 blocksize = reader.read<UInt32>();
+   bool snapshot_has_data = reader.read<bool>();
+   LOG_ASSERT_ERROR((num_sets == m_num_sets) && (associativity == m_associativity) && (blocksize == m_blocksize),
+         "Cache %s: snapshot geometry (%u sets, %u ways, %u byte blocks) does not match (%u sets, %u ways, %u byte blocks)",
+         m_name.c_str(), num_sets, associativity, blocksize, m_num_sets, m_associativity, m_blocksize);
+   // The memory models hold the only copy of the data when it is stored
+   LOG_ASSERT_ERROR(snapshot_has_data || !m_data_storage_enabled,
+         "Cache %s: snapshot was taken without data storage", m_name.c_str());
+
+   for (UInt32 i = 0; i < m_num_sets; i++)
+      m_sets[i]->loadSnapshot(reader, snapshot_has_data);
+
+   std::string replacement_policy = reader.readString();
+   UInt64 section_end = reader.beginSection();
+   if (replacement_policy == m_replacement_policy)
+   {
+      if (m_set_dueling_monitor != NULL)
+         m_set_dueling_monitor->loadSnapshot(reader);
+      switch (m_policy)
+      {
+         case ROUND_ROBIN:
+            loadReplacementStateAs<CacheSetRoundRobin>(reader);
+            break;
+         case LRU:
+            loadReplacementStateAs<CacheSetLRU>(reader);
+            break;
+         case PLRU:
+            loadReplacementStateAs<CacheSetPLRU>(reader);
+            break;
+         case SRRIP:
+         case BRRIP:
+         case DRRIP:
+            loadReplacementStateAs<CacheSetRRIP>(reader);
+            break;
+         default:
+            loadReplacementStateAs<CacheSetRandom>(reader);
+            break;
+      }
+      reader.endSection(section_end);
+   }
+   else
+   {
+      LOG_PRINT_WARNING("Cache %s: snapshot replacement policy(%s) differs from(%s), starting from a cold replacement state",
+            m_name.c_str(), replacement_policy.c_str(), m_replacement_policy.c_str());
+      reader.skipSection(section_end);
+   }
 }
 
 void
@@ -124,6 +303,8 @@ Cache::initializePerformanceCounters()
 {
    m_num_accesses = 0;
    m_num_hits = 0;
+   m_num_evicts = 0;
+   m_num_lock_free_hits = 0;
 }
 
 void 
@@ -134,4 +315,11 @@ Cache::outputSummary(ostream& out)
    out << "    miss rate: " <<
       ((float) (m_num_accesses - m_num_hits) / (m_num_accesses)) * 100 << endl;
    out << "    num cache misses: " <<m_num_accesses - m_num_hits << endl;
+   out << "    num cache evictions: " << m_num_evicts << endl;
+   if (m_cache_type == PR_L1_CACHE)
+      out << "    num lock-free hits: " << m_num_lock_free_hits << endl;
+   if (m_heatmap != NULL)
+      m_heatmap->outputSummary(out);
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->outputSummary(out);
 }
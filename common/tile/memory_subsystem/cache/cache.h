@@ -7,6 +7,8 @@
 #include "cache_base.h"
 #include "cache_set.h"
 #include "cache_block_info.h"
+#include "stack_distance_profiler.h"
+#include "cache_heatmap.h"
 #include "utils.h"
 #include "hash_map_set.h"
 #include "cache_perf_model.h"
@@ -22,11 +24,40 @@ class Cache : public CacheBase
       UInt64 m_num_accesses;
       UInt64 m_num_hits;
       UInt64 m_num_evicts;
+      // Hits served without the cache lock (private L1 Caches)
+      UInt64 m_num_lock_free_hits;
 
       // Generic Cache Info
       //
       cache_t m_cache_type;
+      std::string m_replacement_policy;
+      // Picks the concrete class of all the sets
+      ReplacementPolicy m_policy;
+      bool m_data_storage_enabled;
       CacheSet** m_sets;
+      // Shared by the sets of a cache that use a set-dueling policy (DRRIP);
+      // NULL for the other policies
+      SetDuelingMonitor* m_set_dueling_monitor;
+      // Miss rate curve of the references to this cache (optional)
+      StackDistanceProfiler* m_stack_distance_profiler;
+      // Per-set hit/miss/eviction counters (optional)
+      CacheHeatmap* m_heatmap;
+
+      // The access, insert and replacement paths, instantiated for every
+      // concrete set class. The public functions enter them through a switch
+      // on m_policy; below it, all the calls on a set are bound at compile time
+      template <class SetType>
+      CacheBlockInfo* accessSingleLineAs(IntPtr addr, access_t access_type, Byte* buff, UInt32 bytes);
+      template <class SetType, class BlockInfo>
+      BlockInfo insertSingleLineAs(IntPtr addr, CacheState::cstate_t cstate,
+            Byte* fill_buff, bool* eviction, IntPtr* evict_addr,
+            Byte* evict_buff, BlockInfo** inserted_block_info);
+      template <class SetType>
+      void touchSingleLineAs(IntPtr addr);
+      template <class SetType>
+      void saveReplacementStateAs(SnapshotWriter& writer);
+      template <class SetType>
+      void loadReplacementStateAs(SnapshotReader& reader);
       
    public:
 
@@ -35,27 +66,160 @@ class Cache : public CacheBase
             UInt32 cache_size, 
             UInt32 associativity, UInt32 cache_block_size,
             std::string replacement_policy,
-            cache_t cache_type);
+            cache_t cache_type,
+            bool data_storage_enabled = true);
       ~Cache();
 
       bool invalidateSingleLine(IntPtr addr);
       CacheBlockInfo* accessSingleLine(IntPtr addr, 
             access_t access_type, Byte* buff = NULL, UInt32 bytes = 0);
-      void insertSingleLine(IntPtr addr, Byte* fill_buff,
-            bool* eviction, IntPtr* evict_addr, 
-            CacheBlockInfo* evict_block_info, Byte* evict_buff);
+      // Allocation-free insert; returns the evicted line's block info by value
+      template <class BlockInfo>
+      BlockInfo insertSingleLine(IntPtr addr, CacheState::cstate_t cstate,
+            Byte* fill_buff, bool* eviction, IntPtr* evict_addr,
+            Byte* evict_buff, BlockInfo** inserted_block_info = NULL);
       CacheBlockInfo* peekSingleLine(IntPtr addr);
+      // Copy out of a line without touching the replacement state or the
+      // profiler; returns false if the line is not present
+      bool readSingleLine(IntPtr addr, Byte* buff, UInt32 bytes);
+      // Replacement update of a hit made through readSingleLine()
+      void touchSingleLine(IntPtr addr);
+
+      // Profile the stack distances of the references. The cache owns the profiler
+      void setStackDistanceProfiler(StackDistanceProfiler* stack_distance_profiler);
+      // Per-set statistics. The cache owns the heatmap
+      void setHeatmap(CacheHeatmap* heatmap);
+      bool hasHeatmap() { return (m_heatmap != NULL); }
+      bool hasStackDistanceProfiler() { return (m_stack_distance_profiler != NULL); }
 
       // Update Cache Counters
       void initializePerformanceCounters();
-      void updateCounters(bool cache_hit);
-      void enable() { m_enabled = true; }
-      void disable() { m_enabled = false; }
+      void updateCounters(IntPtr addr, bool cache_hit, bool lock_free = false);
+      void enable();
+      void disable();
       void reset(); 
 
+      // Warmed tag/state arrays. The geometry must match on load; the
+      // replacement state is restored only if the policy is the same
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader);
+
       virtual void outputSummary(ostream& out);
 };
 
+inline CacheBlockInfo*
+Cache::accessSingleLine(IntPtr addr, access_t access_type,
+      Byte* buff, UInt32 bytes)
+{
+   switch (m_policy)
+   {
+      case ROUND_ROBIN:
+         return accessSingleLineAs<CacheSetRoundRobin>(addr, access_type, buff, bytes);
+      case LRU:
+         return accessSingleLineAs<CacheSetLRU>(addr, access_type, buff, bytes);
+      case PLRU:
+         return accessSingleLineAs<CacheSetPLRU>(addr, access_type, buff, bytes);
+      case SRRIP:
+      case BRRIP:
+      case DRRIP:
+         return accessSingleLineAs<CacheSetRRIP>(addr, access_type, buff, bytes);
+      default:
+         return accessSingleLineAs<CacheSetRandom>(addr, access_type, buff, bytes);
+   }
+}
+
+template <class BlockInfo>
+BlockInfo
+Cache::insertSingleLine(IntPtr addr, CacheState::cstate_t cstate,
+      Byte* fill_buff, bool* eviction, IntPtr* evict_addr,
+      Byte* evict_buff, BlockInfo** inserted_block_info)
+{
+   switch (m_policy)
+   {
+      case ROUND_ROBIN:
+         return insertSingleLineAs<CacheSetRoundRobin, BlockInfo>(addr, cstate, fill_buff,
+               eviction, evict_addr, evict_buff, inserted_block_info);
+      case LRU:
+         return insertSingleLineAs<CacheSetLRU, BlockInfo>(addr, cstate, fill_buff,
+               eviction, evict_addr, evict_buff, inserted_block_info);
+      case PLRU:
+         return insertSingleLineAs<CacheSetPLRU, BlockInfo>(addr, cstate, fill_buff,
+               eviction, evict_addr, evict_buff, inserted_block_info);
+      case SRRIP:
+      case BRRIP:
+      case DRRIP:
+         return insertSingleLineAs<CacheSetRRIP, BlockInfo>(addr, cstate, fill_buff,
+               eviction, evict_addr, evict_buff, inserted_block_info);
+      default:
+         return insertSingleLineAs<CacheSetRandom, BlockInfo>(addr, cstate, fill_buff,
+               eviction, evict_addr, evict_buff, inserted_block_info);
+   }
+}
+
+template <class SetType>
+CacheBlockInfo*
+Cache::accessSingleLineAs(IntPtr addr, access_t access_type,
+      Byte* buff, UInt32 bytes)
+{
+   assert((buff == NULL) == (bytes == 0));
+
+   IntPtr tag;
+   UInt32 set_index;
+   UInt32 line_index = -1;
+   UInt32 block_offset;
+
+   splitAddress(addr, tag, set_index, block_offset);
+
+   SetType* set = static_cast<SetType*>(m_sets[set_index]);
+   CacheBlockInfo* cache_block_info = set->find(tag, &line_index);
+
+   if (cache_block_info == NULL)
+      return NULL;
+
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->access(addr);
+
+   if (access_type == LOAD)
+      set->readLineData(line_index, block_offset, buff, bytes);
+   else
+      set->writeLineData(line_index, block_offset, buff, bytes);
+   set->SetType::updateReplacementIndex(line_index);
+
+   return cache_block_info;
+}
+
+template <class SetType, class BlockInfo>
+BlockInfo
+Cache::insertSingleLineAs(IntPtr addr, CacheState::cstate_t cstate,
+      Byte* fill_buff, bool* eviction, IntPtr* evict_addr,
+      Byte* evict_buff, BlockInfo** inserted_block_info)
+{
+   IntPtr tag;
+   UInt32 set_index;
+   UInt32 line_index;
+   splitAddress(addr, tag, set_index);
+
+   SetType* set = static_cast<SetType*>(m_sets[set_index]);
+   BlockInfo evict_block_info = set->template insertInPlace<SetType, BlockInfo>(tag, cstate, fill_buff,
+         eviction, evict_buff, &line_index);
+   *evict_addr = INVALID_ADDRESS;
+   if (*eviction)
+   {
+      *evict_addr = tagToAddress(evict_block_info.getTag());
+      if (m_enabled)
+         m_num_evicts ++;
+      if (m_heatmap != NULL)
+         m_heatmap->evict(set_index);
+   }
+
+   if (m_stack_distance_profiler != NULL)
+      m_stack_distance_profiler->fill(addr);
+
+   if (inserted_block_info != NULL)
+      *inserted_block_info = static_cast<BlockInfo*>(set->getBlockInfo(line_index));
+   return evict_block_info;
+}
+
 template <class T>
 UInt32 moduloHashFn(T key, UInt32 hash_fn_param, UInt32 num_buckets)
 {
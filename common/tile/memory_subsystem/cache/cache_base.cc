@@ -1,5 +1,6 @@
 #include "cache_base.h"
 #include "utils.h"
+#include "log.h"
 
 using namespace std;
 
@@ -11,29 +12,13 @@ CacheBase::CacheBase(string name, UInt32 cache_size, UInt32 associativity, UInt3
 {
    m_num_sets = m_cache_size / (m_associativity * m_blocksize);
    m_log_blocksize = floorLog2(m_blocksize);
+
+   // Addresses are split with shifts and masks
+   LOG_ASSERT_ERROR(isPower2(m_blocksize) && isPower2(m_num_sets),
+         "Cache %s: block size(%u) and number of sets(%u) must be powers of 2",
+         m_name.c_str(), m_blocksize, m_num_sets);
+   m_set_index_mask = m_num_sets - 1;
 }
 
 CacheBase::~CacheBase() 
 {}
-
-// utilities
-void 
-CacheBase::splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index) const
-{
-   tag = addr >> m_log_blocksize;
-   set_index = tag & (m_num_sets-1);
-}
-
-void 
-CacheBase::splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index,
-                  UInt32& block_offset) const
-{
-   block_offset = addr & (m_blocksize-1);
-   splitAddress(addr, tag, set_index);
-}
-
-IntPtr
-CacheBase::tagToAddress(const IntPtr tag)
-{
-   return tag << m_log_blocksize;
-}
@@ -41,6 +41,11 @@ class CacheBase
       {
          ROUND_ROBIN = 0,
          LRU,
+         PLRU,
+         SRRIP,
+         BRRIP,
+         DRRIP,
+         RANDOM,
          NUM_REPLACEMENT_POLICIES
       };
 
@@ -54,16 +59,29 @@ class CacheBase
 
       // computed params
       UInt32 m_log_blocksize;
+      UInt32 m_set_index_mask;
 
    public:
       // constructors/destructors
       CacheBase(std::string name, UInt32 cache_size, UInt32 associativity, UInt32 cache_block_size);
       virtual ~CacheBase();
 
-      // utilities
-      void splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index) const;
-      void splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index, UInt32& block_offset) const;
-      IntPtr tagToAddress(const IntPtr tag);
+      // utilities (inline: on the path of every cache lookup)
+      void splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index) const
+      {
+         tag = addr >> m_log_blocksize;
+         set_index = tag & m_set_index_mask;
+      }
+      void splitAddress(const IntPtr addr, IntPtr& tag, UInt32& set_index, UInt32& block_offset) const
+      {
+         block_offset = addr & (m_blocksize-1);
+         splitAddress(addr, tag, set_index);
+      }
+      IntPtr tagToAddress(const IntPtr tag) const { return tag << m_log_blocksize; }
+
+      std::string getName() const { return m_name; }
+      UInt32 getNumSets() const { return m_num_sets; }
+      UInt32 getAssociativity() const { return m_associativity; }
       
       // Output Summary
       virtual void outputSummary(ostream& out) {}
@@ -28,6 +28,54 @@ CacheBlockInfo::create(CacheBase::cache_t cache_type)
    }
 }
 
+void
+CacheBlockInfo::createArray(CacheBase::cache_t cache_type, UInt32 num_blocks,
+      CacheBlockInfo** cache_block_info_array)
+{
+   switch (cache_type)
+   {
+      case CacheBase::PR_L1_CACHE:
+         {
+            PrL1CacheBlockInfo* block_info_array = new PrL1CacheBlockInfo[num_blocks];
+            for (UInt32 i = 0; i < num_blocks; i++)
+               cache_block_info_array[i] = &block_info_array[i];
+         }
+         break;
+
+      case CacheBase::PR_L2_CACHE:
+         {
+            PrL2CacheBlockInfo* block_info_array = new PrL2CacheBlockInfo[num_blocks];
+            for (UInt32 i = 0; i < num_blocks; i++)
+               cache_block_info_array[i] = &block_info_array[i];
+         }
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized cache type (%u)", cache_type);
+         break;
+   }
+}
+
+void
+CacheBlockInfo::destroyArray(CacheBase::cache_t cache_type,
+      CacheBlockInfo** cache_block_info_array)
+{
+   switch (cache_type)
+   {
+      case CacheBase::PR_L1_CACHE:
+         delete [] static_cast<PrL1CacheBlockInfo*>(cache_block_info_array[0]);
+         break;
+
+      case CacheBase::PR_L2_CACHE:
+         delete [] static_cast<PrL2CacheBlockInfo*>(cache_block_info_array[0]);
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized cache type (%u)", cache_type);
+         break;
+   }
+}
+
 void
 CacheBlockInfo::invalidate()
 {
@@ -41,3 +89,17 @@ CacheBlockInfo::clone(CacheBlockInfo* cache_block_info)
    m_tag = cache_block_info->getTag();
    m_cstate = cache_block_info->getCState();
 }
+
+void
+CacheBlockInfo::saveSnapshot(SnapshotWriter& writer)
+{
+   writer.write<IntPtr>(m_tag);
+   writer.write<UInt32>(m_cstate);
+}
+
+void
+CacheBlockInfo::loadSnapshot(SnapshotReader& reader)
+{
+   m_tag = reader.read<IntPtr>();
+   m_cstate = (CacheState::cstate_t) reader.read<UInt32>();
+}
@@ -4,6 +4,7 @@
 #include "fixed_types.h"
 #include "cache_state.h"
 #include "cache_base.h"
+#include "snapshot.h"
 
 class CacheBlockInfo
 {
@@ -19,10 +20,18 @@ class CacheBlockInfo
       virtual ~CacheBlockInfo();
 
       static CacheBlockInfo* create(CacheBase::cache_t cache_type);
+      // Allocate 'num_blocks' block infos contiguously (one per way of a set)
+      static void createArray(CacheBase::cache_t cache_type, UInt32 num_blocks,
+            CacheBlockInfo** cache_block_info_array);
+      static void destroyArray(CacheBase::cache_t cache_type,
+            CacheBlockInfo** cache_block_info_array);
 
       virtual void invalidate(void);
       virtual void clone(CacheBlockInfo* cache_block_info);
 
+      virtual void saveSnapshot(SnapshotWriter& writer);
+      virtual void loadSnapshot(SnapshotReader& reader);
+
       bool isValid() const { return (m_tag != ((IntPtr) ~0)); }
       
       IntPtr getTag() const { return m_tag; }
@@ -0,0 +1,221 @@
+#include <fstream>
+#include <algorithm>
+#include <cassert>
+#include <string.h>
+
+#include "cache_heatmap.h"
+#include "utils.h"
+#include "log.h"
+
+CacheHeatmap::CacheHeatmap(std::string filename, UInt32 num_sets, UInt32 associativity, UInt32 cache_block_size):
+   m_filename(filename),
+   m_num_sets(num_sets),
+   m_num_lines(num_sets * associativity),
+   m_log_cache_block_size(floorLog2(cache_block_size)),
+   m_enabled(false),
+   m_set_counters(num_sets),
+   m_shadow_lines(m_num_lines),
+   m_shadow_head(NO_LINE),
+   m_shadow_tail(NO_LINE),
+   m_num_shadow_lines(0),
+   m_shadow_tags(ceilLog2(m_num_lines) + 1)
+{
+   // At least a word per bitmap
+   m_log_bitmap_bits = std::max(ceilLog2(m_num_lines * BITMAP_BITS_PER_LINE), (SInt32) 6);
+   m_referenced_blocks.resize((1 << m_log_bitmap_bits) / 64, 0);
+   m_invalidated_blocks.resize((1 << m_log_bitmap_bits) / 64, 0);
+
+   reset();
+}
+
+CacheHeatmap::~CacheHeatmap()
+{}
+
+void
+CacheHeatmap::reset()
+{
+   // The shadow tag store and the referenced blocks are kept so that a
+   // reset after warm-up does not count every block as a compulsory miss
+   memset(&m_set_counters[0], 0, m_num_sets * sizeof(SetCounters));
+}
+
+void
+CacheHeatmap::access(UInt32 set_index, IntPtr address, bool cache_hit, bool tag_present)
+{
+   assert(set_index < m_num_sets);
+   IntPtr block = address >> m_log_cache_block_size;
+
+   if (m_enabled)
+   {
+      if (cache_hit)
+         m_set_counters[set_index].hits ++;
+      else
+         m_set_counters[set_index].misses[classifyMiss(block, tag_present)] ++;
+   }
+
+   UInt32 bit_index = getBitIndex(block);
+   setBit(m_referenced_blocks, bit_index);
+   clearBit(m_invalidated_blocks, bit_index);
+   touchShadow(block);
+}
+
+void
+CacheHeatmap::evict(UInt32 set_index)
+{
+   assert(set_index < m_num_sets);
+   if (m_enabled)
+      m_set_counters[set_index].evictions ++;
+}
+
+void
+CacheHeatmap::invalidate(IntPtr address)
+{
+   IntPtr block = address >> m_log_cache_block_size;
+   setBit(m_invalidated_blocks, getBitIndex(block));
+
+   // The block leaves the fully-associative cache too. Its line moves to
+   // the tail, where the next new block takes it
+   UInt32* line = m_shadow_tags.find(block);
+   if (line != NULL)
+   {
+      UInt32 free_line = *line;
+      m_shadow_tags.erase(block);
+      unlinkShadowLine(free_line);
+      m_shadow_lines[free_line].block = INVALID_ADDRESS;
+      m_shadow_lines[free_line].prev = m_shadow_tail;
+      m_shadow_lines[free_line].next = NO_LINE;
+      if (m_shadow_tail != NO_LINE)
+         m_shadow_lines[m_shadow_tail].next = free_line;
+      else
+         m_shadow_head = free_line;
+      m_shadow_tail = free_line;
+   }
+}
+
+CacheHeatmap::miss_type_t
+CacheHeatmap::classifyMiss(IntPtr block, bool tag_present)
+{
+   UInt32 bit_index = getBitIndex(block);
+   if (tag_present || testBit(m_invalidated_blocks, bit_index))
+      return COHERENCE;
+   if (!testBit(m_referenced_blocks, bit_index))
+      return COMPULSORY;
+   if (m_shadow_tags.find(block) != NULL)
+      return CONFLICT;
+   return CAPACITY;
+}
+
+void
+CacheHeatmap::unlinkShadowLine(UInt32 line)
+{
+   ShadowLine& shadow_line = m_shadow_lines[line];
+   if (shadow_line.prev != NO_LINE)
+      m_shadow_lines[shadow_line.prev].next = shadow_line.next;
+   else
+      m_shadow_head = shadow_line.next;
+   if (shadow_line.next != NO_LINE)
+      m_shadow_lines[shadow_line.next].prev = shadow_line.prev;
+   else
+      m_shadow_tail = shadow_line.prev;
+}
+
+void
+CacheHeatmap::linkShadowLineAtHead(UInt32 line)
+{
+   m_shadow_lines[line].prev = NO_LINE;
+   m_shadow_lines[line].next = m_shadow_head;
+   if (m_shadow_head != NO_LINE)
+      m_shadow_lines[m_shadow_head].prev = line;
+   else
+      m_shadow_tail = line;
+   m_shadow_head = line;
+}
+
+void
+CacheHeatmap::touchShadow(IntPtr block)
+{
+   UInt32* line = m_shadow_tags.find(block);
+   if (line != NULL)
+   {
+      UInt32 hit_line = *line;
+      unlinkShadowLine(hit_line);
+      linkShadowLineAtHead(hit_line);
+      return;
+   }
+
+   // A line never used yet, else the tail (least recent, or freed by an
+   // invalidation)
+   UInt32 new_line;
+   if (m_num_shadow_lines < m_num_lines)
+   {
+      new_line = m_num_shadow_lines ++;
+   }
+   else
+   {
+      new_line = m_shadow_tail;
+      unlinkShadowLine(new_line);
+      if (m_shadow_lines[new_line].block != INVALID_ADDRESS)
+         m_shadow_tags.erase(m_shadow_lines[new_line].block);
+   }
+
+   m_shadow_lines[new_line].block = block;
+   linkShadowLineAtHead(new_line);
+   m_shadow_tags[block] = new_line;
+}
+
+void
+CacheHeatmap::outputSummary(std::ostream& out)
+{
+   UInt64 total_misses[NUM_MISS_TYPES] = {0};
+   UInt64 total_set_misses = 0;
+   UInt64 hottest_set_misses = 0;
+   UInt32 hottest_set = 0;
+
+   for (UInt32 i = 0; i < m_num_sets; i++)
+   {
+      UInt64 set_misses = 0;
+      for (UInt32 t = 0; t < NUM_MISS_TYPES; t++)
+      {
+         total_misses[t] += m_set_counters[i].misses[t];
+         set_misses += m_set_counters[i].misses[t];
+      }
+      total_set_misses += set_misses;
+      if (set_misses > hottest_set_misses)
+      {
+         hottest_set_misses = set_misses;
+         hottest_set = i;
+      }
+   }
+
+   out << "    compulsory misses: " << total_misses[COMPULSORY] << std::endl;
+   out << "    capacity misses: " << total_misses[CAPACITY] << std::endl;
+   out << "    conflict misses: " << total_misses[CONFLICT] << std::endl;
+   out << "    coherence misses: " << total_misses[COHERENCE] << std::endl;
+   out << "    hottest set: " << hottest_set << std::endl;
+   // Misses of the hottest set relative to the mean set (1 when evenly spread)
+   out << "    hottest set miss ratio: " <<
+      ((total_set_misses == 0) ? 0.0 : ((float) hottest_set_misses * m_num_sets) / total_set_misses) << std::endl;
+
+   writeCSV();
+}
+
+void
+CacheHeatmap::writeCSV()
+{
+   std::ofstream csv(m_filename.c_str());
+   if (!csv)
+   {
+      LOG_PRINT_WARNING("Could not write cache heatmap(%s)", m_filename.c_str());
+      return;
+   }
+
+   csv << "set,hits,compulsory,capacity,conflict,coherence,evictions" << std::endl;
+   for (UInt32 i = 0; i < m_num_sets; i++)
+   {
+      const SetCounters& counters = m_set_counters[i];
+      csv << i << "," << counters.hits << ","
+          << counters.misses[COMPULSORY] << "," << counters.misses[CAPACITY] << ","
+          << counters.misses[CONFLICT] << "," << counters.misses[COHERENCE] << ","
+          << counters.evictions << std::endl;
+   }
+}
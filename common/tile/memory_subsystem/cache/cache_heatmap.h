@@ -0,0 +1,104 @@
+#ifndef __CACHE_HEATMAP_H__
+#define __CACHE_HEATMAP_H__
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "fixed_types.h"
+#include "address_hash_map.h"
+
+// Per-set hits, misses and evictions of a cache, with every miss classified
+//    compulsory: first reference to the block
+//    coherence:  the block was invalidated, or is present without the permission needed
+//    conflict:   a fully-associative LRU cache of the same size would have hit
+//    capacity:   everything else
+// The fully-associative cache is a shadow tag store fed with the same
+// references. The per-set counters are written to a CSV file with the summary.
+// The state is bounded by the size of the cache: the shadow tag store has
+// one preallocated entry per line, and the referenced and invalidated blocks
+// are hashed bitmaps of BITMAP_BITS_PER_LINE bits per line. A footprint much
+// larger than that makes the bitmaps alias, so some compulsory misses count
+// as capacity or conflict misses, and some coherence misses as others
+class CacheHeatmap
+{
+   public:
+      enum miss_type_t
+      {
+         COMPULSORY = 0,
+         CAPACITY,
+         CONFLICT,
+         COHERENCE,
+         NUM_MISS_TYPES
+      };
+
+      CacheHeatmap(std::string filename, UInt32 num_sets, UInt32 associativity, UInt32 cache_block_size);
+      ~CacheHeatmap();
+
+      // 'tag_present' tells a permission (upgrade) miss from a miss on an absent block
+      void access(UInt32 set_index, IntPtr address, bool cache_hit, bool tag_present);
+      void evict(UInt32 set_index);
+      void invalidate(IntPtr address);
+
+      void enable() { m_enabled = true; }
+      void disable() { m_enabled = false; }
+      void reset();
+
+      void outputSummary(std::ostream& out);
+
+   private:
+      struct SetCounters
+      {
+         UInt64 hits;
+         UInt64 misses[NUM_MISS_TYPES];
+         UInt64 evictions;
+      };
+
+      std::string m_filename;
+      UInt32 m_num_sets;
+      UInt32 m_num_lines;
+      UInt32 m_log_cache_block_size;
+      bool m_enabled;
+
+      std::vector<SetCounters> m_set_counters;
+
+      // Shadow fully-associative LRU tag store: a list of lines linked by
+      // index (most recent at the head), and the line of each block
+      struct ShadowLine
+      {
+         IntPtr block;
+         UInt32 prev;
+         UInt32 next;
+      };
+      static const UInt32 NO_LINE = ~((UInt32) 0);
+
+      std::vector<ShadowLine> m_shadow_lines;
+      UInt32 m_shadow_head;
+      UInt32 m_shadow_tail;
+      UInt32 m_num_shadow_lines;
+      AddressHashMap<UInt32> m_shadow_tags;
+
+      static const UInt32 BITMAP_BITS_PER_LINE = 64;
+
+      UInt32 m_log_bitmap_bits;
+      std::vector<UInt64> m_referenced_blocks;
+      std::vector<UInt64> m_invalidated_blocks;
+
+      miss_type_t classifyMiss(IntPtr block, bool tag_present);
+      void touchShadow(IntPtr block);
+      void unlinkShadowLine(UInt32 line);
+      void linkShadowLineAtHead(UInt32 line);
+
+      UInt32 getBitIndex(IntPtr block)
+      { return (UInt32) ((((UInt64) block) * 0x9e3779b97f4a7c15ULL) >> (64 - m_log_bitmap_bits)); }
+      static bool testBit(const std::vector<UInt64>& bitmap, UInt32 index)
+      { return (bitmap[index >> 6] >> (index & 63)) & 1; }
+      static void setBit(std::vector<UInt64>& bitmap, UInt32 index)
+      { bitmap[index >> 6] |= (((UInt64) 1) << (index & 63)); }
+      static void clearBit(std::vector<UInt64>& bitmap, UInt32 index)
+      { bitmap[index >> 6] &= ~(((UInt64) 1) << (index & 63)); }
+
+      void writeCSV();
+};
+
+#endif /* __CACHE_HEATMAP_H__ */
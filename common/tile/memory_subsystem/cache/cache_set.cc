@@ -1,125 +1,205 @@
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "cache_set.h"
 #include "cache_base.h"
 #include "log.h"
 
 CacheSet::CacheSet(CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize):
-      m_associativity(associativity), m_blocksize(blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled):
+      m_blocks(NULL), m_cache_type(cache_type), m_associativity(associativity), m_blocksize(blocksize)
 {
+   // Padding slots hold INVALID_TAG and never match a lookup
+   m_num_tag_slots = ((m_associativity + TAG_SLOT_ALIGNMENT - 1) / TAG_SLOT_ALIGNMENT) * TAG_SLOT_ALIGNMENT;
+   m_tags = new IntPtr[m_num_tag_slots];
+   for (UInt32 i = 0; i < m_num_tag_slots; i++)
+      m_tags[i] = INVALID_TAG;
+
    m_cache_block_info_array = new CacheBlockInfo*[m_associativity];
-   for (UInt32 i = 0; i < m_associativity; i++)
+   CacheBlockInfo::createArray(cache_type, m_associativity, m_cache_block_info_array);
+
+   if (data_storage_enabled)
    {
-      m_cache_block_info_array[i] = CacheBlockInfo::create(cache_type);
+      m_blocks = new char[m_associativity * m_blocksize];
+      memset(m_blocks, 0x00, m_associativity * m_blocksize);
    }
-   m_blocks = new char[m_associativity * m_blocksize];
-   
-   memset(m_blocks, 0x00, m_associativity * m_blocksize);
 }
 
 CacheSet::~CacheSet()
 {
-   for (UInt32 i = 0; i < m_associativity; i++)
-      delete m_cache_block_info_array[i];
+   CacheBlockInfo::destroyArray(m_cache_type, m_cache_block_info_array);
    delete [] m_cache_block_info_array;
+   delete [] m_tags;
    delete [] m_blocks;
 }
 
-void 
-CacheSet::read_line(UInt32 line_index, UInt32 offset, Byte *out_buff, UInt32 bytes)
+// Returns the index of the way holding 'tag' (highest index first, as
+// the scalar loop used to do), or -1 if the tag is not present
+SInt32
+CacheSet::getTagIndex(IntPtr tag)
 {
-   assert(offset + bytes <= m_blocksize);
-   assert((out_buff == NULL) == (bytes == 0));
-
-   if (out_buff != NULL)
-      memcpy((void*) out_buff, &m_blocks[line_index * m_blocksize + offset], bytes);
+   assert(tag != INVALID_TAG);
 
-   updateReplacementIndex(line_index);
+#if defined(__AVX2__) && defined(__x86_64__)
+   const __m256i key = _mm256_set1_epi64x((long long) tag);
+   for (SInt32 base = m_num_tag_slots - 4; base >= 0; base -= 4)
+   {
+      __m256i tags = _mm256_loadu_si256((const __m256i*) &m_tags[base]);
+      UInt32 mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(tags, key)));
+      if (mask)
+         return base + (31 - __builtin_clz(mask));
+   }
+   return -1;
+#elif defined(__AVX2__)
+   const __m256i key = _mm256_set1_epi32((int) tag);
+   for (SInt32 base = m_num_tag_slots - 8; base >= 0; base -= 8)
+   {
+      __m256i tags = _mm256_loadu_si256((const __m256i*) &m_tags[base]);
+      UInt32 mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(tags, key)));
+      if (mask)
+         return base + (31 - __builtin_clz(mask));
+   }
+   return -1;
+#elif defined(__SSE4_1__) && defined(__x86_64__)
+   const __m128i key = _mm_set1_epi64x((long long) tag);
+   for (SInt32 base = m_num_tag_slots - 2; base >= 0; base -= 2)
+   {
+      __m128i tags = _mm_loadu_si128((const __m128i*) &m_tags[base]);
+      UInt32 mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(tags, key)));
+      if (mask)
+         return base + (31 - __builtin_clz(mask));
+   }
+   return -1;
+#elif defined(__SSE2__) && defined(__x86_64__)
+   // No 64-bit compare in SSE2: compare the 32-bit halves and require
+   // both halves of a lane to match
+   const __m128i key = _mm_set1_epi64x((long long) tag);
+   for (SInt32 base = m_num_tag_slots - 2; base >= 0; base -= 2)
+   {
+      __m128i tags = _mm_loadu_si128((const __m128i*) &m_tags[base]);
+      __m128i eq32 = _mm_cmpeq_epi32(tags, key);
+      __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2,3,0,1)));
+      UInt32 mask = _mm_movemask_pd(_mm_castsi128_pd(eq64));
+      if (mask)
+         return base + (31 - __builtin_clz(mask));
+   }
+   return -1;
+#elif defined(__SSE2__)
+   const __m128i key = _mm_set1_epi32((int) tag);
+   for (SInt32 base = m_num_tag_slots - 4; base >= 0; base -= 4)
+   {
+      __m128i tags = _mm_loadu_si128((const __m128i*) &m_tags[base]);
+      UInt32 mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tags, key)));
+      if (mask)
+         return base + (31 - __builtin_clz(mask));
+   }
+   return -1;
+#else
+   for (SInt32 index = m_associativity-1; index >= 0; index--)
+   {
+      if (m_tags[index] == tag)
+         return index;
+   }
+   return -1;
+#endif
 }
 
-void 
-CacheSet::write_line(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 bytes)
+SInt32
+CacheSet::getInvalidIndex()
 {
-   assert(offset + bytes <= m_blocksize);
-   assert((in_buff == NULL) == (bytes == 0));
-
-   if (in_buff != NULL)
-      memcpy(&m_blocks[line_index * m_blocksize + offset], (void*) in_buff, bytes);
-
-   updateReplacementIndex(line_index);
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      if (!isValidLine(i))
+         return i;
+   }
+   return -1;
 }
 
 CacheBlockInfo* 
 CacheSet::find(IntPtr tag, UInt32* line_index)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
-   {
-      if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         if (line_index != NULL)
-            *line_index = index;
-         return (m_cache_block_info_array[index]);
-      }
-   }
-   return NULL;
+   SInt32 index = getTagIndex(tag);
+   if (index < 0)
+      return NULL;
+
+   assert(index < (SInt32) m_associativity);
+   if (line_index != NULL)
+      *line_index = index;
+   return (m_cache_block_info_array[index]);
 }
 
 bool 
 CacheSet::invalidate(IntPtr& tag)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
-   {
-      if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         m_cache_block_info_array[index]->invalidate();
-         return true;
-      }
-   }
-   return false;
+   SInt32 index = getTagIndex(tag);
+   if (index < 0)
+      return false;
+
+   assert(index < (SInt32) m_associativity);
+   m_cache_block_info_array[index]->invalidate();
+   m_tags[index] = INVALID_TAG;
+   return true;
 }
 
-void 
-CacheSet::insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* eviction, CacheBlockInfo* evict_block_info, Byte* evict_buff)
+void
+CacheSet::saveSnapshot(SnapshotWriter& writer)
 {
-   // This replacement strategy does not take into account the fact that
-   // cache blocks can be voluntarily flushed or invalidated due to another write request
-   const UInt32 index = getReplacementIndex();
-   assert(index < m_associativity);
-
-   assert(eviction != NULL);
-         
-   if (m_cache_block_info_array[index]->isValid())
+   for (UInt32 i = 0; i < m_associativity; i++)
+      m_cache_block_info_array[i]->saveSnapshot(writer);
+
+   if (m_blocks != NULL)
+      writer.writeBytes(m_blocks, m_associativity * m_blocksize);
+}
+
+void
+CacheSet::loadSnapshot(SnapshotReader& reader, bool snapshot_has_data)
+{
+   for (UInt32 i = 0; i < m_associativity; i++)
    {
-      *eviction = true;
-      // FIXME: This is a hack. I dont know if this is the best way to do
-      evict_block_info->clone(m_cache_block_info_array[index]);
-      if (evict_buff != NULL)
-         memcpy((void*) evict_buff, &m_blocks[index * m_blocksize], m_blocksize);
+      m_cache_block_info_array[i]->loadSnapshot(reader);
+      m_tags[i] = m_cache_block_info_array[i]->getTag();
    }
-   else
+
+   if (snapshot_has_data)
    {
-      *eviction = false;
+      if (m_blocks != NULL)
+         reader.readBytes(m_blocks, m_associativity * m_blocksize);
+      else
+         reader.skip(m_associativity * m_blocksize);
    }
-
-   // FIXME: This is a hack. I dont know if this is the best way to do
-   m_cache_block_info_array[index]->clone(cache_block_info);
-   
-   if (fill_buff != NULL)
-      memcpy(&m_blocks[index * m_blocksize], (void*) fill_buff, m_blocksize);
 }
 
 CacheSet* 
 CacheSet::createCacheSet (std::string replacement_policy,
       CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+      UInt32 set_index, SetDuelingMonitor* set_dueling_monitor)
 {
    CacheBase::ReplacementPolicy policy = parsePolicyType(replacement_policy);
    switch(policy)
    {
       case CacheBase::ROUND_ROBIN:
-         return new CacheSetRoundRobin(cache_type, associativity, blocksize);
+         return new CacheSetRoundRobin(cache_type, associativity, blocksize, data_storage_enabled);
 
       case CacheBase::LRU:
-         return new CacheSetLRU(cache_type, associativity, blocksize);
+         return new CacheSetLRU(cache_type, associativity, blocksize, data_storage_enabled);
+
+      case CacheBase::PLRU:
+         return new CacheSetPLRU(cache_type, associativity, blocksize, data_storage_enabled);
+
+      case CacheBase::SRRIP:
+      case CacheBase::BRRIP:
+      case CacheBase::DRRIP:
+         return new CacheSetRRIP(cache_type, associativity, blocksize, data_storage_enabled,
+               policy, set_index, set_dueling_monitor);
+
+      case CacheBase::RANDOM:
+         return new CacheSetRandom(cache_type, associativity, blocksize, data_storage_enabled, set_index);
 
       default:
          LOG_PRINT_ERROR("Unrecognized Cache Replacement Policy: %i",
@@ -137,6 +217,16 @@ CacheSet::parsePolicyType(string policy)
       return CacheBase::ROUND_ROBIN;
    if (policy == "lru")
       return CacheBase::LRU;
+   if (policy == "plru")
+      return CacheBase::PLRU;
+   if (policy == "srrip")
+      return CacheBase::SRRIP;
+   if (policy == "brrip")
+      return CacheBase::BRRIP;
+   if (policy == "drrip")
+      return CacheBase::DRRIP;
+   if (policy == "random")
+      return CacheBase::RANDOM;
    else
       return (CacheBase::ReplacementPolicy) -1;
 }
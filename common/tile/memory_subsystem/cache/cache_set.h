@@ -2,55 +2,105 @@
 #define CACHE_SET_H
 
 #include <string.h>
+#include <cassert>
 
 #include "fixed_types.h"
 #include "cache_block_info.h"
+#include "cache_state.h"
 #include "cache_base.h"
+#include "random.h"
+#include "snapshot.h"
+
+class SetDuelingMonitor;
 
 // Everything related to cache sets
 class CacheSet
 {
    public:
       
-      static CacheSet* createCacheSet(std::string replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize);
+      static CacheSet* createCacheSet(std::string replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+            UInt32 set_index, SetDuelingMonitor* set_dueling_monitor);
       static CacheBase::ReplacementPolicy parsePolicyType(std::string policy);
 
    protected:
+      // Tags of all the ways are kept in one contiguous array (padded to a
+      // multiple of the widest vector width) so that a lookup can compare
+      // all the ways at once. The block infos themselves (state and the
+      // protocol-specific fields) live in a contiguous side array.
+      IntPtr* m_tags;
+      UInt32 m_num_tag_slots;
       CacheBlockInfo** m_cache_block_info_array;
+      // NULL in tag-only mode, where only tags and state are modeled
       char* m_blocks;
+      CacheBase::cache_t m_cache_type;
       UInt32 m_associativity;
       UInt32 m_blocksize;
 
+      bool isValidLine(UInt32 line_index) { return (m_tags[line_index] != INVALID_TAG); }
+      // Lowest invalid way, or -1 if all the ways are valid
+      SInt32 getInvalidIndex();
+
+   private:
+      static const IntPtr INVALID_TAG = ~((IntPtr) 0);
+      static const UInt32 TAG_SLOT_ALIGNMENT = 8;
+
+      SInt32 getTagIndex(IntPtr tag);
+
    public:
 
       CacheSet(CacheBase::cache_t cache_type,
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled);
       virtual ~CacheSet();
 
       UInt32 getBlockSize() { return m_blocksize; }
 
       UInt32 getAssociativity() { return m_associativity; }
 
-      void read_line(UInt32 line_index, UInt32 offset, Byte *out_buff, UInt32 bytes);
-      void write_line(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 bytes);
+      CacheBlockInfo* getBlockInfo(UInt32 line_index) { return m_cache_block_info_array[line_index]; }
+
+      // Data copies only; the caller updates the replacement state
+      void readLineData(UInt32 line_index, UInt32 offset, Byte *out_buff, UInt32 bytes);
+      void writeLineData(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 bytes);
       CacheBlockInfo* find(IntPtr tag, UInt32* line_index = NULL);
       bool invalidate(IntPtr& tag);
-      void insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* eviction, CacheBlockInfo* evict_block_info, Byte* evict_buff);
+      // Writes the tag and state straight into the victim way. The evicted
+      // line's metadata is returned by value (invalid if there was no eviction).
+      // SetType is the concrete class of the set, which picks the victim
+      template <class SetType, class BlockInfo>
+      BlockInfo insertInPlace(IntPtr tag, CacheState::cstate_t cstate, Byte* fill_buff,
+            bool* eviction, Byte* evict_buff, UInt32* line_index = NULL);
+
+      // The replacement policy is not virtual: every policy class defines
+      //    UInt32 getReplacementIndex();
+      //    void updateReplacementIndex(UInt32 accessed_index);   (inline)
+      // and may hide the defaults below. The callers (Cache) know the
+      // concrete class of the set and bind the calls at compile time
+
+      // Called when a new line is filled into 'inserted_index'. LRU and
+      // round robin leave the state alone until the line is first accessed
+      void updateReplacementIndexOnInsert(UInt32 inserted_index) {}
 
-      virtual UInt32 getReplacementIndex() = 0;
-      virtual void updateReplacementIndex(UInt32) = 0;
+      // Tags, block infos and (if both the snapshot and the set have it) data
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader, bool snapshot_has_data);
+      // Policy-specific replacement state. Random replacement has none
+      void saveReplacementState(SnapshotWriter& writer) {}
+      void loadReplacementState(SnapshotReader& reader) {}
 };
 
 class CacheSetRoundRobin : public CacheSet
 {
    public:
       CacheSetRoundRobin(CacheBase::cache_t cache_type, 
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled);
       ~CacheSetRoundRobin();
 
       UInt32 getReplacementIndex();
       void updateReplacementIndex(UInt32 accessed_index);
 
+      void saveReplacementState(SnapshotWriter& writer);
+      void loadReplacementState(SnapshotReader& reader);
+
    private:
       UInt32 m_replacement_index;
 };
@@ -59,15 +109,234 @@ class CacheSetLRU : public CacheSet
 {
    public:
       CacheSetLRU(CacheBase::cache_t cache_type,
-            UInt32 associativity, UInt32 blocksize);
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled);
       ~CacheSetLRU();
 
       UInt32 getReplacementIndex();
       void updateReplacementIndex(UInt32 accessed_index);
 
+      void saveReplacementState(SnapshotWriter& writer);
+      void loadReplacementState(SnapshotReader& reader);
+
    private:
       UInt8* m_lru_bits;
 };
 
+// Tree pseudo-LRU: (associativity - 1) node bits packed into one word.
+// Each node bit points to the half of its subtree that holds the victim
+class CacheSetPLRU : public CacheSet
+{
+   public:
+      CacheSetPLRU(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled);
+      ~CacheSetPLRU();
+
+      UInt32 getReplacementIndex();
+      void updateReplacementIndex(UInt32 accessed_index);
+      void updateReplacementIndexOnInsert(UInt32 inserted_index);
+
+      void saveReplacementState(SnapshotWriter& writer);
+      void loadReplacementState(SnapshotReader& reader);
+
+   private:
+      static const UInt32 MAX_ASSOCIATIVITY = 64;
+
+      UInt64 m_plru_bits;
+};
+
+// Set dueling (Qureshi et al., ISCA 2007): a few leader sets always use
+// policy A or policy B, and a saturating counter of their misses decides
+// which policy the remaining (follower) sets use. One monitor is shared by
+// all the sets of a cache
+class SetDuelingMonitor
+{
+   public:
+      enum role_t
+      {
+         FOLLOWER = 0,
+         LEADER_A,
+         LEADER_B
+      };
+
+      SetDuelingMonitor(UInt32 num_sets);
+      ~SetDuelingMonitor();
+
+      role_t getRole(UInt32 set_index);
+      void recordMiss(role_t role);
+      bool usePolicyB(role_t role);
+
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader);
+
+   private:
+      static const UInt32 PSEL_BITS = 10;
+      static const UInt32 NUM_LEADER_SETS = 32;
+
+      UInt32 m_constituency_size;
+      UInt32 m_psel;
+};
+
+// Re-Reference Interval Prediction (Jaleel et al., ISCA 2010).
+// 2-bit re-reference prediction values (RRPVs) packed 32 ways to a word,
+// so that the victim search and the aging step work on whole words.
+//    SRRIP: insert with a long re-reference interval
+//    BRRIP: insert with a distant interval, long once every BIMODAL_THROTTLE fills
+//    DRRIP: choose between the two by set dueling
+class CacheSetRRIP : public CacheSet
+{
+   public:
+      CacheSetRRIP(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+            CacheBase::ReplacementPolicy policy,
+            UInt32 set_index, SetDuelingMonitor* set_dueling_monitor);
+      ~CacheSetRRIP();
+
+      UInt32 getReplacementIndex();
+      void updateReplacementIndex(UInt32 accessed_index);
+      void updateReplacementIndexOnInsert(UInt32 inserted_index);
+
+      void saveReplacementState(SnapshotWriter& writer);
+      void loadReplacementState(SnapshotReader& reader);
+
+   private:
+      static const UInt32 RRPV_BITS = 2;
+      static const UInt64 MAX_RRPV = 3;
+      static const UInt32 WAYS_PER_WORD = 64 / RRPV_BITS;
+      static const UInt32 BIMODAL_THROTTLE = 32;
+
+      CacheBase::ReplacementPolicy m_policy;
+      SetDuelingMonitor* m_set_dueling_monitor;
+      SetDuelingMonitor::role_t m_set_dueling_role;
+
+      UInt64* m_rrpv_words;
+      UInt32 m_num_rrpv_words;
+      UInt32 m_bimodal_count;
+
+      // Mask with the low bit of every RRPV field that holds a way
+      UInt64 getLaneMask(UInt32 word_index);
+      void setRRPV(UInt32 line_index, UInt64 rrpv);
+      bool useBimodalInsertion();
+};
+
+class CacheSetRandom : public CacheSet
+{
+   public:
+      CacheSetRandom(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+            UInt32 set_index);
+      ~CacheSetRandom();
+
+      UInt32 getReplacementIndex();
+      void updateReplacementIndex(UInt32 accessed_index);
+
+   private:
+      Random m_random;
+};
+
+inline void
+CacheSet::readLineData(UInt32 line_index, UInt32 offset, Byte *out_buff, UInt32 bytes)
+{
+   assert(offset + bytes <= m_blocksize);
+   assert((out_buff == NULL) == (bytes == 0));
+
+   if ((out_buff != NULL) && (m_blocks != NULL))
+      memcpy((void*) out_buff, &m_blocks[line_index * m_blocksize + offset], bytes);
+}
+
+inline void
+CacheSet::writeLineData(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 bytes)
+{
+   assert(offset + bytes <= m_blocksize);
+   assert((in_buff == NULL) == (bytes == 0));
+
+   if ((in_buff != NULL) && (m_blocks != NULL))
+      memcpy(&m_blocks[line_index * m_blocksize + offset], (void*) in_buff, bytes);
+}
+
+inline void
+CacheSetRoundRobin::updateReplacementIndex(UInt32 accessed_index)
+{}
+
+inline void
+CacheSetLRU::updateReplacementIndex(UInt32 accessed_index)
+{
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      if (m_lru_bits[i] < m_lru_bits[accessed_index])
+         m_lru_bits[i] ++;
+   }
+   m_lru_bits[accessed_index] = 0;
+}
+
+inline void
+CacheSetPLRU::updateReplacementIndex(UInt32 accessed_index)
+{
+   // Point every node on the path away from the accessed way
+   UInt32 node = accessed_index + m_associativity;
+   while (node > 1)
+   {
+      UInt32 parent = node >> 1;
+      if (node & 1)
+         m_plru_bits &= ~(((UInt64) 1) << parent);
+      else
+         m_plru_bits |= (((UInt64) 1) << parent);
+      node = parent;
+   }
+}
+
+inline void
+CacheSetRRIP::setRRPV(UInt32 line_index, UInt64 rrpv)
+{
+   UInt64& word = m_rrpv_words[line_index / WAYS_PER_WORD];
+   UInt32 shift = (line_index % WAYS_PER_WORD) * RRPV_BITS;
+   word = (word & ~(MAX_RRPV << shift)) | (rrpv << shift);
+}
+
+inline void
+CacheSetRRIP::updateReplacementIndex(UInt32 accessed_index)
+{
+   // Hit priority: a re-referenced line is predicted near-immediate
+   setRRPV(accessed_index, 0);
+}
+
+inline void
+CacheSetRandom::updateReplacementIndex(UInt32 accessed_index)
+{}
+
+template <class SetType, class BlockInfo>
+BlockInfo
+CacheSet::insertInPlace(IntPtr tag, CacheState::cstate_t cstate, Byte* fill_buff,
+      bool* eviction, Byte* evict_buff, UInt32* line_index)
+{
+   SetType* set = static_cast<SetType*>(this);
+
+   // This replacement strategy does not take into account the fact that
+   // cache blocks can be voluntarily flushed or invalidated due to another write request
+   const UInt32 index = set->getReplacementIndex();
+   assert(index < m_associativity);
+   assert(eviction != NULL);
+
+   BlockInfo* block_info = static_cast<BlockInfo*>(m_cache_block_info_array[index]);
+   BlockInfo evict_block_info;
+
+   *eviction = isValidLine(index);
+   if (*eviction)
+   {
+      evict_block_info = *block_info;
+      if ((evict_buff != NULL) && (m_blocks != NULL))
+         memcpy((void*) evict_buff, &m_blocks[index * m_blocksize], m_blocksize);
+   }
+
+   *block_info = BlockInfo(tag, cstate);
+   m_tags[index] = tag;
+   set->updateReplacementIndexOnInsert(index);
+
+   if ((fill_buff != NULL) && (m_blocks != NULL))
+      memcpy(&m_blocks[index * m_blocksize], (void*) fill_buff, m_blocksize);
+
+   if (line_index != NULL)
+      *line_index = index;
+   return evict_block_info;
+}
 
 #endif /* CACHE_SET_H */
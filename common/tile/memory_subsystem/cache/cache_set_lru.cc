@@ -3,8 +3,8 @@
 
 CacheSetLRU::CacheSetLRU(
       CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize) :
-   CacheSet(cache_type, associativity, blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled) :
+   CacheSet(cache_type, associativity, blocksize, data_storage_enabled)
 {
    m_lru_bits = new UInt8[m_associativity];
    for (UInt32 i = 0; i < m_associativity; i++)
@@ -23,7 +23,7 @@ CacheSetLRU::getReplacementIndex()
    UInt32 index = m_associativity;
    for (UInt32 i = 0; i < m_associativity; i++)
    {
-      if (!m_cache_block_info_array[i]->isValid())
+      if (!isValidLine(i))
          return i;
       else if (m_lru_bits[i] == (m_associativity-1))
          index = i;
@@ -33,12 +33,13 @@ CacheSetLRU::getReplacementIndex()
 }
 
 void
-CacheSetLRU::updateReplacementIndex(UInt32 accessed_index)
+CacheSetLRU::saveReplacementState(SnapshotWriter& writer)
 {
-   for (UInt32 i = 0; i < m_associativity; i++)
-   {
-      if (m_lru_bits[i] < m_lru_bits[accessed_index])
-         m_lru_bits[i] ++;
-   }
-   m_lru_bits[accessed_index] = 0;
+   writer.writeBytes(m_lru_bits, m_associativity);
+}
+
+void
+CacheSetLRU::loadReplacementState(SnapshotReader& reader)
+{
+   reader.readBytes(m_lru_bits, m_associativity);
 }
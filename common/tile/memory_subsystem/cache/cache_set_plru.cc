@@ -0,0 +1,50 @@
+#include "cache_set.h"
+#include "utils.h"
+#include "log.h"
+
+CacheSetPLRU::CacheSetPLRU(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled) :
+   CacheSet(cache_type, associativity, blocksize, data_storage_enabled),
+   m_plru_bits(0)
+{
+   LOG_ASSERT_ERROR(isPower2(m_associativity) && (m_associativity <= MAX_ASSOCIATIVITY),
+         "Tree PLRU needs a power-of-2 associativity <= %u, got %u",
+         MAX_ASSOCIATIVITY, m_associativity);
+}
+
+CacheSetPLRU::~CacheSetPLRU()
+{}
+
+UInt32
+CacheSetPLRU::getReplacementIndex()
+{
+   SInt32 invalid_index = getInvalidIndex();
+   if (invalid_index >= 0)
+      return invalid_index;
+
+   // Nodes are numbered as in a binary heap (root = 1); the leaves
+   // [m_associativity, 2 * m_associativity) are the ways
+   UInt32 node = 1;
+   while (node < m_associativity)
+      node = 2 * node + ((m_plru_bits >> node) & 1);
+   return node - m_associativity;
+}
+
+void
+CacheSetPLRU::updateReplacementIndexOnInsert(UInt32 inserted_index)
+{
+   updateReplacementIndex(inserted_index);
+}
+
+void
+CacheSetPLRU::saveReplacementState(SnapshotWriter& writer)
+{
+   writer.write<UInt64>(m_plru_bits);
+}
+
+void
+CacheSetPLRU::loadReplacementState(SnapshotReader& reader)
+{
+   m_plru_bits = reader.read<UInt64>();
+}
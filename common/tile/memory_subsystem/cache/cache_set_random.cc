@@ -0,0 +1,24 @@
+#include "cache_set.h"
+
+CacheSetRandom::CacheSetRandom(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+      UInt32 set_index) :
+   CacheSet(cache_type, associativity, blocksize, data_storage_enabled)
+{
+   // Per-set generator: reproducible and free of races on rand()
+   m_random.seed(set_index + 1);
+}
+
+CacheSetRandom::~CacheSetRandom()
+{}
+
+UInt32
+CacheSetRandom::getReplacementIndex()
+{
+   SInt32 invalid_index = getInvalidIndex();
+   if (invalid_index >= 0)
+      return invalid_index;
+
+   return m_random.next(m_associativity);
+}
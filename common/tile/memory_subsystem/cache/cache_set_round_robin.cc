@@ -2,8 +2,8 @@
 
 CacheSetRoundRobin::CacheSetRoundRobin(
       CacheBase::cache_t cache_type, 
-      UInt32 associativity, UInt32 blocksize) :
-   CacheSet(cache_type, associativity, blocksize)
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled) :
+   CacheSet(cache_type, associativity, blocksize, data_storage_enabled)
 {
    m_replacement_index = m_associativity - 1;
 }
@@ -20,7 +20,13 @@ CacheSetRoundRobin::getReplacementIndex()
 }
 
 void
-CacheSetRoundRobin::updateReplacementIndex(UInt32 accessed_index)
+CacheSetRoundRobin::saveReplacementState(SnapshotWriter& writer)
 {
-   return;
+   writer.write<UInt32>(m_replacement_index);
+}
+
+void
+CacheSetRoundRobin::loadReplacementState(SnapshotReader& reader)
+{
+   m_replacement_index = reader.read<UInt32>();
 }
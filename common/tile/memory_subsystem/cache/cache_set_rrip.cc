@@ -0,0 +1,175 @@
+#include "cache_set.h"
+#include "log.h"
+
+CacheSetRRIP::CacheSetRRIP(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, bool data_storage_enabled,
+      CacheBase::ReplacementPolicy policy,
+      UInt32 set_index, SetDuelingMonitor* set_dueling_monitor) :
+   CacheSet(cache_type, associativity, blocksize, data_storage_enabled),
+   m_policy(policy),
+   m_set_dueling_monitor(set_dueling_monitor),
+   m_set_dueling_role(SetDuelingMonitor::FOLLOWER),
+   m_bimodal_count(0)
+{
+   if (m_policy == CacheBase::DRRIP)
+   {
+      LOG_ASSERT_ERROR(m_set_dueling_monitor != NULL, "DRRIP needs a set dueling monitor");
+      m_set_dueling_role = m_set_dueling_monitor->getRole(set_index);
+   }
+
+   // All the ways start out predicted for a distant re-reference
+   m_num_rrpv_words = (m_associativity + WAYS_PER_WORD - 1) / WAYS_PER_WORD;
+   m_rrpv_words = new UInt64[m_num_rrpv_words];
+   for (UInt32 k = 0; k < m_num_rrpv_words; k++)
+      m_rrpv_words[k] = getLaneMask(k) * MAX_RRPV;
+}
+
+CacheSetRRIP::~CacheSetRRIP()
+{
+   delete [] m_rrpv_words;
+}
+
+UInt32
+CacheSetRRIP::getReplacementIndex()
+{
+   SInt32 invalid_index = getInvalidIndex();
+   if (invalid_index >= 0)
+      return invalid_index;
+
+   // Terminates within MAX_RRPV aging steps
+   while (true)
+   {
+      for (UInt32 k = 0; k < m_num_rrpv_words; k++)
+      {
+         UInt64 word = m_rrpv_words[k];
+         UInt64 distant = word & (word >> 1) & getLaneMask(k);
+         if (distant)
+            return k * WAYS_PER_WORD + (__builtin_ctzll(distant) / RRPV_BITS);
+      }
+
+      // No field is at MAX_RRPV, so adding one to every field never
+      // carries into its neighbour
+      for (UInt32 k = 0; k < m_num_rrpv_words; k++)
+         m_rrpv_words[k] += getLaneMask(k);
+   }
+}
+
+void
+CacheSetRRIP::updateReplacementIndexOnInsert(UInt32 inserted_index)
+{
+   if (m_set_dueling_role != SetDuelingMonitor::FOLLOWER)
+      m_set_dueling_monitor->recordMiss(m_set_dueling_role);
+
+   UInt64 rrpv = MAX_RRPV - 1;
+   if (useBimodalInsertion())
+   {
+      m_bimodal_count = (m_bimodal_count + 1) % BIMODAL_THROTTLE;
+      if (m_bimodal_count != 0)
+         rrpv = MAX_RRPV;
+   }
+   setRRPV(inserted_index, rrpv);
+}
+
+UInt64
+CacheSetRRIP::getLaneMask(UInt32 word_index)
+{
+   const UInt64 all_lanes = 0x5555555555555555ULL;
+   UInt32 num_lanes = m_associativity - word_index * WAYS_PER_WORD;
+   if (num_lanes >= WAYS_PER_WORD)
+      return all_lanes;
+   return all_lanes & ((((UInt64) 1) << (num_lanes * RRPV_BITS)) - 1);
+}
+
+bool
+CacheSetRRIP::useBimodalInsertion()
+{
+   switch (m_policy)
+   {
+      case CacheBase::SRRIP:
+         return false;
+
+      case CacheBase::BRRIP:
+         return true;
+
+      case CacheBase::DRRIP:
+         // Policy A is SRRIP, policy B is BRRIP
+         return m_set_dueling_monitor->usePolicyB(m_set_dueling_role);
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized RRIP policy: %i", m_policy);
+         return false;
+   }
+}
+
+void
+CacheSetRRIP::saveReplacementState(SnapshotWriter& writer)
+{
+   writer.writeBytes(m_rrpv_words, m_num_rrpv_words * sizeof(UInt64));
+   writer.write<UInt32>(m_bimodal_count);
+}
+
+void
+CacheSetRRIP::loadReplacementState(SnapshotReader& reader)
+{
+   reader.readBytes(m_rrpv_words, m_num_rrpv_words * sizeof(UInt64));
+   m_bimodal_count = reader.read<UInt32>();
+}
+
+SetDuelingMonitor::SetDuelingMonitor(UInt32 num_sets):
+   m_psel(1 << (PSEL_BITS - 1))
+{
+   // One leader set of each policy in every constituency
+   m_constituency_size = num_sets / NUM_LEADER_SETS;
+   if (m_constituency_size < 2)
+      m_constituency_size = 2;
+}
+
+SetDuelingMonitor::~SetDuelingMonitor()
+{}
+
+SetDuelingMonitor::role_t
+SetDuelingMonitor::getRole(UInt32 set_index)
+{
+   switch (set_index % m_constituency_size)
+   {
+      case 0:
+         return LEADER_A;
+      case 1:
+         return LEADER_B;
+      default:
+         return FOLLOWER;
+   }
+}
+
+void
+SetDuelingMonitor::recordMiss(role_t role)
+{
+   // PSEL counts up on policy A misses and down on policy B misses
+   if ((role == LEADER_A) && (m_psel < ((1U << PSEL_BITS) - 1)))
+      m_psel ++;
+   else if ((role == LEADER_B) && (m_psel > 0))
+      m_psel --;
+}
+
+bool
+SetDuelingMonitor::usePolicyB(role_t role)
+{
+   if (role == LEADER_A)
+      return false;
+   if (role == LEADER_B)
+      return true;
+   return (m_psel >= (1U << (PSEL_BITS - 1)));
+}
+
+void
+SetDuelingMonitor::saveSnapshot(SnapshotWriter& writer)
+{
+   writer.write<UInt32>(m_psel);
+}
+
+void
+SetDuelingMonitor::loadSnapshot(SnapshotReader& reader)
+{
+   m_psel = reader.read<UInt32>();
+}
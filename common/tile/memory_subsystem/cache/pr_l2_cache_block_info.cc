@@ -4,24 +4,20 @@
 MemComponent::component_t 
 PrL2CacheBlockInfo::getCachedLoc()
 {
-   LOG_ASSERT_ERROR(m_cached_loc_bitvec != ((1 << MemComponent::L1_ICACHE) | (1 << MemComponent::L1_DCACHE)),
-         "m_cached_loc_bitvec(%u)", m_cached_loc_bitvec);
+   // A block is cached either in the Instruction Caches or in the Data Caches
+   // (of the main and the PEP core), never in both
+   UInt32 icache_bitvec = (((UInt32) 1) << MemComponent::L1_ICACHE) | (((UInt32) 1) << MemComponent::L1_PEP_ICACHE);
+   UInt32 dcache_bitvec = (((UInt32) 1) << MemComponent::L1_DCACHE) | (((UInt32) 1) << MemComponent::L1_PEP_DCACHE);
+   LOG_ASSERT_ERROR(((m_cached_loc_bitvec & ~(icache_bitvec | dcache_bitvec)) == 0) &&
+         (((m_cached_loc_bitvec & icache_bitvec) == 0) || ((m_cached_loc_bitvec & dcache_bitvec) == 0)),
+         "Error: m_cached_loc_bitvec(%u)", m_cached_loc_bitvec);
 
-   switch(m_cached_loc_bitvec)
+   for (UInt32 loc = MemComponent::MIN_MEM_COMPONENT; loc <= MemComponent::MAX_MEM_COMPONENT; loc++)
    {
-      case ((UInt32) 1) << MemComponent::L1_ICACHE:
-         return MemComponent::L1_ICACHE;
-
-      case ((UInt32) 1) << MemComponent::L1_DCACHE:
-         return MemComponent::L1_DCACHE;
-
-      case ((UInt32) 0):
-         return MemComponent::INVALID_MEM_COMPONENT;
-
-      default:
-         LOG_PRINT_ERROR("Error: m_cached_loc_bitvec(%u)", m_cached_loc_bitvec);
-         return MemComponent::INVALID_MEM_COMPONENT;
+      if (m_cached_loc_bitvec & (((UInt32) 1) << loc))
+         return (MemComponent::component_t) loc;
    }
+   return MemComponent::INVALID_MEM_COMPONENT;
 }
 
 void 
@@ -63,6 +59,7 @@ void
 PrL2CacheBlockInfo::invalidate()
 {
    m_cached_loc_bitvec = 0;
+   m_prefetch_source = MemComponent::INVALID_MEM_COMPONENT;
    CacheBlockInfo::invalidate();
 }
 
@@ -70,5 +67,21 @@ void
 PrL2CacheBlockInfo::clone(CacheBlockInfo* cache_block_info)
 {
    m_cached_loc_bitvec = ((PrL2CacheBlockInfo*) cache_block_info)->getCachedLocBitVec();
+   m_prefetch_source = ((PrL2CacheBlockInfo*) cache_block_info)->getPrefetchSource();
    CacheBlockInfo::clone(cache_block_info);
 }
+
+void
+PrL2CacheBlockInfo::saveSnapshot(SnapshotWriter& writer)
+{
+   CacheBlockInfo::saveSnapshot(writer);
+   writer.write<UInt32>(m_cached_loc_bitvec);
+}
+
+void
+PrL2CacheBlockInfo::loadSnapshot(SnapshotReader& reader)
+{
+   CacheBlockInfo::loadSnapshot(reader);
+   m_cached_loc_bitvec = reader.read<UInt32>();
+   m_prefetch_source = MemComponent::INVALID_MEM_COMPONENT;
+}
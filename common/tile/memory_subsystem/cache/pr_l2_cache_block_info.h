@@ -9,16 +9,20 @@ class PrL2CacheBlockInfo : public CacheBlockInfo
 {
    private:
       UInt32 m_cached_loc_bitvec;
+      // Prefetcher that brought the block in, until the first demand access
+      MemComponent::component_t m_prefetch_source;
 
    public:
       PrL2CacheBlockInfo(IntPtr tag = ~0,
             CacheState::cstate_t cstate = CacheState::INVALID):
          CacheBlockInfo(tag, cstate),
-         m_cached_loc_bitvec(0)
+         m_cached_loc_bitvec(0),
+         m_prefetch_source(MemComponent::INVALID_MEM_COMPONENT)
       {}
 
       ~PrL2CacheBlockInfo() {}
 
+      // The main core's L1 Cache if both the main and the PEP core cache the block
       MemComponent::component_t getCachedLoc();
       MemComponent::component_t getSingleCachedLoc();
       void setCachedLoc(MemComponent::component_t cached_loc);
@@ -27,7 +31,14 @@ class PrL2CacheBlockInfo : public CacheBlockInfo
 
       UInt32 getCachedLocBitVec() { return m_cached_loc_bitvec; }
 
+      MemComponent::component_t getPrefetchSource() { return m_prefetch_source; }
+      void setPrefetchSource(MemComponent::component_t prefetch_source) { m_prefetch_source = prefetch_source; }
+
       void invalidate();
       void clone(CacheBlockInfo* cache_block_info);
+
+      // The prefetch source is not saved: restored lines count as demand fetched
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader);
 };
 #endif /* __PR_L2_CACHE_BLOCK_INFO_H__ */
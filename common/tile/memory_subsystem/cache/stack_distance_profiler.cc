@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "stack_distance_profiler.h"
+#include "utils.h"
+#include "log.h"
+
+StackDistanceProfiler::StackDistanceProfiler(UInt32 cache_block_size, float sampling_rate):
+   m_cache_block_size(cache_block_size),
+   m_log_cache_block_size(floorLog2(cache_block_size)),
+   m_sampling_rate(sampling_rate),
+   m_enabled(false),
+   m_last_filled_block(0),
+   m_last_filled_block_valid(false),
+   m_tree(MIN_TREE_SIZE + 1, 0),
+   m_curr_time(0),
+   m_distance_histogram(NUM_DISTANCE_BUCKETS, 0)
+{
+   LOG_ASSERT_ERROR((m_sampling_rate > 0.0) && (m_sampling_rate <= 1.0),
+         "Stack distance sampling rate(%f) must be in (0,1]", m_sampling_rate);
+   m_sampling_threshold = (UInt64) (m_sampling_rate * SAMPLING_MODULUS);
+   reset();
+}
+
+StackDistanceProfiler::~StackDistanceProfiler()
+{}
+
+void
+StackDistanceProfiler::reset()
+{
+   // The stack itself is kept so that a reset after warm-up does not
+   // count every block as a cold miss
+   std::fill(m_distance_histogram.begin(), m_distance_histogram.end(), 0);
+   m_num_cold_references = 0;
+   m_num_references = 0;
+}
+
+void
+StackDistanceProfiler::fill(IntPtr address)
+{
+   IntPtr block = address >> m_log_cache_block_size;
+   reference(block);
+   m_last_filled_block = block;
+   m_last_filled_block_valid = true;
+}
+
+void
+StackDistanceProfiler::access(IntPtr address)
+{
+   IntPtr block = address >> m_log_cache_block_size;
+   if (m_last_filled_block_valid && (block == m_last_filled_block))
+   {
+      m_last_filled_block_valid = false;
+      return;
+   }
+   m_last_filled_block_valid = false;
+   reference(block);
+}
+
+bool
+StackDistanceProfiler::isSampled(IntPtr block)
+{
+   // Spatial sampling on a hash of the block address
+   UInt64 hash = (UInt64) block;
+   hash ^= hash >> 33;
+   hash *= 0xff51afd7ed558ccdULL;
+   hash ^= hash >> 33;
+   hash *= 0xc4ceb9fe1a85ec53ULL;
+   hash ^= hash >> 33;
+   return ((hash % SAMPLING_MODULUS) < m_sampling_threshold);
+}
+
+void
+StackDistanceProfiler::reference(IntPtr block)
+{
+   if (!isSampled(block))
+      return;
+
+   if (m_curr_time + 1 >= m_tree.size())
+      compactTree();
+   m_curr_time ++;
+
+   std::map<IntPtr, UInt64>::iterator it = m_last_reference_time.find(block);
+   if (it == m_last_reference_time.end())
+   {
+      if (m_enabled)
+         m_num_cold_references ++;
+      m_last_reference_time.insert(std::make_pair(block, m_curr_time));
+   }
+   else
+   {
+      // Number of distinct blocks referenced since the last reference to 'block'
+      UInt64 distance = (m_last_reference_time.size() - sumTree(it->second));
+      distance = (UInt64) (distance / m_sampling_rate);
+
+      if (m_enabled)
+      {
+         UInt32 bucket = 0;
+         for (UInt64 d = distance; d > 0; d >>= 1)
+            bucket ++;
+         m_distance_histogram[std::min(bucket, NUM_DISTANCE_BUCKETS - 1)] ++;
+      }
+
+      addToTree(it->second, -1);
+      it->second = m_curr_time;
+   }
+   addToTree(m_curr_time, 1);
+
+   if (m_enabled)
+      m_num_references ++;
+}
+
+void
+StackDistanceProfiler::addToTree(UInt64 time, SInt32 delta)
+{
+   for (UInt64 i = time; i < m_tree.size(); i += (i & (~i + 1)))
+      m_tree[i] += delta;
+}
+
+UInt64
+StackDistanceProfiler::sumTree(UInt64 time)
+{
+   SInt64 sum = 0;
+   for (UInt64 i = time; i > 0; i -= (i & (~i + 1)))
+      sum += m_tree[i];
+   return (UInt64) sum;
+}
+
+void
+StackDistanceProfiler::compactTree()
+{
+   // Renumber the last reference times 1..N, keeping their order
+   std::vector<std::pair<UInt64, IntPtr> > references;
+   references.reserve(m_last_reference_time.size());
+   for (std::map<IntPtr, UInt64>::iterator it = m_last_reference_time.begin();
+         it != m_last_reference_time.end(); it++)
+   {
+      references.push_back(std::make_pair(it->second, it->first));
+   }
+   std::sort(references.begin(), references.end());
+
+   UInt64 tree_size = std::max(MIN_TREE_SIZE, 4 * (UInt64) references.size());
+   m_tree.assign(tree_size + 1, 0);
+   for (UInt64 i = 0; i < references.size(); i++)
+   {
+      m_last_reference_time[references[i].second] = i + 1;
+      addToTree(i + 1, 1);
+   }
+   m_curr_time = references.size();
+}
+
+void
+StackDistanceProfiler::outputSummary(std::ostream& out)
+{
+   out << "    stack distance sampling rate: " << m_sampling_rate << std::endl;
+   out << "    miss rate curve (fully-associative LRU):" << std::endl;
+
+   // Misses of a cache with 2^k blocks: the cold references plus the
+   // references at a stack distance of 2^k or more
+   UInt64 num_misses = m_num_references;
+   UInt32 last_bucket = 0;
+   for (UInt32 b = 0; b < NUM_DISTANCE_BUCKETS; b++)
+   {
+      if (m_distance_histogram[b] > 0)
+         last_bucket = b;
+   }
+
+   for (UInt32 k = 0; (k < NUM_DISTANCE_BUCKETS - 1) && (k <= last_bucket); k++)
+   {
+      num_misses -= m_distance_histogram[k];
+      UInt64 cache_size = (((UInt64) 1) << k) * m_cache_block_size;
+      if (cache_size < 1024)
+         continue;
+
+      out << "      " << (cache_size / 1024) << " KB: " <<
+         ((m_num_references == 0) ? 0.0 : ((float) num_misses / m_num_references) * 100) << std::endl;
+   }
+}
@@ -0,0 +1,67 @@
+#ifndef __STACK_DISTANCE_PROFILER_H__
+#define __STACK_DISTANCE_PROFILER_H__
+
+#include <map>
+#include <vector>
+#include <iostream>
+
+#include "fixed_types.h"
+
+// Computes the LRU stack distance of every reference to a cache in one
+// pass, giving the miss rate of a fully-associative LRU cache of any size.
+// The distances are found with a Fenwick tree over the reference times
+// (Olken's algorithm). To bound the cost, only a hashed subset of the
+// cache blocks can be tracked and the distances scaled up (SHARDS)
+class StackDistanceProfiler
+{
+   public:
+      StackDistanceProfiler(UInt32 cache_block_size, float sampling_rate);
+      ~StackDistanceProfiler();
+
+      // Reference that fills the block after a miss. The access that
+      // completes the miss right after is not counted again
+      void fill(IntPtr address);
+      void access(IntPtr address);
+
+      void enable() { m_enabled = true; }
+      void disable() { m_enabled = false; }
+      void reset();
+
+      void outputSummary(std::ostream& out);
+
+   private:
+      static const UInt32 NUM_DISTANCE_BUCKETS = 64;
+      static const UInt64 SAMPLING_MODULUS = 1 << 24;
+      static const UInt64 MIN_TREE_SIZE = 1 << 16;
+
+      UInt32 m_cache_block_size;
+      UInt32 m_log_cache_block_size;
+      float m_sampling_rate;
+      UInt64 m_sampling_threshold;
+      bool m_enabled;
+
+      // Block filled by the last reference
+      IntPtr m_last_filled_block;
+      bool m_last_filled_block_valid;
+
+      // Time of the last reference to each tracked block
+      std::map<IntPtr, UInt64> m_last_reference_time;
+      // Fenwick tree marking the times that are the last reference to a block
+      std::vector<SInt32> m_tree;
+      UInt64 m_curr_time;
+
+      // References by stack distance. Bucket 0 holds distance 0 and
+      // bucket b holds the distances in [2^(b-1), 2^b)
+      std::vector<UInt64> m_distance_histogram;
+      UInt64 m_num_cold_references;
+      UInt64 m_num_references;
+
+      void reference(IntPtr block);
+      bool isSampled(IntPtr block);
+
+      void addToTree(UInt64 time, SInt32 delta);
+      UInt64 sumTree(UInt64 time);
+      void compactTree();
+};
+
+#endif /* __STACK_DISTANCE_PROFILER_H__ */
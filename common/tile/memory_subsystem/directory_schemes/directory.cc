@@ -2,11 +2,6 @@ using namespace std;
 
 #include "simulator.h"
 #include "directory.h"
-#include "directory_entry.h"
-#include "directory_entry_ackwise.h"
-#include "directory_entry_limited_broadcast.h"
-#include "directory_entry_limited_no_broadcast.h"
-#include "directory_entry_limitless.h"
 #include "log.h"
 
 Directory::Directory(string directory_type_str, UInt32 num_entries, UInt32 max_hw_sharers, UInt32 max_num_sharers):
@@ -15,35 +10,231 @@ Directory::Directory(string directory_type_str, UInt32 num_entries, UInt32 max_h
    m_max_num_sharers(max_num_sharers),
    m_limitless_software_trap_penalty(0)
 {
-   // Look at the type of directory and create 
-   m_directory_entry_list = new DirectoryEntry*[m_num_entries];
-  
    m_directory_type = parseDirectoryType(directory_type_str);
+   if (m_directory_type == FULL_MAP)
+      max_hw_sharers = max_num_sharers;
+
+   if (m_directory_type == LIMITLESS)
+   {
+      try
+      {
+         m_limitless_software_trap_penalty = Sim()->getCfg()->getInt("perf_model/dram_directory/limitless/software_trap_penalty");
+      }
+      catch (...)
+      {
+         LOG_PRINT_ERROR("Could not read 'cache_coherence/limitless/software_trap_penalty' from the config file");
+      }
+   }
+
+   m_directory_store = new DirectoryStore(m_num_entries, max_hw_sharers, m_max_num_sharers);
+
+   m_directory_entry_list.reserve(m_num_entries);
    for (UInt32 i = 0; i < m_num_entries; i++)
    {
-      m_directory_entry_list[i] = createDirectoryEntry();
+      m_directory_entry_list.push_back(DirectoryEntry(this, i));
    }
 }
 
 Directory::~Directory()
 {
-   for (UInt32 i = 0; i < m_num_entries; i++)
+   delete m_directory_store;
+}
+
+DirectoryEntry*
+Directory::spillDirectoryEntry(UInt32 entry_num)
+{
+   UInt32 spill_index = m_directory_store->allocate();
+   m_directory_store->copy(spill_index, entry_num);
+   m_directory_store->clear(entry_num);
+   return new DirectoryEntry(this, spill_index);
+}
+
+void
+Directory::releaseDirectoryEntry(DirectoryEntry* directory_entry)
+{
+   assert(directory_entry->getIndex() >= m_num_entries);
+   m_directory_store->release(directory_entry->getIndex());
+   delete directory_entry;
+}
+
+bool
+Directory::addSharer(UInt32 index, tile_id_t sharer_id)
+{
+   switch (m_directory_type)
    {
-      delete m_directory_entry_list[i];
+      case LIMITED_BROADCAST:
+         return DirectorySchemeLimitedBroadcast::addSharer(*m_directory_store, index, sharer_id);
+      case ACKWISE:
+         return DirectorySchemeAckwise::addSharer(*m_directory_store, index, sharer_id);
+      case LIMITLESS:
+         return DirectorySchemeLimitless::addSharer(*m_directory_store, index, sharer_id);
+      default:
+         return DirectorySchemeLimitedNoBroadcast::addSharer(*m_directory_store, index, sharer_id);
    }
-   delete [] m_directory_entry_list;
 }
 
-DirectoryEntry*
-Directory::getDirectoryEntry(UInt32 entry_num)
+void
+Directory::removeSharer(UInt32 index, tile_id_t sharer_id, bool reply_expected)
+{
+   switch (m_directory_type)
+   {
+      case LIMITED_BROADCAST:
+         DirectorySchemeLimitedBroadcast::removeSharer(*m_directory_store, index, sharer_id, reply_expected);
+         break;
+      case ACKWISE:
+         DirectorySchemeAckwise::removeSharer(*m_directory_store, index, sharer_id, reply_expected);
+         break;
+      case LIMITLESS:
+         DirectorySchemeLimitless::removeSharer(*m_directory_store, index, sharer_id, reply_expected);
+         break;
+      default:
+         DirectorySchemeLimitedNoBroadcast::removeSharer(*m_directory_store, index, sharer_id, reply_expected);
+         break;
+   }
+}
+
+tile_id_t
+Directory::getOneSharer(UInt32 index)
+{
+   switch (m_directory_type)
+   {
+      case LIMITED_BROADCAST:
+         return DirectorySchemeLimitedBroadcast::getOneSharer(*m_directory_store, index, m_rand_num);
+      case ACKWISE:
+         return DirectorySchemeAckwise::getOneSharer(*m_directory_store, index, m_rand_num);
+      case LIMITLESS:
+         return DirectorySchemeLimitless::getOneSharer(*m_directory_store, index, m_rand_num);
+      default:
+         return DirectorySchemeLimitedNoBroadcast::getOneSharer(*m_directory_store, index, m_rand_num);
+   }
+}
+
+pair<bool, vector<tile_id_t> >
+Directory::getSharersList(UInt32 index)
+{
+   pair<bool, vector<tile_id_t> > sharers_list;
+   switch (m_directory_type)
+   {
+      case LIMITED_BROADCAST:
+         sharers_list.first = DirectorySchemeLimitedBroadcast::isBroadcast(*m_directory_store, index);
+         break;
+      case ACKWISE:
+         sharers_list.first = DirectorySchemeAckwise::isBroadcast(*m_directory_store, index);
+         break;
+      case LIMITLESS:
+         sharers_list.first = DirectorySchemeLimitless::isBroadcast(*m_directory_store, index);
+         break;
+      default:
+         sharers_list.first = DirectorySchemeLimitedNoBroadcast::isBroadcast(*m_directory_store, index);
+         break;
+   }
+   m_directory_store->getSharers(index, sharers_list.second);
+   return sharers_list;
+}
+
+void
+Directory::setOwner(UInt32 index, tile_id_t owner_id)
+{
+   if (owner_id != INVALID_TILE_ID)
+   {
+      LOG_ASSERT_ERROR(m_directory_store->hasSharer(index, owner_id),
+            "owner_id(%i), m_owner_id(%i), num sharers(%u)",
+            owner_id, m_directory_store->getOwner(index), getNumSharers(index));
+   }
+   m_directory_store->setOwner(index, owner_id);
+}
+
+// Address, owner, state and sharers, followed by the scheme state
+void
+Directory::saveEntrySnapshot(UInt32 index, SnapshotWriter& writer)
+{
+   writer.write<IntPtr>(m_directory_store->getAddress(index));
+   writer.write<SInt32>(m_directory_store->getOwner(index));
+   writer.write<UInt32>(m_directory_store->getDState(index));
+
+   vector<tile_id_t> sharers;
+   m_directory_store->getSharers(index, sharers);
+   writer.write<UInt32>(sharers.size());
+   for (UInt32 i = 0; i < sharers.size(); i++)
+      writer.write<SInt32>(sharers[i]);
+
+   switch (m_directory_type)
+   {
+      case LIMITED_BROADCAST:
+         DirectorySchemeLimitedBroadcast::saveSnapshot(*m_directory_store, index, writer);
+         break;
+      case ACKWISE:
+         DirectorySchemeAckwise::saveSnapshot(*m_directory_store, index, writer);
+         break;
+      case LIMITLESS:
+         DirectorySchemeLimitless::saveSnapshot(*m_directory_store, index, writer);
+         break;
+      default:
+         DirectorySchemeLimitedNoBroadcast::saveSnapshot(*m_directory_store, index, writer);
+         break;
+   }
+}
+
+void
+Directory::loadEntrySnapshot(UInt32 index, SnapshotReader& reader)
+{
+   m_directory_store->clear(index);
+   m_directory_store->setAddress(index, reader.read<IntPtr>());
+   m_directory_store->setOwner(index, reader.read<SInt32>());
+   m_directory_store->setDState(index, (DirectoryState::dstate_t) reader.read<UInt32>());
+
+   UInt32 num_sharers = reader.read<UInt32>();
+   for (UInt32 i = 0; i < num_sharers; i++)
+   {
+      tile_id_t sharer_id = reader.read<SInt32>();
+      LOG_ASSERT_ERROR(sharer_id < (tile_id_t) m_max_num_sharers, "Snapshot sharer(%i), max sharers(%u)",
+            sharer_id, m_max_num_sharers);
+      m_directory_store->addSharer(index, sharer_id);
+   }
+
+   switch (m_directory_type)
+   {
+      case LIMITED_BROADCAST:
+         DirectorySchemeLimitedBroadcast::loadSnapshot(*m_directory_store, index, reader);
+         break;
+      case ACKWISE:
+         DirectorySchemeAckwise::loadSnapshot(*m_directory_store, index, reader);
+         break;
+      case LIMITLESS:
+         DirectorySchemeLimitless::loadSnapshot(*m_directory_store, index, reader);
+         break;
+      default:
+         DirectorySchemeLimitedNoBroadcast::loadSnapshot(*m_directory_store, index, reader);
+         break;
+   }
+}
+
+void
+Directory::saveSnapshot(SnapshotWriter& writer)
 {
-   return m_directory_entry_list[entry_num]; 
+   writer.write<UInt32>(m_directory_type);
+   writer.write<UInt32>(m_num_entries);
+   writer.write<UInt32>(m_max_hw_sharers);
+   writer.write<UInt32>(m_max_num_sharers);
+   for (UInt32 i = 0; i < m_num_entries; i++)
+      saveEntrySnapshot(i, writer);
 }
 
 void
-Directory::setDirectoryEntry(UInt32 entry_num, DirectoryEntry* directory_entry)
+Directory::loadSnapshot(SnapshotReader& reader)
 {
-   m_directory_entry_list[entry_num] = directory_entry;
+   UInt32 directory_type = reader.read<UInt32>();
+   UInt32 num_entries = reader.read<UInt32>();
+   UInt32 max_hw_sharers = reader.read<UInt32>();
+   UInt32 max_num_sharers = reader.read<UInt32>();
+   LOG_ASSERT_ERROR((directory_type == (UInt32) m_directory_type) && (num_entries == m_num_entries) &&
+         (max_hw_sharers == m_max_hw_sharers) && (max_num_sharers == m_max_num_sharers),
+         "Directory snapshot (type %u, %u entries, %u/%u sharers) does not match (type %u, %u entries, %u/%u sharers)",
+         directory_type, num_entries, max_hw_sharers, max_num_sharers,
+         m_directory_type, m_num_entries, m_max_hw_sharers, m_max_num_sharers);
+
+   for (UInt32 i = 0; i < m_num_entries; i++)
+      loadEntrySnapshot(i, reader);
 }
 
 Directory::DirectoryType
@@ -65,42 +256,3 @@ Directory::parseDirectoryType(string directory_type_str)
       return (DirectoryType) -1;
    }
 }
-
-DirectoryEntry*
-Directory::createDirectoryEntry()
-{
-   switch (m_directory_type)
-   {
-      case FULL_MAP:
-         return new DirectoryEntryLimitedNoBroadcast(m_max_num_sharers, m_max_num_sharers);
-
-      case LIMITED_NO_BROADCAST:
-         return new DirectoryEntryLimitedNoBroadcast(m_max_hw_sharers, m_max_num_sharers);
-
-      case LIMITED_BROADCAST:
-         return new DirectoryEntryLimitedBroadcast(m_max_hw_sharers, m_max_num_sharers);
-
-      case ACKWISE:
-         return new DirectoryEntryAckwise(m_max_hw_sharers, m_max_num_sharers);
-
-      case LIMITLESS:
-         {
-            if (m_limitless_software_trap_penalty == 0)
-            {
-               try
-               {
-                  m_limitless_software_trap_penalty = Sim()->getCfg()->getInt("perf_model/dram_directory/limitless/software_trap_penalty");
-               }
-               catch (...)
-               {
-                  LOG_PRINT_ERROR("Could not read 'cache_coherence/limitless/software_trap_penalty' from the config file");
-               }
-            }
-            return new DirectoryEntryLimitless(m_max_hw_sharers, m_max_num_sharers, m_limitless_software_trap_penalty);
-         }
-
-      default:
-         LOG_PRINT_ERROR("Unrecognized Directory Type: %u", m_directory_type);
-         return NULL;
-   }
-}
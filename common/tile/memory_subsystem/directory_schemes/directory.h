@@ -2,10 +2,21 @@
 #define __DIRECTORY_H__
 
 #include <string>
+#include <vector>
 
 #include "directory_entry.h"
+#include "directory_store.h"
+#include "directory_scheme_limited_no_broadcast.h"
+#include "directory_scheme_limited_broadcast.h"
+#include "directory_scheme_ackwise.h"
+#include "directory_scheme_limitless.h"
+#include "random.h"
+#include "snapshot.h"
 #include "fixed_types.h"
 
+// The entries are kept in a flat DirectoryStore and handed out as
+// DirectoryEntry handles. The behavior of each directory type is a
+// policy struct (directory_scheme_*.h) selected with a switch on the type
 class Directory
 {
    public:
@@ -28,17 +39,115 @@ class Directory
       // FIXME: Hack: Get me out of here
       UInt32 m_limitless_software_trap_penalty;
 
-      DirectoryEntry** m_directory_entry_list;
+      DirectoryStore* m_directory_store;
+      std::vector<DirectoryEntry> m_directory_entry_list;
+
+      Random m_rand_num;
+
+      friend class DirectoryEntry;
+
+      bool addSharer(UInt32 index, tile_id_t sharer_id);
+      void removeSharer(UInt32 index, tile_id_t sharer_id, bool reply_expected);
+      UInt32 getNumSharers(UInt32 index)
+      {
+         switch (m_directory_type)
+         {
+            case LIMITED_BROADCAST:
+               return DirectorySchemeLimitedBroadcast::getNumSharers(*m_directory_store, index);
+            case ACKWISE:
+               return DirectorySchemeAckwise::getNumSharers(*m_directory_store, index);
+            case LIMITLESS:
+               return DirectorySchemeLimitless::getNumSharers(*m_directory_store, index);
+            default:
+               return DirectorySchemeLimitedNoBroadcast::getNumSharers(*m_directory_store, index);
+         }
+      }
+      tile_id_t getOneSharer(UInt32 index);
+      std::pair<bool, std::vector<tile_id_t> > getSharersList(UInt32 index);
+      void setOwner(UInt32 index, tile_id_t owner_id);
+      UInt32 getLatency(UInt32 index)
+      {
+         if (m_directory_type == LIMITLESS)
+            return DirectorySchemeLimitless::getLatency(*m_directory_store, index, m_limitless_software_trap_penalty);
+         else
+            return 0;
+      }
+
+      void saveEntrySnapshot(UInt32 index, SnapshotWriter& writer);
+      void loadEntrySnapshot(UInt32 index, SnapshotReader& reader);
 
    public:
       Directory(std::string directory_type_str, UInt32 num_entries, UInt32 max_hw_sharers, UInt32 max_num_sharers);
       ~Directory();
 
-      DirectoryEntry* getDirectoryEntry(UInt32 entry_num);
-      void setDirectoryEntry(UInt32 entry_num, DirectoryEntry* directory_entry);
-      DirectoryEntry* createDirectoryEntry();
-      
+      DirectoryEntry* getDirectoryEntry(UInt32 entry_num)
+      { return &m_directory_entry_list[entry_num]; }
+
+      // Moves the state of entry 'entry_num' to a spill entry and clears the
+      // entry. The returned handle stays valid until released
+      DirectoryEntry* spillDirectoryEntry(UInt32 entry_num);
+      void releaseDirectoryEntry(DirectoryEntry* directory_entry);
+
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader);
+
       static DirectoryType parseDirectoryType(std::string directory_type_str);
 };
 
+inline DirectoryState::dstate_t
+DirectoryEntry::getDState()
+{ return m_directory->m_directory_store->getDState(m_index); }
+
+inline void
+DirectoryEntry::setDState(DirectoryState::dstate_t dstate)
+{ m_directory->m_directory_store->setDState(m_index, dstate); }
+
+inline bool
+DirectoryEntry::hasSharer(tile_id_t sharer_id)
+{ return m_directory->m_directory_store->hasSharer(m_index, sharer_id); }
+
+inline bool
+DirectoryEntry::addSharer(tile_id_t sharer_id)
+{ return m_directory->addSharer(m_index, sharer_id); }
+
+inline void
+DirectoryEntry::removeSharer(tile_id_t sharer_id, bool reply_expected)
+{ m_directory->removeSharer(m_index, sharer_id, reply_expected); }
+
+inline UInt32
+DirectoryEntry::getNumSharers()
+{ return m_directory->getNumSharers(m_index); }
+
+inline tile_id_t
+DirectoryEntry::getOwner()
+{ return m_directory->m_directory_store->getOwner(m_index); }
+
+inline void
+DirectoryEntry::setOwner(tile_id_t owner_id)
+{ m_directory->setOwner(m_index, owner_id); }
+
+inline IntPtr
+DirectoryEntry::getAddress()
+{ return m_directory->m_directory_store->getAddress(m_index); }
+
+inline void
+DirectoryEntry::setAddress(IntPtr address)
+{ m_directory->m_directory_store->setAddress(m_index, address); }
+
+inline tile_id_t
+DirectoryEntry::getOneSharer()
+{ return m_directory->getOneSharer(m_index); }
+
+// Return a pair:
+// val.first :- 'True' if all tiles are sharers
+//              'False' if NOT all tiles are sharers
+// val.second :- the tracked sharers
+inline std::pair<bool, std::vector<tile_id_t> >
+DirectoryEntry::getSharersList()
+{ return m_directory->getSharersList(m_index); }
+
+inline UInt32
+DirectoryEntry::getLatency()
+{ return m_directory->getLatency(m_index); }
+
 #endif /* __DIRECTORY_H__ */
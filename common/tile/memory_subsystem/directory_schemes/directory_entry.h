@@ -3,42 +3,46 @@
 
 #include <vector>
 
-#include "bit_vector.h"
-#include "directory_block_info.h"
+#include "directory_state.h"
+#include "fixed_types.h"
 
+class Directory;
+
+// Handle on one entry of a Directory. The state itself lives in the
+// directory's DirectoryStore; the methods are defined in directory.h
 class DirectoryEntry
 {
-   protected:
-      UInt32 m_max_hw_sharers;
-      UInt32 m_max_num_sharers;
-      tile_id_t m_owner_id;
-      IntPtr m_address;
-      BitVector* m_sharers;
-      DirectoryBlockInfo* m_directory_block_info;
-
-      std::pair<bool, std::vector<tile_id_t> > m_cached_sharers_list;
+   private:
+      Directory* m_directory;
+      UInt32 m_index;
 
    public:
-      DirectoryEntry(UInt32 max_hw_sharers, UInt32 max_num_sharers);
-      virtual ~DirectoryEntry();
+      DirectoryEntry(Directory* directory, UInt32 index):
+         m_directory(directory),
+         m_index(index)
+      {}
+      ~DirectoryEntry() {}
+
+      UInt32 getIndex() { return m_index; }
 
-      DirectoryBlockInfo* getDirectoryBlockInfo();
+      DirectoryState::dstate_t getDState();
+      void setDState(DirectoryState::dstate_t dstate);
 
-      virtual bool hasSharer(tile_id_t sharer_id) = 0;
-      virtual bool addSharer(tile_id_t sharer_id) = 0;
-      virtual void removeSharer(tile_id_t sharer_id, bool reply_expected = false) = 0;
-      virtual UInt32 getNumSharers() = 0;
+      bool hasSharer(tile_id_t sharer_id);
+      bool addSharer(tile_id_t sharer_id);
+      void removeSharer(tile_id_t sharer_id, bool reply_expected = false);
+      UInt32 getNumSharers();
 
-      virtual tile_id_t getOwner() = 0;
-      virtual void setOwner(tile_id_t owner_id) = 0;
+      tile_id_t getOwner();
+      void setOwner(tile_id_t owner_id);
 
-      IntPtr getAddress() { return m_address; }
-      void setAddress(IntPtr address) { m_address = address; }
+      IntPtr getAddress();
+      void setAddress(IntPtr address);
 
-      virtual tile_id_t getOneSharer() = 0;
-      virtual std::pair<bool, std::vector<tile_id_t> >& getSharersList() = 0;
+      tile_id_t getOneSharer();
+      std::pair<bool, std::vector<tile_id_t> > getSharersList();
 
-      virtual UInt32 getLatency() = 0;
+      UInt32 getLatency();
 };
 
 #endif /* __DIRECTORY_ENTRY_H__ */
@@ -0,0 +1,98 @@
+#ifndef __DIRECTORY_SCHEME_ACKWISE_H__
+#define __DIRECTORY_SCHEME_ACKWISE_H__
+
+#include <cassert>
+
+#include "directory_store.h"
+#include "random.h"
+#include "snapshot.h"
+
+// Up to max_hw_sharers tracked sharers; past that, invalidations are
+// broadcast (scheme flag set) and the scheme count holds the number of
+// untracked sharers, so that the acknowledgements can be counted
+struct DirectorySchemeAckwise
+{
+   static bool addSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id)
+   {
+      if (store.getSchemeFlag(index))
+      {
+         store.setSchemeCount(index, store.getSchemeCount(index) + 1);
+      }
+      else
+      {
+         assert(!store.hasSharer(index, sharer_id));
+         if (store.getNumSharers(index) == store.getMaxHwSharers())
+         {
+            store.setSchemeFlag(index, true);
+            store.setSchemeCount(index, 1);
+         }
+         else
+         {
+            store.addSharer(index, sharer_id);
+         }
+      }
+      return true;
+   }
+
+   static void removeSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id, bool reply_expected)
+   {
+      assert(!reply_expected);
+
+      if (store.getSchemeFlag(index))
+      {
+         assert(store.getSchemeCount(index) > 0);
+         if (store.hasSharer(index, sharer_id))
+         {
+            store.removeSharer(index, sharer_id);
+         }
+         else
+         {
+            UInt32 num_untracked_sharers = store.getSchemeCount(index) - 1;
+            store.setSchemeCount(index, num_untracked_sharers);
+            if (num_untracked_sharers == 0)
+               store.setSchemeFlag(index, false);
+         }
+      }
+      else
+      {
+         assert(store.hasSharer(index, sharer_id));
+         store.removeSharer(index, sharer_id);
+      }
+   }
+
+   static UInt32 getNumSharers(DirectoryStore& store, UInt32 index)
+   {
+      if (store.getSchemeFlag(index))
+         return store.getNumSharers(index) + store.getSchemeCount(index);
+      else
+         return store.getNumSharers(index);
+   }
+
+   static bool isBroadcast(DirectoryStore& store, UInt32 index)
+   {
+      assert(!store.getSchemeFlag(index) || (store.getSchemeCount(index) > 0));
+      return store.getSchemeFlag(index);
+   }
+
+   static tile_id_t getOneSharer(DirectoryStore& store, UInt32 index, Random& rand_num)
+   {
+      assert(store.getSchemeFlag(index) || (store.getNumSharers(index) > 0));
+      if (store.getNumSharers(index) > 0)
+         return store.getSharer(index, rand_num.next(store.getNumSharers(index)));
+      else
+         return INVALID_TILE_ID;
+   }
+
+   static void saveSnapshot(DirectoryStore& store, UInt32 index, SnapshotWriter& writer)
+   {
+      writer.write<bool>(store.getSchemeFlag(index));
+      writer.write<UInt32>(store.getSchemeCount(index));
+   }
+   static void loadSnapshot(DirectoryStore& store, UInt32 index, SnapshotReader& reader)
+   {
+      store.setSchemeFlag(index, reader.read<bool>());
+      store.setSchemeCount(index, reader.read<UInt32>());
+   }
+};
+
+#endif /* __DIRECTORY_SCHEME_ACKWISE_H__ */
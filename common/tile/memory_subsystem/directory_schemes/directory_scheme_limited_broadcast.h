@@ -0,0 +1,99 @@
+#ifndef __DIRECTORY_SCHEME_LIMITED_BROADCAST_H__
+#define __DIRECTORY_SCHEME_LIMITED_BROADCAST_H__
+
+#include <cassert>
+
+#include "directory_store.h"
+#include "config.h"
+#include "random.h"
+#include "snapshot.h"
+
+// Up to max_hw_sharers tracked sharers; past that, every tile is assumed to
+// be a sharer (scheme flag set) and invalidations are broadcast. The scheme
+// count holds the number of tiles that have yet to acknowledge the broadcast
+struct DirectorySchemeLimitedBroadcast
+{
+   static bool addSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id)
+   {
+      if (store.getSchemeFlag(index))
+      {
+         assert(store.getSchemeCount(index) == Config::getSingleton()->getTotalTiles());
+      }
+      else
+      {
+         assert(!store.hasSharer(index, sharer_id));
+         if (store.getNumSharers(index) == store.getMaxHwSharers())
+         {
+            store.setSchemeFlag(index, true);
+            store.setSchemeCount(index, Config::getSingleton()->getTotalTiles());
+         }
+         else
+         {
+            store.addSharer(index, sharer_id);
+         }
+      }
+      return true;
+   }
+
+   static void removeSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id, bool reply_expected)
+   {
+      if (store.getSchemeFlag(index))
+      {
+         if (store.hasSharer(index, sharer_id))
+            store.removeSharer(index, sharer_id);
+      }
+      else
+      {
+         assert(store.hasSharer(index, sharer_id));
+         store.removeSharer(index, sharer_id);
+      }
+
+      if (reply_expected)
+      {
+         assert(store.getSchemeFlag(index));
+         UInt32 num_sharers = store.getSchemeCount(index) - 1;
+         store.setSchemeCount(index, num_sharers);
+         if (num_sharers == 0)
+         {
+            store.setSchemeFlag(index, false);
+            assert(store.getNumSharers(index) == 0);
+         }
+      }
+   }
+
+   static UInt32 getNumSharers(DirectoryStore& store, UInt32 index)
+   {
+      if (store.getSchemeFlag(index))
+         return Config::getSingleton()->getTotalTiles();
+      else
+         return store.getNumSharers(index);
+   }
+
+   static bool isBroadcast(DirectoryStore& store, UInt32 index)
+   {
+      assert(!store.getSchemeFlag(index) || (store.getSchemeCount(index) == Config::getSingleton()->getTotalTiles()));
+      return store.getSchemeFlag(index);
+   }
+
+   static tile_id_t getOneSharer(DirectoryStore& store, UInt32 index, Random& rand_num)
+   {
+      assert(store.getSchemeFlag(index) || (store.getNumSharers(index) > 0));
+      if (store.getNumSharers(index) > 0)
+         return store.getSharer(index, rand_num.next(store.getNumSharers(index)));
+      else
+         return INVALID_TILE_ID;
+   }
+
+   static void saveSnapshot(DirectoryStore& store, UInt32 index, SnapshotWriter& writer)
+   {
+      writer.write<bool>(store.getSchemeFlag(index));
+      writer.write<UInt32>(store.getSchemeCount(index));
+   }
+   static void loadSnapshot(DirectoryStore& store, UInt32 index, SnapshotReader& reader)
+   {
+      store.setSchemeFlag(index, reader.read<bool>());
+      store.setSchemeCount(index, reader.read<UInt32>());
+   }
+};
+
+#endif /* __DIRECTORY_SCHEME_LIMITED_BROADCAST_H__ */
@@ -0,0 +1,52 @@
+#ifndef __DIRECTORY_SCHEME_LIMITED_NO_BROADCAST_H__
+#define __DIRECTORY_SCHEME_LIMITED_NO_BROADCAST_H__
+
+#include <cassert>
+
+#include "directory_store.h"
+#include "random.h"
+#include "snapshot.h"
+
+// Up to max_hw_sharers sharers; adding one more fails and the caller must
+// invalidate a sharer first. Also used for full_map (max_hw_sharers = max_num_sharers)
+struct DirectorySchemeLimitedNoBroadcast
+{
+   // Return value says whether the sharer was successfully added
+   //              'True' if it was successfully added
+   //              'False' if there will be an eviction before adding
+   static bool addSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id)
+   {
+      assert(!store.hasSharer(index, sharer_id));
+      if (store.getNumSharers(index) == store.getMaxHwSharers())
+         return false;
+
+      store.addSharer(index, sharer_id);
+      return true;
+   }
+
+   static void removeSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id, bool reply_expected)
+   {
+      assert(!reply_expected);
+      assert(store.hasSharer(index, sharer_id));
+      store.removeSharer(index, sharer_id);
+   }
+
+   static UInt32 getNumSharers(DirectoryStore& store, UInt32 index)
+   { return store.getNumSharers(index); }
+
+   static bool isBroadcast(DirectoryStore& store, UInt32 index)
+   { return false; }
+
+   static tile_id_t getOneSharer(DirectoryStore& store, UInt32 index, Random& rand_num)
+   {
+      assert(store.getNumSharers(index) > 0);
+      return store.getSharer(index, rand_num.next(store.getNumSharers(index)));
+   }
+
+   static void saveSnapshot(DirectoryStore& store, UInt32 index, SnapshotWriter& writer)
+   {}
+   static void loadSnapshot(DirectoryStore& store, UInt32 index, SnapshotReader& reader)
+   {}
+};
+
+#endif /* __DIRECTORY_SCHEME_LIMITED_NO_BROADCAST_H__ */
@@ -0,0 +1,60 @@
+#ifndef __DIRECTORY_SCHEME_LIMITLESS_H__
+#define __DIRECTORY_SCHEME_LIMITLESS_H__
+
+#include <cassert>
+
+#include "directory_store.h"
+#include "random.h"
+#include "snapshot.h"
+
+// All sharers are tracked; once there are more than max_hw_sharers, the
+// entry is handled in software (scheme flag set) and every access to it
+// pays the software trap penalty
+struct DirectorySchemeLimitless
+{
+   static bool addSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id)
+   {
+      assert(!store.hasSharer(index, sharer_id));
+
+      // I have to calculate the latency properly here
+      if (store.getNumSharers(index) == store.getMaxHwSharers())
+         store.setSchemeFlag(index, true);
+
+      store.addSharer(index, sharer_id);
+      return true;
+   }
+
+   static void removeSharer(DirectoryStore& store, UInt32 index, tile_id_t sharer_id, bool reply_expected)
+   {
+      assert(!reply_expected);
+      assert(store.hasSharer(index, sharer_id));
+      store.removeSharer(index, sharer_id);
+   }
+
+   static UInt32 getNumSharers(DirectoryStore& store, UInt32 index)
+   { return store.getNumSharers(index); }
+
+   static bool isBroadcast(DirectoryStore& store, UInt32 index)
+   { return false; }
+
+   static tile_id_t getOneSharer(DirectoryStore& store, UInt32 index, Random& rand_num)
+   {
+      tile_id_t sharer_id = store.getSharer(index, 0);
+      assert(sharer_id != INVALID_TILE_ID);
+      return sharer_id;
+   }
+
+   static UInt32 getLatency(DirectoryStore& store, UInt32 index, UInt32 software_trap_penalty)
+   { return store.getSchemeFlag(index) ? software_trap_penalty : 0; }
+
+   static void saveSnapshot(DirectoryStore& store, UInt32 index, SnapshotWriter& writer)
+   {
+      writer.write<bool>(store.getSchemeFlag(index));
+   }
+   static void loadSnapshot(DirectoryStore& store, UInt32 index, SnapshotReader& reader)
+   {
+      store.setSchemeFlag(index, reader.read<bool>());
+   }
+};
+
+#endif /* __DIRECTORY_SCHEME_LIMITLESS_H__ */
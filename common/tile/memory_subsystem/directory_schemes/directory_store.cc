@@ -0,0 +1,109 @@
+#include "directory_store.h"
+#include "log.h"
+
+using namespace std;
+
+DirectoryStore::DirectoryStore(UInt32 num_entries, UInt32 max_hw_sharers, UInt32 max_num_sharers):
+   m_max_hw_sharers(max_hw_sharers),
+   m_max_num_sharers(max_num_sharers),
+   m_sharer_words_per_entry((max_num_sharers + 63) / 64)
+{
+   LOG_ASSERT_ERROR(max_num_sharers < (1 << (32 - DSTATE_BITS)) - 1,
+         "Max num sharers(%u) does not fit the owner field", max_num_sharers);
+
+   m_address_list.resize(num_entries, INVALID_ADDRESS);
+   m_owner_dstate_list.resize(num_entries, 0);
+   m_num_sharers_list.resize(num_entries, 0);
+   m_scheme_state_list.resize(num_entries, 0);
+   m_sharer_bitmap_list.resize(num_entries * m_sharer_words_per_entry, 0);
+}
+
+DirectoryStore::~DirectoryStore()
+{}
+
+UInt32
+DirectoryStore::allocate()
+{
+   if (!m_free_spill_list.empty())
+   {
+      UInt32 index = m_free_spill_list.back();
+      m_free_spill_list.pop_back();
+      return index;
+   }
+
+   UInt32 index = m_address_list.size();
+   m_address_list.push_back(INVALID_ADDRESS);
+   m_owner_dstate_list.push_back(0);
+   m_num_sharers_list.push_back(0);
+   m_scheme_state_list.push_back(0);
+   m_sharer_bitmap_list.resize(m_sharer_bitmap_list.size() + m_sharer_words_per_entry, 0);
+   return index;
+}
+
+void
+DirectoryStore::release(UInt32 index)
+{
+   clear(index);
+   m_free_spill_list.push_back(index);
+}
+
+void
+DirectoryStore::clear(UInt32 index)
+{
+   m_address_list[index] = INVALID_ADDRESS;
+   m_owner_dstate_list[index] = 0;
+   m_num_sharers_list[index] = 0;
+   m_scheme_state_list[index] = 0;
+   for (UInt32 i = 0; i < m_sharer_words_per_entry; i++)
+      m_sharer_bitmap_list[index * m_sharer_words_per_entry + i] = 0;
+}
+
+void
+DirectoryStore::copy(UInt32 dst_index, UInt32 src_index)
+{
+   m_address_list[dst_index] = m_address_list[src_index];
+   m_owner_dstate_list[dst_index] = m_owner_dstate_list[src_index];
+   m_num_sharers_list[dst_index] = m_num_sharers_list[src_index];
+   m_scheme_state_list[dst_index] = m_scheme_state_list[src_index];
+   for (UInt32 i = 0; i < m_sharer_words_per_entry; i++)
+   {
+      m_sharer_bitmap_list[dst_index * m_sharer_words_per_entry + i] =
+         m_sharer_bitmap_list[src_index * m_sharer_words_per_entry + i];
+   }
+}
+
+void
+DirectoryStore::getSharers(UInt32 index, vector<tile_id_t>& sharers)
+{
+   sharers.clear();
+   const UInt64* bitmap = &m_sharer_bitmap_list[index * m_sharer_words_per_entry];
+   for (UInt32 i = 0; (i < m_sharer_words_per_entry) && (sharers.size() < m_num_sharers_list[index]); i++)
+   {
+      UInt64 word = bitmap[i];
+      while (word != 0)
+      {
+         sharers.push_back((i << 6) + __builtin_ctzll(word));
+         word &= (word - 1);
+      }
+   }
+}
+
+tile_id_t
+DirectoryStore::getSharer(UInt32 index, UInt32 n)
+{
+   const UInt64* bitmap = &m_sharer_bitmap_list[index * m_sharer_words_per_entry];
+   for (UInt32 i = 0; i < m_sharer_words_per_entry; i++)
+   {
+      UInt64 word = bitmap[i];
+      UInt32 num_bits = __builtin_popcountll(word);
+      if (n >= num_bits)
+      {
+         n -= num_bits;
+         continue;
+      }
+      for ( ; n > 0; n--)
+         word &= (word - 1);
+      return (i << 6) + __builtin_ctzll(word);
+   }
+   return INVALID_TILE_ID;
+}
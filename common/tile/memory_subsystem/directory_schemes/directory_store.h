@@ -0,0 +1,105 @@
+#ifndef __DIRECTORY_STORE_H__
+#define __DIRECTORY_STORE_H__
+
+#include <vector>
+
+#include "directory_state.h"
+#include "fixed_types.h"
+
+// State of all the entries of a directory, kept as parallel flat arrays
+// indexed by entry number so that a set lookup only touches the address
+// array. Per entry:
+//    address
+//    owner and directory state, packed in one word
+//    sharer bitmap, inline in one array with a fixed stride
+//    number of sharers in the bitmap
+//    one word of scheme state: a flag (broadcast / software trap) and a count
+// Entries past the initial ones are spill entries, allocated for directory
+// entries that have been replaced but still have requests in flight
+class DirectoryStore
+{
+   public:
+      DirectoryStore(UInt32 num_entries, UInt32 max_hw_sharers, UInt32 max_num_sharers);
+      ~DirectoryStore();
+
+      UInt32 getMaxHwSharers() { return m_max_hw_sharers; }
+      UInt32 getMaxNumSharers() { return m_max_num_sharers; }
+
+      // Spill entries
+      UInt32 allocate();
+      void release(UInt32 index);
+
+      void clear(UInt32 index);
+      void copy(UInt32 dst_index, UInt32 src_index);
+
+      IntPtr getAddress(UInt32 index)
+      { return m_address_list[index]; }
+      void setAddress(UInt32 index, IntPtr address)
+      { m_address_list[index] = address; }
+
+      tile_id_t getOwner(UInt32 index)
+      { return ((tile_id_t) (m_owner_dstate_list[index] >> DSTATE_BITS)) - 1; }
+      void setOwner(UInt32 index, tile_id_t owner_id)
+      {
+         m_owner_dstate_list[index] = (((UInt32) (owner_id + 1)) << DSTATE_BITS) |
+                                      (m_owner_dstate_list[index] & DSTATE_MASK);
+      }
+      DirectoryState::dstate_t getDState(UInt32 index)
+      { return (DirectoryState::dstate_t) (m_owner_dstate_list[index] & DSTATE_MASK); }
+      void setDState(UInt32 index, DirectoryState::dstate_t dstate)
+      { m_owner_dstate_list[index] = (m_owner_dstate_list[index] & ~DSTATE_MASK) | (UInt32) dstate; }
+
+      bool hasSharer(UInt32 index, tile_id_t sharer_id)
+      { return (getSharerWord(index, sharer_id) >> (sharer_id & 63)) & 1; }
+      // The sharer must not be present
+      void addSharer(UInt32 index, tile_id_t sharer_id)
+      {
+         getSharerWord(index, sharer_id) |= (((UInt64) 1) << (sharer_id & 63));
+         m_num_sharers_list[index] ++;
+      }
+      // The sharer must be present
+      void removeSharer(UInt32 index, tile_id_t sharer_id)
+      {
+         getSharerWord(index, sharer_id) &= ~(((UInt64) 1) << (sharer_id & 63));
+         m_num_sharers_list[index] --;
+      }
+      UInt32 getNumSharers(UInt32 index)
+      { return m_num_sharers_list[index]; }
+
+      // In increasing order of tile id
+      void getSharers(UInt32 index, std::vector<tile_id_t>& sharers);
+      // The n-th sharer in increasing order of tile id, INVALID_TILE_ID if there is none
+      tile_id_t getSharer(UInt32 index, UInt32 n);
+
+      bool getSchemeFlag(UInt32 index)
+      { return (m_scheme_state_list[index] & SCHEME_FLAG) != 0; }
+      void setSchemeFlag(UInt32 index, bool flag)
+      { m_scheme_state_list[index] = flag ? (m_scheme_state_list[index] | SCHEME_FLAG) : (m_scheme_state_list[index] & ~SCHEME_FLAG); }
+      UInt32 getSchemeCount(UInt32 index)
+      { return m_scheme_state_list[index] & ~SCHEME_FLAG; }
+      void setSchemeCount(UInt32 index, UInt32 count)
+      { m_scheme_state_list[index] = (m_scheme_state_list[index] & SCHEME_FLAG) | count; }
+
+   private:
+      static const UInt32 DSTATE_BITS = 2;
+      static const UInt32 DSTATE_MASK = (1 << DSTATE_BITS) - 1;
+      static const UInt32 SCHEME_FLAG = 0x80000000;
+
+      UInt32 m_max_hw_sharers;
+      UInt32 m_max_num_sharers;
+      UInt32 m_sharer_words_per_entry;
+
+      std::vector<IntPtr> m_address_list;
+      // (owner + 1) << DSTATE_BITS | dstate
+      std::vector<UInt32> m_owner_dstate_list;
+      std::vector<UInt32> m_num_sharers_list;
+      std::vector<UInt32> m_scheme_state_list;
+      std::vector<UInt64> m_sharer_bitmap_list;
+
+      std::vector<UInt32> m_free_spill_list;
+
+      UInt64& getSharerWord(UInt32 index, tile_id_t sharer_id)
+      { return m_sharer_bitmap_list[index * m_sharer_words_per_entry + (sharer_id >> 6)]; }
+};
+
+#endif /* __DIRECTORY_STORE_H__ */
@@ -0,0 +1,227 @@
+#include <sstream>
+#include <algorithm>
+
+#include "dram_access_counter.h"
+#include "simulator.h"
+#include "config.h"
+#include "utils.h"
+#include "log.h"
+
+// Most accessed first
+static bool
+compareRecords(const std::pair<IntPtr, UInt64>& r1, const std::pair<IntPtr, UInt64>& r2)
+{
+   return (r1.second > r2.second);
+}
+
+DramAccessCounter::DramAccessCounter(Mode mode, UInt32 num_access_types,
+      UInt32 sketch_width, UInt32 sketch_depth, UInt32 num_heavy_hitters,
+      UInt64 snapshot_interval, tile_id_t tile_id):
+   m_mode(mode),
+   m_num_access_types(num_access_types),
+   m_snapshot_interval(snapshot_interval),
+   m_num_interval_accesses(0),
+   m_log_sketch_width(0),
+   m_sketch_depth(0),
+   m_num_heavy_hitters(num_heavy_hitters)
+{
+   std::string filename = getFilename(tile_id);
+   m_out.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!m_out.good())
+      LOG_PRINT_WARNING("Could not write DRAM access counts(%s)", filename.c_str());
+
+   UInt64 magic = MAGIC;
+   UInt32 version = VERSION;
+   UInt32 mode_id = m_mode;
+   m_out.write((const char*) &magic, sizeof(magic));
+   m_out.write((const char*) &version, sizeof(version));
+   m_out.write((const char*) &tile_id, sizeof(tile_id));
+   m_out.write((const char*) &mode_id, sizeof(mode_id));
+   m_out.write((const char*) &m_num_access_types, sizeof(m_num_access_types));
+
+   if (m_mode == EXACT)
+   {
+      for (UInt32 i = 0; i < m_num_access_types; i++)
+         m_exact_counts.push_back(new AddressHashMap<UInt64>(10));
+      return;
+   }
+
+   LOG_ASSERT_ERROR(isPower2(sketch_width) && (sketch_width > 1) &&
+         (sketch_depth > 0) && (sketch_depth <= MAX_SKETCH_DEPTH),
+         "Sketch width(%u) must be a power of 2 (> 1) and depth(%u) in [1, %u]",
+         sketch_width, sketch_depth, MAX_SKETCH_DEPTH);
+   m_log_sketch_width = floorLog2(sketch_width);
+   m_sketch_depth = sketch_depth;
+
+   // Odd multipliers for the multiply-shift hash of each row
+   UInt64 seed = 0x9e3779b97f4a7c15ULL;
+   for (UInt32 i = 0; i < m_sketch_depth; i++)
+   {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      m_sketch_seeds.push_back(seed | 1);
+   }
+
+   m_sketch.resize(m_num_access_types, std::vector<UInt64>(m_sketch_depth << m_log_sketch_width, 0));
+   m_heavy_hitters.resize(m_num_access_types,
+         std::vector<Record>(m_num_heavy_hitters, Record(INVALID_ADDRESS, 0)));
+}
+
+DramAccessCounter::~DramAccessCounter()
+{
+   if (m_num_interval_accesses > 0)
+      writeSnapshot();
+   m_out.close();
+
+   for (UInt32 i = 0; i < m_exact_counts.size(); i++)
+      delete m_exact_counts[i];
+}
+
+DramAccessCounter*
+DramAccessCounter::create(UInt32 num_access_types, tile_id_t tile_id)
+{
+   std::string mode_str;
+   UInt32 sketch_width = 0;
+   UInt32 sketch_depth = 0;
+   UInt32 num_heavy_hitters = 0;
+   UInt64 snapshot_interval = 0;
+   try
+   {
+      mode_str = Sim()->getCfg()->getString("perf_model/dram/access_counts/mode", "none");
+      sketch_width = Sim()->getCfg()->getInt("perf_model/dram/access_counts/sketch_width", 2048);
+      sketch_depth = Sim()->getCfg()->getInt("perf_model/dram/access_counts/sketch_depth", 4);
+      num_heavy_hitters = Sim()->getCfg()->getInt("perf_model/dram/access_counts/num_heavy_hitters", 32);
+      snapshot_interval = (UInt64) Sim()->getCfg()->getInt("perf_model/dram/access_counts/snapshot_interval", 1000000);
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read [perf_model/dram/access_counts] params from the config file");
+   }
+
+   if (mode_str == "none")
+      return NULL;
+   else if (mode_str == "approximate")
+      return new DramAccessCounter(APPROXIMATE, num_access_types, sketch_width, sketch_depth, num_heavy_hitters,
+            snapshot_interval, tile_id);
+   else if (mode_str == "exact")
+      return new DramAccessCounter(EXACT, num_access_types, sketch_width, sketch_depth, num_heavy_hitters,
+            snapshot_interval, tile_id);
+   else
+   {
+      LOG_PRINT_ERROR("Unrecognized DRAM access count mode(%s)", mode_str.c_str());
+      return NULL;
+   }
+}
+
+std::string
+DramAccessCounter::getFilename(tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << "dram_access_counts_tile_" << tile_id << ".bin";
+   return Config::getSingleton()->formatOutputFileName(filename.str());
+}
+
+void
+DramAccessCounter::incrementApproximate(IntPtr address, UInt32 access_type)
+{
+   UInt64* sketch = &m_sketch[access_type][0];
+   UInt32 shift = 64 - m_log_sketch_width;
+
+   // Conservative update: only the smallest counters grow
+   UInt64* counters[MAX_SKETCH_DEPTH];
+   UInt64 estimate = ~((UInt64) 0);
+   for (UInt32 i = 0; i < m_sketch_depth; i++)
+   {
+      UInt64 index = (((UInt64) address) * m_sketch_seeds[i]) >> shift;
+      counters[i] = &sketch[(i << m_log_sketch_width) + index];
+      estimate = std::min(estimate, *counters[i]);
+   }
+   estimate ++;
+   for (UInt32 i = 0; i < m_sketch_depth; i++)
+   {
+      if (*counters[i] < estimate)
+         *counters[i] = estimate;
+   }
+
+   // The heavy hitters keep their latest estimates; a new address replaces
+   // the least accessed one once its estimate is larger
+   std::vector<Record>& heavy_hitters = m_heavy_hitters[access_type];
+   UInt32 min_index = 0;
+   for (UInt32 i = 0; i < m_num_heavy_hitters; i++)
+   {
+      if (heavy_hitters[i].first == address)
+      {
+         heavy_hitters[i].second = estimate;
+         return;
+      }
+      if (heavy_hitters[i].second < heavy_hitters[min_index].second)
+         min_index = i;
+   }
+   if ((m_num_heavy_hitters > 0) && (estimate > heavy_hitters[min_index].second))
+      heavy_hitters[min_index] = Record(address, estimate);
+}
+
+void
+DramAccessCounter::getRecords(UInt32 access_type, std::vector<Record>& records)
+{
+   if (m_mode == EXACT)
+   {
+      AddressHashMap<UInt64>* counts = m_exact_counts[access_type];
+      records.reserve(counts->size());
+      for (UInt32 i = 0; i < counts->capacity(); i++)
+      {
+         if (counts->keyAt(i) != INVALID_ADDRESS)
+            records.push_back(Record(counts->keyAt(i), counts->valueAt(i)));
+      }
+   }
+   else
+   {
+      std::vector<Record>& heavy_hitters = m_heavy_hitters[access_type];
+      for (UInt32 i = 0; i < m_num_heavy_hitters; i++)
+      {
+         if (heavy_hitters[i].first != INVALID_ADDRESS)
+            records.push_back(heavy_hitters[i]);
+      }
+   }
+   std::sort(records.begin(), records.end(), compareRecords);
+}
+
+void
+DramAccessCounter::writeSnapshot()
+{
+   m_out.write((const char*) &m_num_interval_accesses, sizeof(m_num_interval_accesses));
+   for (UInt32 k = 0; k < m_num_access_types; k++)
+   {
+      std::vector<Record> records;
+      getRecords(k, records);
+
+      UInt64 num_records = records.size();
+      m_out.write((const char*) &num_records, sizeof(num_records));
+      for (std::vector<Record>::iterator it = records.begin(); it != records.end(); it++)
+      {
+         UInt64 address = it->first;
+         m_out.write((const char*) &address, sizeof(address));
+         m_out.write((const char*) &it->second, sizeof(it->second));
+      }
+   }
+   m_out.flush();
+
+   clearCounts();
+}
+
+void
+DramAccessCounter::clearCounts()
+{
+   m_num_interval_accesses = 0;
+   for (UInt32 k = 0; k < m_num_access_types; k++)
+   {
+      if (m_mode == EXACT)
+      {
+         m_exact_counts[k]->clear();
+      }
+      else
+      {
+         std::fill(m_sketch[k].begin(), m_sketch[k].end(), 0);
+         std::fill(m_heavy_hitters[k].begin(), m_heavy_hitters[k].end(), Record(INVALID_ADDRESS, 0));
+      }
+   }
+}
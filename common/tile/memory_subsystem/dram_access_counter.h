@@ -0,0 +1,89 @@
+#ifndef __DRAM_ACCESS_COUNTER_H__
+#define __DRAM_ACCESS_COUNTER_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "address_hash_map.h"
+#include "fixed_types.h"
+
+// Per-address access counts of a DRAM controller, in bounded memory
+// ([perf_model/dram/access_counts]):
+//    approximate - a count-min sketch (with conservative update) per access
+//                  type, and a table of the K most accessed addresses
+//    exact       - every address, in an AddressHashMap
+// The counts are streamed to a binary file (getFilename()) as a snapshot
+// every 'snapshot_interval' accesses, plus one for the rest at the end.
+// A snapshot has the counts of its interval only, and the counts are
+// cleared after it is written:
+//    header:       UInt64 magic, UInt32 version, SInt32 tile id,
+//                  UInt32 mode, UInt32 number of access types
+//    per snapshot: UInt64 number of accesses in the interval, then per type:
+//                  UInt64 number of records, then {UInt64 address, UInt64 count}
+//                  records, the most accessed first
+class DramAccessCounter
+{
+   public:
+      enum Mode
+      {
+         APPROXIMATE = 1,
+         EXACT
+      };
+
+      static const UInt64 MAGIC = 0x544e434d41524447ULL;   // "GDRAMCNT"
+      static const UInt32 VERSION = 2;
+
+      DramAccessCounter(Mode mode, UInt32 num_access_types,
+            UInt32 sketch_width, UInt32 sketch_depth, UInt32 num_heavy_hitters,
+            UInt64 snapshot_interval, tile_id_t tile_id);
+      // Writes the last snapshot
+      ~DramAccessCounter();
+
+      // NULL if the counts are disabled
+      static DramAccessCounter* create(UInt32 num_access_types, tile_id_t tile_id);
+      static std::string getFilename(tile_id_t tile_id);
+
+      void increment(IntPtr address, UInt32 access_type)
+      {
+         if (m_mode == EXACT)
+            (*m_exact_counts[access_type])[address] ++;
+         else
+            incrementApproximate(address, access_type);
+
+         // Never equal for an interval of 0 (one snapshot, at the end)
+         m_num_interval_accesses ++;
+         if (m_num_interval_accesses == m_snapshot_interval)
+            writeSnapshot();
+      }
+
+   private:
+      typedef std::pair<IntPtr, UInt64> Record;
+
+      static const UInt32 MAX_SKETCH_DEPTH = 16;
+
+      Mode m_mode;
+      UInt32 m_num_access_types;
+
+      UInt64 m_snapshot_interval;
+      UInt64 m_num_interval_accesses;
+      std::ofstream m_out;
+
+      // Sketch rows of 2^m_log_sketch_width counters, per access type
+      UInt32 m_log_sketch_width;
+      UInt32 m_sketch_depth;
+      std::vector<UInt64> m_sketch_seeds;
+      std::vector<std::vector<UInt64> > m_sketch;
+
+      UInt32 m_num_heavy_hitters;
+      std::vector<std::vector<Record> > m_heavy_hitters;
+
+      std::vector<AddressHashMap<UInt64>*> m_exact_counts;
+
+      void incrementApproximate(IntPtr address, UInt32 access_type);
+      void getRecords(UInt32 access_type, std::vector<Record>& records);
+      void writeSnapshot();
+      void clearCounts();
+};
+
+#endif /* __DRAM_ACCESS_COUNTER_H__ */
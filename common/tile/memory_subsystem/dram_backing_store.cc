@@ -0,0 +1,145 @@
+#include <sys/mman.h>
+#include <string.h>
+#include <errno.h>
+
+#include "dram_backing_store.h"
+#include "log.h"
+
+DramBackingStore::DramBackingStore()
+{
+   for (UInt32 i = 0; i < DIRECTORY_SIZE; i++)
+      m_directory[i] = NULL;
+}
+
+DramBackingStore::~DramBackingStore()
+{
+   for (UInt32 i = 0; i < DIRECTORY_SIZE; i++)
+   {
+      if (m_directory[i] == NULL)
+         continue;
+      for (UInt32 j = 0; j < LEAF_SIZE; j++)
+      {
+         Chunk* chunk = m_directory[i][j];
+         if (chunk != NULL)
+         {
+            munmap(chunk->data, CHUNK_SIZE);
+            delete chunk;
+         }
+      }
+      delete [] m_directory[i];
+   }
+}
+
+DramBackingStore::Chunk*
+DramBackingStore::findChunk(IntPtr address)
+{
+   UInt64 chunk_num = ((UInt64) address) >> LOG_CHUNK_SIZE;
+   Chunk** leaf = m_directory[(chunk_num >> LOG_LEAF_SIZE) & (DIRECTORY_SIZE - 1)];
+   if (leaf == NULL)
+      return NULL;
+   return leaf[chunk_num & (LEAF_SIZE - 1)];
+}
+
+DramBackingStore::Chunk*
+DramBackingStore::allocateChunk(IntPtr address)
+{
+   LOG_ASSERT_ERROR(((UInt64) address >> ADDRESS_BITS) == 0,
+         "Address(%#llx) is wider than %u bits", (UInt64) address, ADDRESS_BITS);
+
+   UInt64 chunk_num = ((UInt64) address) >> LOG_CHUNK_SIZE;
+   Chunk**& leaf = m_directory[chunk_num >> LOG_LEAF_SIZE];
+   if (leaf == NULL)
+   {
+      leaf = new Chunk*[LEAF_SIZE];
+      memset(leaf, 0x00, LEAF_SIZE * sizeof(Chunk*));
+   }
+
+   Chunk*& chunk = leaf[chunk_num & (LEAF_SIZE - 1)];
+   if (chunk == NULL)
+   {
+      void* data = mmap(NULL, CHUNK_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      LOG_ASSERT_ERROR(data != MAP_FAILED, "Could not map DRAM backing store chunk: %s", strerror(errno));
+
+      chunk = new Chunk();
+      chunk->data = (Byte*) data;
+      memset(chunk->touched_pages, 0x00, sizeof(chunk->touched_pages));
+   }
+   return chunk;
+}
+
+bool
+DramBackingStore::contains(IntPtr address)
+{
+   if (((UInt64) address >> ADDRESS_BITS) != 0)
+      return false;
+   Chunk* chunk = findChunk(address);
+   if (chunk == NULL)
+      return false;
+
+   UInt32 page_index = (address & (CHUNK_SIZE - 1)) >> LOG_PAGE_SIZE;
+   return (chunk->touched_pages[page_index >> 6] >> (page_index & 63)) & 1;
+}
+
+void
+DramBackingStore::saveSnapshot(SnapshotWriter& writer)
+{
+   UInt64 num_pages = 0;
+   for (UInt32 i = 0; i < DIRECTORY_SIZE; i++)
+   {
+      if (m_directory[i] == NULL)
+         continue;
+      for (UInt32 j = 0; j < LEAF_SIZE; j++)
+      {
+         Chunk* chunk = m_directory[i][j];
+         if (chunk == NULL)
+            continue;
+         for (UInt32 k = 0; k < PAGES_PER_CHUNK / 64; k++)
+            num_pages += __builtin_popcountll(chunk->touched_pages[k]);
+      }
+   }
+
+   writer.write<UInt64>(num_pages);
+   for (UInt32 i = 0; i < DIRECTORY_SIZE; i++)
+   {
+      if (m_directory[i] == NULL)
+         continue;
+      for (UInt32 j = 0; j < LEAF_SIZE; j++)
+      {
+         Chunk* chunk = m_directory[i][j];
+         if (chunk == NULL)
+            continue;
+
+         UInt64 chunk_address = ((((UInt64) i) << LOG_LEAF_SIZE) + j) << LOG_CHUNK_SIZE;
+         for (UInt32 page_index = 0; page_index < PAGES_PER_CHUNK; page_index++)
+         {
+            if (((chunk->touched_pages[page_index >> 6] >> (page_index & 63)) & 1) == 0)
+               continue;
+            writer.write<UInt64>(chunk_address + (page_index << LOG_PAGE_SIZE));
+            writer.writeBytes(&chunk->data[page_index << LOG_PAGE_SIZE], PAGE_SIZE);
+         }
+      }
+   }
+}
+
+void
+DramBackingStore::loadSnapshot(SnapshotReader& reader)
+{
+   UInt64 num_pages = reader.read<UInt64>();
+   for (UInt64 i = 0; i < num_pages; i++)
+   {
+      IntPtr page_address = (IntPtr) reader.read<UInt64>();
+      reader.readBytes(getBlock(page_address), PAGE_SIZE);
+   }
+}
+
+void
+DramBackingStore::skipSnapshot(SnapshotReader& reader)
+{
+   UInt64 num_pages = reader.read<UInt64>();
+   for (UInt64 i = 0; i < num_pages; i++)
+   {
+      reader.skip(sizeof(UInt64));
+      reader.skip(PAGE_SIZE);
+   }
+}
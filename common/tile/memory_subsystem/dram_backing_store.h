@@ -0,0 +1,73 @@
+#ifndef __DRAM_BACKING_STORE_H__
+#define __DRAM_BACKING_STORE_H__
+
+#include "fixed_types.h"
+#include "snapshot.h"
+
+// Functional contents of the memory behind a DRAM controller.
+// The address space is covered by 2 MB chunks, mapped on first touch and
+// found through a two-level radix table indexed by address bits, so a
+// lookup is two loads and there is no per-block allocation. Chunks are
+// anonymous mappings: the OS zero-fills each 4 KB page when it is first
+// touched, so untouched memory costs nothing. A per-chunk bitmap records
+// the touched pages for snapshots.
+class DramBackingStore
+{
+   public:
+      DramBackingStore();
+      ~DramBackingStore();
+
+      // Zero-filled on first touch. A block never straddles a page
+      Byte* getBlock(IntPtr address)
+      {
+         Chunk* chunk = getChunk(address);
+         UInt32 chunk_offset = address & (CHUNK_SIZE - 1);
+         UInt32 page_index = chunk_offset >> LOG_PAGE_SIZE;
+         chunk->touched_pages[page_index >> 6] |= (((UInt64) 1) << (page_index & 63));
+         return &chunk->data[chunk_offset];
+      }
+      // Whether the page holding 'address' has been touched
+      bool contains(IntPtr address);
+
+      // Touched pages only
+      void saveSnapshot(SnapshotWriter& writer);
+      void loadSnapshot(SnapshotReader& reader);
+      static void skipSnapshot(SnapshotReader& reader);
+
+   private:
+      static const UInt32 ADDRESS_BITS = 48;
+      static const UInt32 LOG_PAGE_SIZE = 12;
+      static const UInt32 PAGE_SIZE = 1 << LOG_PAGE_SIZE;
+      static const UInt32 LOG_CHUNK_SIZE = 21;
+      static const UInt32 CHUNK_SIZE = 1 << LOG_CHUNK_SIZE;
+      static const UInt32 PAGES_PER_CHUNK = CHUNK_SIZE / PAGE_SIZE;
+      // Chunk number = (directory index, leaf index)
+      static const UInt32 LOG_LEAF_SIZE = 14;
+      static const UInt32 LEAF_SIZE = 1 << LOG_LEAF_SIZE;
+      static const UInt32 DIRECTORY_SIZE = 1 << (ADDRESS_BITS - LOG_CHUNK_SIZE - LOG_LEAF_SIZE);
+
+      struct Chunk
+      {
+         Byte* data;
+         UInt64 touched_pages[PAGES_PER_CHUNK / 64];
+      };
+
+      Chunk** m_directory[DIRECTORY_SIZE];
+
+      Chunk* getChunk(IntPtr address)
+      {
+         UInt64 chunk_num = ((UInt64) address) >> LOG_CHUNK_SIZE;
+         Chunk** leaf = m_directory[(chunk_num >> LOG_LEAF_SIZE) & (DIRECTORY_SIZE - 1)];
+         if ((leaf != NULL) && (((UInt64) address >> ADDRESS_BITS) == 0))
+         {
+            Chunk* chunk = leaf[chunk_num & (LEAF_SIZE - 1)];
+            if (chunk != NULL)
+               return chunk;
+         }
+         return allocateChunk(address);
+      }
+      Chunk* findChunk(IntPtr address);
+      Chunk* allocateChunk(IntPtr address);
+};
+
+#endif /* __DRAM_BACKING_STORE_H__ */
@@ -0,0 +1,106 @@
+#include <cassert>
+
+#include "home_page_table.h"
+#include "log.h"
+
+HomePageTable::HomePageTable(UInt32 log_page_size):
+   m_log_page_size(log_page_size)
+{
+   UInt32 page_num_bits = (8 * sizeof(IntPtr)) - m_log_page_size;
+   m_num_levels = (page_num_bits + LEVEL_BITS - 1) / LEVEL_BITS;
+   LOG_ASSERT_ERROR(m_num_levels >= 1, "Page size(2^%u) too large", m_log_page_size);
+
+   m_root = new void*[LEVEL_SIZE];
+   for (UInt32 i = 0; i < LEVEL_SIZE; i++)
+      m_root[i] = NULL;
+   if (m_num_levels == 1)
+   {
+      // The root is the only leaf
+      tile_id_t* leaf = (tile_id_t*) m_root;
+      for (UInt32 i = 0; i < LEVEL_SIZE; i++)
+         leaf[i] = INVALID_TILE_ID;
+   }
+}
+
+HomePageTable::~HomePageTable()
+{
+   freeNode(m_root, m_num_levels - 1);
+}
+
+void
+HomePageTable::freeNode(void** node, UInt32 level)
+{
+   if (level > 0)
+   {
+      for (UInt32 i = 0; i < LEVEL_SIZE; i++)
+      {
+         if (node[i] != NULL)
+            freeNode((void**) node[i], level - 1);
+      }
+   }
+   delete [] node;
+}
+
+tile_id_t*
+HomePageTable::getLeaf(IntPtr page_num, bool allocate)
+{
+   void** node = m_root;
+   for (UInt32 level = m_num_levels - 1; level > 0; level--)
+   {
+      UInt32 index = (page_num >> (level * LEVEL_BITS)) & (LEVEL_SIZE - 1);
+      void* child = *((void* volatile*) &node[index]);
+      if (child == NULL)
+      {
+         if (!allocate)
+            return NULL;
+
+         // Every node has the size of a pointer array; leaves hold tile ids
+         void** new_child = new void*[LEVEL_SIZE];
+         if (level == 1)
+         {
+            tile_id_t* leaf = (tile_id_t*) new_child;
+            for (UInt32 i = 0; i < LEVEL_SIZE; i++)
+               leaf[i] = INVALID_TILE_ID;
+         }
+         else
+         {
+            for (UInt32 i = 0; i < LEVEL_SIZE; i++)
+               new_child[i] = NULL;
+         }
+
+         child = __sync_val_compare_and_swap(&node[index], (void*) NULL, (void*) new_child);
+         if (child == NULL)
+         {
+            child = new_child;
+         }
+         else
+         {
+            // Another thread got there first
+            delete [] new_child;
+         }
+      }
+      node = (void**) child;
+   }
+   return (tile_id_t*) node;
+}
+
+tile_id_t
+HomePageTable::lookup(IntPtr address)
+{
+   IntPtr page_num = address >> m_log_page_size;
+   tile_id_t* leaf = getLeaf(page_num, false);
+   if (leaf == NULL)
+      return INVALID_TILE_ID;
+   return *((volatile tile_id_t*) &leaf[page_num & (LEVEL_SIZE - 1)]);
+}
+
+tile_id_t
+HomePageTable::insert(IntPtr address, tile_id_t home)
+{
+   assert(home != INVALID_TILE_ID);
+
+   IntPtr page_num = address >> m_log_page_size;
+   tile_id_t* leaf = getLeaf(page_num, true);
+   tile_id_t prev_home = __sync_val_compare_and_swap(&leaf[page_num & (LEVEL_SIZE - 1)], INVALID_TILE_ID, home);
+   return (prev_home == INVALID_TILE_ID) ? home : prev_home;
+}
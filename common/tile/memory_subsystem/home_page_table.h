@@ -0,0 +1,35 @@
+#ifndef __HOME_PAGE_TABLE_H__
+#define __HOME_PAGE_TABLE_H__
+
+#include "fixed_types.h"
+
+// Map from pages to the tiles that are their (DRAM directory) homes,
+// shared by all the tiles of a process.
+// A radix tree whose nodes are allocated on first use. Both the nodes and
+// the entries are only ever set once, from NULL (INVALID_TILE_ID), with a
+// compare-and-swap, so neither lookups nor inserts take a lock
+class HomePageTable
+{
+   private:
+      static const UInt32 LEVEL_BITS = 13;
+      static const UInt32 LEVEL_SIZE = 1 << LEVEL_BITS;
+
+      UInt32 m_log_page_size;
+      UInt32 m_num_levels;
+      void** m_root;
+
+      tile_id_t* getLeaf(IntPtr page_num, bool allocate);
+      void freeNode(void** node, UInt32 level);
+
+   public:
+      HomePageTable(UInt32 log_page_size);
+      ~HomePageTable();
+
+      // INVALID_TILE_ID if the page of 'address' is not mapped
+      tile_id_t lookup(IntPtr address);
+      // Maps the page of 'address' to 'home' unless it is already mapped.
+      // Returns the home of the page
+      tile_id_t insert(IntPtr address, tile_id_t home);
+};
+
+#endif /* __HOME_PAGE_TABLE_H__ */
@@ -14,7 +14,10 @@ class MemComponent
          L2_CACHE,
          DRAM_DIR,
          DRAM,
-         MAX_MEM_COMPONENT = DRAM,
+         // L1 Caches of the PEP core
+         L1_PEP_ICACHE,
+         L1_PEP_DCACHE,
+         MAX_MEM_COMPONENT = L1_PEP_DCACHE,
          NUM_MEM_COMPONENTS = MAX_MEM_COMPONENT - MIN_MEM_COMPONENT + 1
       };
 };
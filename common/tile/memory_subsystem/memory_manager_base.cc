@@ -1,8 +1,13 @@
 using namespace std;
 
+#include <sstream>
+#include <algorithm>
+
 #include "simulator.h"
 #include "config.h"
 #include "memory_manager_base.h"
+#include "snapshot.h"
+#include "cache.h"
 #include "pr_l1_pr_l2_dram_directory_msi/memory_manager.h"
 #include "pr_l1_pr_l2_dram_directory_mosi/memory_manager.h"
 #include "log.h"
@@ -12,19 +17,69 @@ MemoryManagerBase::createMMU(std::string protocol_type,
       Tile* tile, Network* network, ShmemPerfModel* shmem_perf_model)
 {
    CachingProtocol_t caching_protocol = parseProtocolType(protocol_type);
+   MemoryManagerBase* memory_manager = NULL;
 
    switch (caching_protocol)
    {
       case PR_L1_PR_L2_DRAM_DIRECTORY_MSI:
-         return new PrL1PrL2DramDirectoryMSI::MemoryManager(tile, network, shmem_perf_model);
+         memory_manager = new PrL1PrL2DramDirectoryMSI::MemoryManager(tile, network, shmem_perf_model);
+         break;
 
       case PR_L1_PR_L2_DRAM_DIRECTORY_MOSI:
-         return new PrL1PrL2DramDirectoryMOSI::MemoryManager(tile, network, shmem_perf_model);
+         memory_manager = new PrL1PrL2DramDirectoryMOSI::MemoryManager(tile, network, shmem_perf_model);
+         break;
 
       default:
          LOG_PRINT_ERROR("Unsupported Caching Protocol (%u)", caching_protocol);
          return NULL;
    }
+
+   // Start from a warmed-up memory system, before the models are enabled
+   std::string snapshot_load_dir = Config::getSingleton()->getSnapshotLoadDir();
+   if (snapshot_load_dir != "")
+      memory_manager->loadSnapshot(Snapshot::getFilename(snapshot_load_dir, tile->getId()));
+
+   return memory_manager;
+}
+
+UInt32
+MemoryManagerBase::coreInitiateMemoryAccessRange(
+      MemComponent::component_t mem_component,
+      Core::lock_signal_t lock_signal,
+      Core::mem_op_t mem_op_type,
+      IntPtr address,
+      Byte* data_buf, UInt32 data_size,
+      bool modeled)
+{
+   UInt32 cache_block_size = getCacheBlockSize();
+   UInt32 num_misses = 0;
+
+   IntPtr end_address = address + data_size;
+   while (address < end_address)
+   {
+      IntPtr ca_address = address - (address % cache_block_size);
+      UInt32 offset = address - ca_address;
+      UInt32 length = std::min((IntPtr) (cache_block_size - offset), end_address - address);
+
+      if (!coreInitiateMemoryAccess(mem_component, lock_signal, mem_op_type,
+               ca_address, offset, data_buf, length, modeled))
+      {
+         num_misses ++;
+      }
+
+      address += length;
+      data_buf += length;
+   }
+   return num_misses;
+}
+
+void
+MemoryManagerBase::attachCacheHeatmap(Cache* cache)
+{
+   std::ostringstream filename;
+   filename << "cache_heatmap_tile_" << getTile()->getId() << "_" << cache->getName() << ".csv";
+   cache->setHeatmap(new CacheHeatmap(Config::getSingleton()->formatOutputFileName(filename.str()),
+         cache->getNumSets(), cache->getAssociativity(), getCacheBlockSize()));
 }
 
 MemoryManagerBase::CachingProtocol_t
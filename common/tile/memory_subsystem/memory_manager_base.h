@@ -9,6 +9,8 @@ using namespace std;
 #include "mem_component.h"
 #include "shmem_perf_model.h"
 
+class Cache;
+
 void MemoryManagerNetworkCallback(void* obj, NetPacket packet);
 
 class MemoryManagerBase
@@ -35,6 +37,8 @@ class MemoryManagerBase
 
       vector<tile_id_t> getTileListWithMemoryControllers(void);
       void printTileListWithMemoryControllers(vector<tile_id_t>& tile_list_with_memory_controllers);
+      // Per-set statistics of 'cache', written next to the simulation output
+      void attachCacheHeatmap(Cache* cache);
    
    public:
       MemoryManagerBase(Tile* tile, Network* network, ShmemPerfModel* shmem_perf_model):
@@ -51,6 +55,16 @@ class MemoryManagerBase
             IntPtr address, UInt32 offset,
             Byte* data_buf, UInt32 data_length,
             bool modeled) = 0;
+      // Access [address, address + data_size), which may span several cache
+      // lines. Returns the number of lines that missed. The default accesses
+      // the lines one at a time through coreInitiateMemoryAccess()
+      virtual UInt32 coreInitiateMemoryAccessRange(
+            MemComponent::component_t mem_component,
+            Core::lock_signal_t lock_signal,
+            Core::mem_op_t mem_op_type,
+            IntPtr address,
+            Byte* data_buf, UInt32 data_size,
+            bool modeled);
 
       virtual void handleMsgFromNetwork(NetPacket& packet) = 0;
 
@@ -65,6 +79,10 @@ class MemoryManagerBase
       virtual void disableModels() = 0;
       virtual void resetModels() = 0;
 
+      // Warmed cache, directory and DRAM state of this tile (see snapshot.h)
+      virtual void saveSnapshot(std::string filename) = 0;
+      virtual void loadSnapshot(std::string filename) = 0;
+
       // Modeling
       virtual UInt32 getModeledLength(const void* pkt_data) = 0;
       virtual bool isModeled(const void* pkt_data) = 0;
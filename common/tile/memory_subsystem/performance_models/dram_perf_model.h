@@ -1,65 +1,54 @@
 #ifndef __DRAM_PERF_MODEL_H__
 #define __DRAM_PERF_MODEL_H__
 
-#include "queue_model.h"
+#include <iostream>
+#include <string>
+using namespace std;
+
 #include "fixed_types.h"
-#include "moving_average.h"
 
 // Note: Each Dram Controller owns a single DramModel object
-// Hence, m_dram_bandwidth is the bandwidth for a single DRAM controller
-// Total Bandwidth = m_dram_bandwidth * Number of DRAM controllers
-// Number of DRAM controllers presently = Number of Cores
-// m_dram_bandwidth is expressed in GB/s
-// Assuming the frequency of a core is 1GHz, 
-// m_dram_bandwidth is also expressed in 'Bytes per clock cycle'
-// This DRAM model is not entirely correct.
-// It sort of increases the queueing delay to a huge value if
-// the arrival times of adjacent packets are spread over a large
-// simulated time period
+// Times are in ns (i.e., cycles of a 1GHz clock)
+// The model is chosen with perf_model/dram/type:
+//    basic:  fixed access latency plus a bandwidth queue model
+//    banked: channels, ranks and banks with row buffers, FR-FCFS scheduling
 class DramPerfModel
 {
-   private:
-      // Dram Model Parameters
-      UInt64 m_dram_access_cost;
-      volatile float m_dram_bandwidth;
-
-      UInt32 m_cache_block_size;
-
-      // Queue Model
-      QueueModel* m_queue_model;
-      std::string m_queue_model_type;
-      bool m_queue_model_enabled;
-      
-      bool m_enabled;
-
-      // Performance Counters
-      UInt64 m_num_accesses;
-      volatile double m_total_access_latency;
-      volatile double m_total_queueing_delay;
-
-      void createQueueModels();
-      void destroyQueueModels();
-      void resetQueueModels();
-      void initializePerformanceCounters();
-
    public:
-      DramPerfModel(float dram_access_cost, 
+      static DramPerfModel* create(float dram_access_cost,
             float dram_bandwidth,
             bool queue_model_enabled,
-            std::string queue_model_type, 
+            std::string queue_model_type,
             UInt32 cache_block_size);
 
-      ~DramPerfModel();
+      virtual ~DramPerfModel();
 
-      UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, tile_id_t requester);
+      virtual UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, tile_id_t requester, IntPtr address) = 0;
       void enable();
       void disable();
-      void reset();
+      virtual void reset();
 
       UInt64 getTotalAccesses() { return m_num_accesses; }
-      void outputSummary(ostream& out);
+      virtual void outputSummary(ostream& out);
 
       static void dummyOutputSummary(ostream& out);
+
+   protected:
+      DramPerfModel();
+
+      // Accesses are not modeled while disabled, nor for the thread spawner tiles
+      bool isModeled(tile_id_t requester);
+      void updateCounters(UInt64 access_latency, UInt64 queue_delay);
+
+   private:
+      bool m_enabled;
+
+      // Performance Counters
+      UInt64 m_num_accesses;
+      volatile double m_total_access_latency;
+      volatile double m_total_queueing_delay;
+
+      void initializePerformanceCounters();
 };
 
 #endif /* __DRAM_PERF_MODEL_H__ */
@@ -0,0 +1,255 @@
+#include <algorithm>
+using namespace std;
+
+#include "simulator.h"
+#include "config.h"
+#include "dram_perf_model_banked.h"
+#include "utils.h"
+#include "log.h"
+
+DramPerfModelBanked::DramPerfModelBanked(UInt32 cache_block_size):
+   DramPerfModel()
+{
+   UInt32 row_size = 0;
+   string page_policy;
+   string address_mapping;
+
+   try
+   {
+      m_num_channels = Sim()->getCfg()->getInt("perf_model/dram/banked/num_channels");
+      m_num_ranks = Sim()->getCfg()->getInt("perf_model/dram/banked/num_ranks");
+      m_num_banks = Sim()->getCfg()->getInt("perf_model/dram/banked/num_banks");
+      row_size = Sim()->getCfg()->getInt("perf_model/dram/banked/row_size");
+      page_policy = Sim()->getCfg()->getString("perf_model/dram/banked/page_policy");
+      address_mapping = Sim()->getCfg()->getString("perf_model/dram/banked/address_mapping");
+      m_t_rcd = Sim()->getCfg()->getInt("perf_model/dram/banked/t_rcd");
+      m_t_cas = Sim()->getCfg()->getInt("perf_model/dram/banked/t_cas");
+      m_t_rp = Sim()->getCfg()->getInt("perf_model/dram/banked/t_rp");
+      m_t_ras = Sim()->getCfg()->getInt("perf_model/dram/banked/t_ras");
+      m_t_burst = Sim()->getCfg()->getInt("perf_model/dram/banked/t_burst");
+   }
+   catch (...)
+   {
+      LOG_PRINT_ERROR("Could not read parameters from the config file");
+   }
+
+   if (page_policy == "open")
+      m_page_policy = OPEN_PAGE;
+   else if (page_policy == "closed")
+      m_page_policy = CLOSED_PAGE;
+   else
+      LOG_PRINT_ERROR("Unrecognized Page Policy(%s)", page_policy.c_str());
+
+   LOG_ASSERT_ERROR(isPower2(m_num_channels) && isPower2(m_num_ranks) && isPower2(m_num_banks),
+         "Number of channels(%u), ranks(%u) and banks(%u) must be powers of 2",
+         m_num_channels, m_num_ranks, m_num_banks);
+   LOG_ASSERT_ERROR(isPower2(row_size) && (row_size >= cache_block_size),
+         "Row size(%u) must be a power of 2 and at least the cache block size(%u)",
+         row_size, cache_block_size);
+
+   parseAddressMapping(address_mapping, row_size);
+
+   m_banks.resize(m_num_channels * m_num_ranks * m_num_banks);
+   m_bus_free_time.resize(m_num_channels);
+   initializeBanks();
+   initializePerformanceCounters();
+}
+
+DramPerfModelBanked::~DramPerfModelBanked()
+{}
+
+void
+DramPerfModelBanked::parseAddressMapping(string address_mapping, UInt32 row_size)
+{
+   vector<string> fields;
+   parseList(address_mapping, fields, ":");
+   LOG_ASSERT_ERROR(fields.size() == NUM_ADDRESS_FIELDS,
+         "Address mapping(%s) must list row, rank, bank, channel and column", address_mapping.c_str());
+
+   UInt32 field_width[NUM_ADDRESS_FIELDS];
+   field_width[RANK] = floorLog2(m_num_ranks);
+   field_width[BANK] = floorLog2(m_num_banks);
+   field_width[CHANNEL] = floorLog2(m_num_channels);
+   field_width[COLUMN] = floorLog2(row_size);
+   field_width[ROW] = ADDRESS_BITS - field_width[RANK] - field_width[BANK] - field_width[CHANNEL] - field_width[COLUMN];
+
+   bool seen[NUM_ADDRESS_FIELDS] = { false, false, false, false, false };
+   // Fields are listed MSB to LSB, so assign the shifts from the back
+   UInt32 shift = 0;
+   for (SInt32 i = NUM_ADDRESS_FIELDS - 1; i >= 0; i--)
+   {
+      string name = trimSpaces(fields[i]);
+      AddressField field;
+      if (name == "row")
+         field = ROW;
+      else if (name == "rank")
+         field = RANK;
+      else if (name == "bank")
+         field = BANK;
+      else if (name == "channel")
+         field = CHANNEL;
+      else if (name == "column")
+         field = COLUMN;
+      else
+      {
+         LOG_PRINT_ERROR("Unrecognized Address Field(%s)", name.c_str());
+         return;
+      }
+      LOG_ASSERT_ERROR(!seen[field], "Address Field(%s) listed twice", name.c_str());
+      seen[field] = true;
+
+      m_field_shift[field] = shift;
+      m_field_mask[field] = (((UInt64) 1) << field_width[field]) - 1;
+      shift += field_width[field];
+   }
+}
+
+void
+DramPerfModelBanked::initializeBanks()
+{
+   for (vector<Bank>::iterator it = m_banks.begin(); it != m_banks.end(); it++)
+   {
+      (*it).row_open = false;
+      (*it).open_row = 0;
+      (*it).ready_time = 0;
+      (*it).activate_time = 0;
+      (*it).column_ready_time = 0;
+      (*it).closing = false;
+      (*it).closing_row = 0;
+      (*it).close_time = 0;
+      (*it).closing_column_ready_time = 0;
+   }
+   for (UInt32 i = 0; i < m_num_channels; i++)
+      m_bus_free_time[i] = 0;
+}
+
+void
+DramPerfModelBanked::initializePerformanceCounters()
+{
+   m_num_row_hits = 0;
+   m_num_row_misses = 0;
+   m_num_row_conflicts = 0;
+   m_num_reordered_row_hits = 0;
+}
+
+UInt64
+DramPerfModelBanked::getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, tile_id_t requester, IntPtr address)
+{
+   if (!isModeled(requester))
+   {
+      return 0;
+   }
+
+   UInt32 channel = getField(address, CHANNEL);
+   UInt32 bank_index = (channel * m_num_ranks + getField(address, RANK)) * m_num_banks + getField(address, BANK);
+   UInt64 row = getField(address, ROW);
+   Bank& bank = m_banks[bank_index];
+
+   UInt64 column_time;
+   UInt64 unloaded_latency;
+   bool reordered = false;
+
+   if (bank.row_open && (bank.open_row == row))
+   {
+      // Row hit
+      column_time = max<UInt64>(pkt_time, bank.column_ready_time);
+      bank.column_ready_time = column_time + m_t_burst;
+      unloaded_latency = m_t_cas + m_t_burst;
+      m_num_row_hits ++;
+   }
+   else if (bank.closing && (bank.closing_row == row) &&
+            (max<UInt64>(pkt_time, bank.closing_column_ready_time) + m_t_burst <= bank.close_time))
+   {
+      // The row is still open until the pending PRECHARGE: schedule the
+      // request ahead of it (first-ready)
+      column_time = max<UInt64>(pkt_time, bank.closing_column_ready_time);
+      bank.closing_column_ready_time = column_time + m_t_burst;
+      unloaded_latency = m_t_cas + m_t_burst;
+      reordered = true;
+      m_num_row_hits ++;
+      m_num_reordered_row_hits ++;
+   }
+   else if (!bank.row_open)
+   {
+      // Row miss: the bank is precharged
+      UInt64 activate_time = max<UInt64>(pkt_time, bank.ready_time);
+      bank.activate_time = activate_time;
+      column_time = activate_time + m_t_rcd;
+      bank.column_ready_time = column_time + m_t_burst;
+      unloaded_latency = m_t_rcd + m_t_cas + m_t_burst;
+      m_num_row_misses ++;
+   }
+   else
+   {
+      // Row conflict: PRECHARGE the open row, then ACTIVATE
+      UInt64 precharge_time = max<UInt64>(max<UInt64>(pkt_time, bank.ready_time),
+                                          max<UInt64>(bank.activate_time + m_t_ras, bank.column_ready_time));
+      bank.closing = true;
+      bank.closing_row = bank.open_row;
+      bank.close_time = precharge_time;
+      bank.closing_column_ready_time = bank.column_ready_time;
+
+      UInt64 activate_time = precharge_time + m_t_rp;
+      bank.activate_time = activate_time;
+      column_time = activate_time + m_t_rcd;
+      bank.column_ready_time = column_time + m_t_burst;
+      unloaded_latency = m_t_rp + m_t_rcd + m_t_cas + m_t_burst;
+      m_num_row_conflicts ++;
+   }
+
+   // A reordered hit leaves the newly opened row in place
+   if (!reordered)
+   {
+      bank.row_open = true;
+      bank.open_row = row;
+   }
+
+   if (m_page_policy == CLOSED_PAGE)
+   {
+      // Auto-precharge after the access
+      bank.ready_time = max<UInt64>(bank.activate_time + m_t_ras, column_time + m_t_burst) + m_t_rp;
+      bank.row_open = false;
+      bank.closing = false;
+   }
+
+   // Data bus of the channel
+   UInt64 data_time = max<UInt64>(column_time + m_t_cas, m_bus_free_time[channel]);
+   m_bus_free_time[channel] = data_time + m_t_burst;
+
+   UInt64 access_latency = data_time + m_t_burst - pkt_time;
+   UInt64 queue_delay = access_latency - unloaded_latency;
+
+   updateCounters(access_latency, queue_delay);
+
+   return access_latency;
+}
+
+void
+DramPerfModelBanked::reset()
+{
+   DramPerfModel::reset();
+   initializeBanks();
+   initializePerformanceCounters();
+}
+
+void
+DramPerfModelBanked::outputSummary(ostream& out)
+{
+   DramPerfModel::outputSummary(out);
+
+   out << "  Row Buffer:" << endl;
+   out << "    row hits: " << m_num_row_hits << endl;
+   out << "    row misses: " << m_num_row_misses << endl;
+   out << "    row conflicts: " << m_num_row_conflicts << endl;
+   out << "    reordered row hits: " << m_num_reordered_row_hits << endl;
+}
+
+void
+DramPerfModelBanked::dummyOutputSummary(ostream& out)
+{
+   out << "  Row Buffer:" << endl;
+   out << "    row hits: NA" << endl;
+   out << "    row misses: NA" << endl;
+   out << "    row conflicts: NA" << endl;
+   out << "    reordered row hits: NA" << endl;
+}
@@ -0,0 +1,96 @@
+#ifndef __DRAM_PERF_MODEL_BANKED_H__
+#define __DRAM_PERF_MODEL_BANKED_H__
+
+#include <vector>
+using namespace std;
+
+#include "dram_perf_model.h"
+#include "fixed_types.h"
+
+// DRAM behind a single controller, organized as channels x ranks x banks.
+// Each bank has a row buffer and keeps the times at which its next commands
+// may issue; each channel has a data bus shared by its ranks.
+// Requests are scheduled FR-FCFS: a request that hits the row a bank is
+// about to close is served before the precharge if it fits in the gap.
+// Address fields are given MSB to LSB by perf_model/dram/banked/address_mapping.
+class DramPerfModelBanked : public DramPerfModel
+{
+   public:
+      DramPerfModelBanked(UInt32 cache_block_size);
+      ~DramPerfModelBanked();
+
+      UInt64 getAccessLatency(UInt64 pkt_time, UInt64 pkt_size, tile_id_t requester, IntPtr address);
+      void reset();
+
+      void outputSummary(ostream& out);
+
+      static void dummyOutputSummary(ostream& out);
+
+   private:
+      enum PagePolicy
+      {
+         OPEN_PAGE = 0,
+         CLOSED_PAGE
+      };
+
+      enum AddressField
+      {
+         ROW = 0,
+         RANK,
+         BANK,
+         CHANNEL,
+         COLUMN,
+         NUM_ADDRESS_FIELDS
+      };
+
+      struct Bank
+      {
+         bool row_open;
+         UInt64 open_row;
+         // Earliest time of the next ACTIVATE
+         UInt64 ready_time;
+         UInt64 activate_time;
+         // Earliest time of the next column command to the open row
+         UInt64 column_ready_time;
+         // Row closed by the last PRECHARGE and the time that PRECHARGE issued
+         bool closing;
+         UInt64 closing_row;
+         UInt64 close_time;
+         UInt64 closing_column_ready_time;
+      };
+
+      static const UInt32 ADDRESS_BITS = 48;
+
+      UInt32 m_num_channels;
+      UInt32 m_num_ranks;
+      UInt32 m_num_banks;
+      PagePolicy m_page_policy;
+
+      // Timing parameters (in ns)
+      UInt64 m_t_rcd;
+      UInt64 m_t_cas;
+      UInt64 m_t_rp;
+      UInt64 m_t_ras;
+      UInt64 m_t_burst;
+
+      UInt32 m_field_shift[NUM_ADDRESS_FIELDS];
+      UInt64 m_field_mask[NUM_ADDRESS_FIELDS];
+
+      vector<Bank> m_banks;
+      vector<UInt64> m_bus_free_time;
+
+      // Performance Counters
+      UInt64 m_num_row_hits;
+      UInt64 m_num_row_misses;
+      UInt64 m_num_row_conflicts;
+      UInt64 m_num_reordered_row_hits;
+
+      void parseAddressMapping(string address_mapping, UInt32 row_size);
+      UInt64 getField(IntPtr address, AddressField field)
+      { return (((UInt64) address) >> m_field_shift[field]) & m_field_mask[field]; }
+
+      void initializeBanks();
+      void initializePerformanceCounters();
+};
+
+#endif /* __DRAM_PERF_MODEL_BANKED_H__ */
@@ -0,0 +1,114 @@
+#include "mshr_perf_model.h"
+#include "log.h"
+
+MshrPerfModel::MshrPerfModel(UInt32 num_entries):
+   m_num_entries(num_entries),
+   m_entry_address(num_entries, 0),
+   m_entry_completion_time(num_entries, 0),
+   m_latest_completion_time(0),
+   m_enabled(false)
+{
+   LOG_ASSERT_ERROR(m_num_entries > 0, "Need at least 1 MSHR, got %u", m_num_entries);
+   initializePerformanceCounters();
+}
+
+MshrPerfModel::~MshrPerfModel()
+{}
+
+void
+MshrPerfModel::initializePerformanceCounters()
+{
+   m_num_primary_misses = 0;
+   m_num_secondary_misses = 0;
+   m_num_full_stalls = 0;
+   m_total_full_stall_cycles = 0;
+}
+
+void
+MshrPerfModel::reset()
+{
+   initializePerformanceCounters();
+   for (UInt32 i = 0; i < m_num_entries; i++)
+   {
+      m_entry_address[i] = 0;
+      m_entry_completion_time[i] = 0;
+   }
+   m_latest_completion_time = 0;
+}
+
+UInt64
+MshrPerfModel::allocateEntry(IntPtr address, UInt64 time)
+{
+   if (!m_enabled)
+      return time;
+
+   // The entry that frees up first
+   SInt32 entry = -1;
+   for (UInt32 i = 0; i < m_num_entries; i++)
+   {
+      if ((m_entry_completion_time[i] != PENDING) &&
+          ((entry == -1) || (m_entry_completion_time[i] < m_entry_completion_time[entry])))
+         entry = i;
+   }
+   LOG_ASSERT_ERROR(entry != -1, "All %u MSHRs have a miss in progress", m_num_entries);
+
+   UInt64 issue_time = time;
+   if (m_entry_completion_time[entry] > time)
+   {
+      issue_time = m_entry_completion_time[entry];
+      m_num_full_stalls ++;
+      m_total_full_stall_cycles += (issue_time - time);
+   }
+
+   m_entry_address[entry] = address;
+   m_entry_completion_time[entry] = PENDING;
+   m_num_primary_misses ++;
+
+   return issue_time;
+}
+
+void
+MshrPerfModel::completeEntry(IntPtr address, UInt64 time)
+{
+   // The entry may be missing if the model was enabled in between
+   for (UInt32 i = 0; i < m_num_entries; i++)
+   {
+      if ((m_entry_completion_time[i] == PENDING) && (m_entry_address[i] == address))
+      {
+         m_entry_completion_time[i] = time;
+         if (time > m_latest_completion_time)
+            m_latest_completion_time = time;
+         return;
+      }
+   }
+}
+
+UInt64
+MshrPerfModel::getCompletionTime(IntPtr address, UInt64 time)
+{
+   if (!m_enabled)
+      return time;
+
+   UInt64 completion_time = time;
+   for (UInt32 i = 0; i < m_num_entries; i++)
+   {
+      if ((m_entry_address[i] == address) && (m_entry_completion_time[i] != PENDING) &&
+          (m_entry_completion_time[i] > completion_time))
+         completion_time = m_entry_completion_time[i];
+   }
+
+   if (completion_time > time)
+      m_num_secondary_misses ++;
+   return completion_time;
+}
+
+void
+MshrPerfModel::outputSummary(std::ostream& out)
+{
+   out << "    num mshr entries: " << m_num_entries << std::endl;
+   out << "    num primary misses: " << m_num_primary_misses << std::endl;
+   out << "    num secondary misses: " << m_num_secondary_misses << std::endl;
+   out << "    num mshr full stalls: " << m_num_full_stalls << std::endl;
+   out << "    average mshr full stall cycles: " <<
+      ((m_num_full_stalls == 0) ? 0.0 : ((float) m_total_full_stall_cycles / m_num_full_stalls)) << std::endl;
+}
@@ -0,0 +1,65 @@
+#ifndef __MSHR_PERF_MODEL_H__
+#define __MSHR_PERF_MODEL_H__
+
+#include <vector>
+#include <iostream>
+
+#include "fixed_types.h"
+
+// Timing model of the miss status holding registers (MSHRs) of a cache.
+// The simulated program executes its memory operations one at a time,
+// so a miss is always functionally complete before the next access is
+// made. The timing of the accesses can still overlap (the core models
+// issue them at their own, not necessarily increasing, times) and this
+// model bounds and merges the overlapping misses:
+//    - A primary miss occupies an entry from the time it is issued until
+//      its fill completes. When all the entries are busy, the miss waits
+//      for the earliest one to free up.
+//    - A later access to a line whose fill has not completed yet
+//      (a secondary miss) is merged with it and completes with the fill
+class MshrPerfModel
+{
+   private:
+      static const UInt64 PENDING = ~((UInt64) 0);
+
+      UInt32 m_num_entries;
+      std::vector<IntPtr> m_entry_address;
+      std::vector<UInt64> m_entry_completion_time;
+      // Latest completion time of a fill; no access made after it merges
+      // with a miss. Read without a lock by the lock-free L1 hit path
+      volatile UInt64 m_latest_completion_time;
+
+      bool m_enabled;
+
+      // Performance Counters
+      UInt64 m_num_primary_misses;
+      UInt64 m_num_secondary_misses;
+      UInt64 m_num_full_stalls;
+      UInt64 m_total_full_stall_cycles;
+
+      void initializePerformanceCounters();
+
+   public:
+      MshrPerfModel(UInt32 num_entries);
+      ~MshrPerfModel();
+
+      // Allocate an entry for a primary miss to 'address' that is ready
+      // to issue at 'time'. Returns the time at which the miss issues
+      UInt64 allocateEntry(IntPtr address, UInt64 time);
+      // The fill for 'address' completed at 'time'
+      void completeEntry(IntPtr address, UInt64 time);
+      // Time at which an access to 'address' at 'time' can complete,
+      // i.e., 'time' unless it merges with an outstanding miss
+      UInt64 getCompletionTime(IntPtr address, UInt64 time);
+      // False if an access at 'time' may merge with a miss, in which case
+      // getCompletionTime() has to be called
+      bool isIdleAt(UInt64 time) { return (!m_enabled || (time >= m_latest_completion_time)); }
+
+      void enable() { m_enabled = true; }
+      void disable() { m_enabled = false; }
+      void reset();
+
+      void outputSummary(std::ostream& out);
+};
+
+#endif /* __MSHR_PERF_MODEL_H__ */
@@ -2,6 +2,7 @@
 #include "memory_manager.h"
 #include "tile.h"
 #include "clock_converter.h"
+#include "config.h"
 #include "log.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
@@ -15,37 +16,36 @@ DramCntlr::DramCntlr(MemoryManager* memory_manager,
       UInt32 cache_block_size,
       ShmemPerfModel* shmem_perf_model):
    m_memory_manager(memory_manager),
+   m_data_storage_enabled(Config::getSingleton()->getEnableDataStorage()),
    m_cache_block_size(cache_block_size),
    m_shmem_perf_model(shmem_perf_model)
 {
-   m_dram_perf_model = new DramPerfModel(dram_access_cost, 
+   m_dram_perf_model = DramPerfModel::create(dram_access_cost,
          dram_bandwidth,
          dram_queue_model_enabled,
          dram_queue_model_type, 
          cache_block_size);
 
-   m_dram_access_count = new AccessCountMap[NUM_ACCESS_TYPES];
+   m_backing_store = m_data_storage_enabled ? new DramBackingStore() : NULL;
+
+   m_dram_access_counter = DramAccessCounter::create(NUM_ACCESS_TYPES, m_memory_manager->getTile()->getId());
 }
 
 DramCntlr::~DramCntlr()
 {
-   printDramAccessCount();
-   delete [] m_dram_access_count;
+   delete m_dram_access_counter;
 
    delete m_dram_perf_model;
+   delete m_backing_store;
 }
 
 void
 DramCntlr::getDataFromDram(IntPtr address, tile_id_t requester, Byte* data_buf)
 {
-   if (m_data_map[address] == NULL)
-   {
-      m_data_map[address] = new Byte[getCacheBlockSize()];
-      memset((void*) m_data_map[address], 0x00, getCacheBlockSize());
-   }
-   memcpy((void*) data_buf, (void*) m_data_map[address], getCacheBlockSize());
+   if (m_data_storage_enabled)
+      memcpy((void*) data_buf, (void*) m_backing_store->getBlock(address), getCacheBlockSize());
 
-   UInt64 dram_access_latency = runDramPerfModel(requester);
+   UInt64 dram_access_latency = runDramPerfModel(address, requester);
    getShmemPerfModel()->incrCycleCount(dram_access_latency);
 
    addToDramAccessCount(address, READ);
@@ -54,19 +54,43 @@ DramCntlr::getDataFromDram(IntPtr address, tile_id_t requester, Byte* data_buf)
 void
 DramCntlr::putDataToDram(IntPtr address, tile_id_t requester, Byte* data_buf)
 {
-   if (m_data_map[address] == NULL)
+   if (m_data_storage_enabled)
    {
-      LOG_PRINT_ERROR("Data Buffer does not exist");
+      LOG_ASSERT_ERROR(m_backing_store->contains(address), "Data Buffer does not exist");
+      memcpy((void*) m_backing_store->getBlock(address), (void*) data_buf, getCacheBlockSize());
    }
-   memcpy((void*) m_data_map[address], (void*) data_buf, getCacheBlockSize());
 
-   runDramPerfModel(requester);
+   runDramPerfModel(address, requester);
    
    addToDramAccessCount(address, WRITE);
 }
 
+void
+DramCntlr::saveSnapshot(SnapshotWriter& writer)
+{
+   writer.write<bool>(m_data_storage_enabled);
+   if (m_data_storage_enabled)
+      m_backing_store->saveSnapshot(writer);
+}
+
+void
+DramCntlr::loadSnapshot(SnapshotReader& reader)
+{
+   bool snapshot_has_data = reader.read<bool>();
+   LOG_ASSERT_ERROR(snapshot_has_data || !m_data_storage_enabled,
+         "Dram snapshot was taken without data storage");
+
+   if (snapshot_has_data)
+   {
+      if (m_data_storage_enabled)
+         m_backing_store->loadSnapshot(reader);
+      else
+         DramBackingStore::skipSnapshot(reader);
+   }
+}
+
 UInt64
-DramCntlr::runDramPerfModel(tile_id_t requester)
+DramCntlr::runDramPerfModel(IntPtr address, tile_id_t requester)
 {
    UInt64 pkt_cycle_count = getShmemPerfModel()->getCycleCount();
    UInt64 pkt_size = (UInt64) getCacheBlockSize();
@@ -74,32 +98,9 @@ DramCntlr::runDramPerfModel(tile_id_t requester)
    volatile float tile_frequency = m_memory_manager->getTile()->getCore()->getPerformanceModel()->getFrequency();
    UInt64 pkt_time = convertCycleCount(pkt_cycle_count, tile_frequency, 1.0);
 
-   UInt64 dram_access_latency = m_dram_perf_model->getAccessLatency(pkt_time, pkt_size, requester);
+   UInt64 dram_access_latency = m_dram_perf_model->getAccessLatency(pkt_time, pkt_size, requester, address);
 
    return convertCycleCount(dram_access_latency, 1.0, tile_frequency);
 }
 
-void
-DramCntlr::addToDramAccessCount(IntPtr address, access_t access_type)
-{
-   m_dram_access_count[access_type][address] = m_dram_access_count[access_type][address] + 1;
-}
-
-void
-DramCntlr::printDramAccessCount()
-{
-   for (UInt32 k = 0; k < NUM_ACCESS_TYPES; k++)
-   {
-      for (AccessCountMap::iterator i = m_dram_access_count[k].begin(); i != m_dram_access_count[k].end(); i++)
-      {
-         if ((*i).second > 100)
-         {
-            LOG_PRINT("Dram Cntlr(%i), Address(0x%x), Access Count(%llu), Access Type(%s)", 
-                  m_memory_manager->getTile()->getId(), (*i).first, (*i).second,
-                  (k == READ)? "READ" : "WRITE");
-         }
-      }
-   }
-}
-
 }
@@ -38,7 +38,7 @@ DramDirectoryCntlr::DramDirectoryCntlr(tile_id_t tile_id,
          dram_directory_cache_access_delay_in_ns,
          m_shmem_perf_model);
    m_dram_directory_req_queue_list = new ReqQueueList();
-   m_cached_data_list = new DataList(m_cache_block_size);
+   m_cached_data_list = new DataList(m_cache_block_size, Config::getSingleton()->getEnableDataStorage());
 
    m_directory_type = Directory::parseDirectoryType(dram_directory_type_str);
 
@@ -67,8 +67,7 @@ DramDirectoryCntlr::handleMsgFromL2Cache(tile_id_t sender, ShmemMsg* shmem_msg)
             IntPtr address = shmem_msg->getAddress();
             
             // Add request onto a queue
-            ShmemReq* shmem_req = new ShmemReq(shmem_msg, msg_time);
-            m_dram_directory_req_queue_list->enqueue(address, shmem_req);
+            ShmemReq* shmem_req = m_dram_directory_req_queue_list->enqueue(address, shmem_msg, msg_time);
 
             if (m_dram_directory_req_queue_list->size(address) == 1)
             {
@@ -110,8 +109,7 @@ DramDirectoryCntlr::processNextReqFromL2Cache(IntPtr address)
    LOG_PRINT("Start processNextReqFromL2Cache(0x%x)", address);
 
    assert(m_dram_directory_req_queue_list->size(address) >= 1);
-   ShmemReq* completed_shmem_req = m_dram_directory_req_queue_list->dequeue(address);
-   delete completed_shmem_req;
+   m_dram_directory_req_queue_list->dequeue(address);
 
    // No longer should any data be cached for this address
    assert(m_cached_data_list->lookup(address) == NULL);
@@ -170,8 +168,7 @@ DramDirectoryCntlr::processDirectoryEntryAllocationReq(ShmemReq* shmem_req)
    ShmemMsg nullify_msg(ShmemMsg::NULLIFY_REQ, MemComponent::DRAM_DIR, MemComponent::DRAM_DIR,
          requester, (tile_id_t) INVALID_TILE_ID, false, replaced_address);
 
-   ShmemReq* nullify_req = new ShmemReq(&nullify_msg, msg_time);
-   m_dram_directory_req_queue_list->enqueue(replaced_address, nullify_req);
+   ShmemReq* nullify_req = m_dram_directory_req_queue_list->enqueue(replaced_address, &nullify_msg, msg_time);
 
    assert(m_dram_directory_req_queue_list->size(replaced_address) == 1);
    processNullifyReq(nullify_req, true);
@@ -188,8 +185,7 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req, bool first_call)
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -278,8 +274,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, bool first_call
       directory_entry = processDirectoryEntryAllocationReq(shmem_req);
    }
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -306,7 +301,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, bool first_call
             
             if ((directory_entry->getOwner() == requester) && (directory_entry->getNumSharers() == 1))
             {
-               directory_block_info->setDState(DirectoryState::MODIFIED);
+               directory_entry->setDState(DirectoryState::MODIFIED);
 
                ShmemMsg shmem_msg(ShmemMsg::UPGRADE_REP, MemComponent::DRAM_DIR, MemComponent::L2_CACHE,
                      requester, INVALID_TILE_ID, false, address);
@@ -338,7 +333,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, bool first_call
             if ((directory_entry->hasSharer(requester)) && (directory_entry->getNumSharers() == 1))
             {
                directory_entry->setOwner(requester);
-               directory_block_info->setDState(DirectoryState::MODIFIED);
+               directory_entry->setDState(DirectoryState::MODIFIED);
 
                ShmemMsg shmem_msg(ShmemMsg::UPGRADE_REP, MemComponent::DRAM_DIR, MemComponent::L2_CACHE,
                      requester, INVALID_TILE_ID, false, address);
@@ -375,7 +370,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, bool first_call
                   address);
 
             directory_entry->setOwner(requester);
-            directory_block_info->setDState(DirectoryState::MODIFIED);
+            directory_entry->setDState(DirectoryState::MODIFIED);
 
             retrieveDataAndSendToL2Cache(ShmemMsg::EX_REP, requester, address);
 
@@ -402,8 +397,7 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, bool first_call
       directory_entry = processDirectoryEntryAllocationReq(shmem_req);
    }
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -489,7 +483,7 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, bool first_call
                   "Address(0x%x), Requester(%i), State(UNCACHED), Num Sharers(%u)",
                   address, requester, directory_entry->getNumSharers());
             
-            directory_block_info->setDState(DirectoryState::SHARED);
+            directory_entry->setDState(DirectoryState::SHARED);
 
             retrieveDataAndSendToL2Cache(ShmemMsg::SH_REP, requester, address);
      
@@ -506,7 +500,7 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, bool first_call
 
 void
 DramDirectoryCntlr::sendShmemMsg(ShmemMsg::msg_t requester_msg_type, ShmemMsg::msg_t send_msg_type, IntPtr address,
-      tile_id_t requester, tile_id_t single_receiver, pair<bool, vector<tile_id_t> >& sharers_list_pair)
+      tile_id_t requester, tile_id_t single_receiver, const pair<bool, vector<tile_id_t> >& sharers_list_pair)
 {
    bool broadcast_inv_req = false;
 
@@ -526,13 +520,10 @@ DramDirectoryCntlr::sendShmemMsg(ShmemMsg::msg_t requester_msg_type, ShmemMsg::m
    }
    else
    {
-      // Send Invalidation Request to only a specific set of sharers
-      for (UInt32 i = 0; i < sharers_list_pair.second.size(); i++)
-      {
-         ShmemMsg shmem_msg(send_msg_type, MemComponent::DRAM_DIR, MemComponent::L2_CACHE,
-               requester, single_receiver, false, address);
-         getMemoryManager()->sendMsg(sharers_list_pair.second[i], shmem_msg);
-      }
+      // Multicast Invalidation Request to only a specific set of sharers
+      ShmemMsg shmem_msg(send_msg_type, MemComponent::DRAM_DIR, MemComponent::L2_CACHE,
+            requester, single_receiver, false, address);
+      getMemoryManager()->multicastMsg(sharers_list_pair.second, shmem_msg);
    }
 
    updateBroadcastPerfCounters(requester_msg_type, true, broadcast_inv_req);
@@ -580,8 +571,7 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
   
    switch (curr_dstate)
    {
@@ -600,7 +590,7 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
 
          directory_entry->removeSharer(sender, shmem_msg->isReplyExpected());
          if (directory_entry->getNumSharers() == 0)
-            directory_block_info->setDState(DirectoryState::UNCACHED);
+            directory_entry->setDState(DirectoryState::UNCACHED);
          break;
 
       case DirectoryState::MODIFIED:
@@ -615,7 +605,7 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
    {
       // Get the latest request for the data
       ShmemReq* shmem_req = m_dram_directory_req_queue_list->front(address);
-      restartShmemReq(sender, shmem_req, directory_block_info->getDState());
+      restartShmemReq(sender, shmem_req, directory_entry->getDState());
    }
 }
 
@@ -627,8 +617,7 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
    
    LOG_ASSERT_ERROR(curr_dstate != DirectoryState::UNCACHED,
          "Address(%#llx), State(%u)", address, curr_dstate);
@@ -643,7 +632,7 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
          assert(! shmem_msg->isReplyExpected());
          directory_entry->removeSharer(sender, false);
          directory_entry->setOwner(INVALID_TILE_ID);
-         directory_block_info->setDState(DirectoryState::UNCACHED); 
+         directory_entry->setDState(DirectoryState::UNCACHED); 
          break;
 
       case DirectoryState::OWNED:
@@ -656,9 +645,9 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
          {
             directory_entry->setOwner(INVALID_TILE_ID);
             if (directory_entry->getNumSharers() > 0)
-               directory_block_info->setDState(DirectoryState::SHARED);
+               directory_entry->setDState(DirectoryState::SHARED);
             else
-               directory_block_info->setDState(DirectoryState::UNCACHED);
+               directory_entry->setDState(DirectoryState::UNCACHED);
          }
          break;
 
@@ -669,7 +658,7 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
 
          directory_entry->removeSharer(sender, shmem_msg->isReplyExpected());
          if (directory_entry->getNumSharers() == 0)
-            directory_block_info->setDState(DirectoryState::UNCACHED);
+            directory_entry->setDState(DirectoryState::UNCACHED);
          break;
 
       case DirectoryState::UNCACHED:
@@ -691,7 +680,7 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
       if (shmem_req->getShmemMsg()->getMsgType() == ShmemMsg::SH_REQ)
       {
          DirectoryState::dstate_t initial_dstate = curr_dstate;
-         DirectoryState::dstate_t final_dstate = directory_block_info->getDState();
+         DirectoryState::dstate_t final_dstate = directory_entry->getDState();
 
          if ((initial_dstate == DirectoryState::MODIFIED || initial_dstate == DirectoryState::OWNED)
             && (final_dstate == DirectoryState::SHARED || final_dstate == DirectoryState::UNCACHED))
@@ -700,7 +689,7 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
          }
       }
 
-      restartShmemReq(sender, shmem_req, directory_block_info->getDState());
+      restartShmemReq(sender, shmem_req, directory_entry->getDState());
    }
    else
    {
@@ -718,8 +707,7 @@ DramDirectoryCntlr::processWbRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_ms
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
    
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    assert(! shmem_msg->isReplyExpected());
 
@@ -731,7 +719,7 @@ DramDirectoryCntlr::processWbRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_ms
          LOG_ASSERT_ERROR(m_dram_directory_req_queue_list->size(address) > 0,
                "Address(%#llx), WB_REP, req queue empty!!", address);
 
-         directory_block_info->setDState(DirectoryState::OWNED);
+         directory_entry->setDState(DirectoryState::OWNED);
          break;
 
       case DirectoryState::OWNED:
@@ -762,7 +750,7 @@ DramDirectoryCntlr::processWbRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_ms
 
       // Get the latest request for the data
       ShmemReq* shmem_req = m_dram_directory_req_queue_list->front(address);
-      restartShmemReq(sender, shmem_req, directory_block_info->getDState());
+      restartShmemReq(sender, shmem_req, directory_entry->getDState());
    }
    else
    {
@@ -949,16 +937,31 @@ DramDirectoryCntlr::dummyOutputSummary(ostream& out)
    DramDirectoryCache::dummyOutputSummary(out);
 }
 
-DramDirectoryCntlr::DataList::DataList(UInt32 block_size):
-   m_block_size(block_size)
-{}
+DramDirectoryCntlr::DataList::DataList(UInt32 block_size, bool data_storage_enabled):
+   m_block_size(block_size),
+   m_shared_block(NULL)
+{
+   if (!data_storage_enabled)
+   {
+      m_shared_block = new Byte[m_block_size];
+      memset(m_shared_block, 0x00, m_block_size);
+   }
+}
 
 DramDirectoryCntlr::DataList::~DataList()
-{}
+{
+   delete [] m_shared_block;
+}
 
 void
 DramDirectoryCntlr::DataList::insert(IntPtr address, Byte* data)
 {
+   if (m_shared_block != NULL)
+   {
+      m_data_list.insert(std::make_pair<IntPtr,Byte*>(address, m_shared_block));
+      return;
+   }
+
    Byte* alloc_data = new Byte[m_block_size];
    memcpy(alloc_data, data, m_block_size);
 
@@ -993,7 +996,8 @@ DramDirectoryCntlr::DataList::erase(IntPtr address)
    LOG_ASSERT_ERROR(data_list_it != m_data_list.end(),
          "Unable to erase address(0x%x) from m_data_list", address);
 
-   delete [] (data_list_it->second);
+   if (data_list_it->second != m_shared_block)
+      delete [] (data_list_it->second);
    m_data_list.erase(data_list_it);
 }
 
@@ -27,9 +27,12 @@ namespace PrL1PrL2DramDirectoryMOSI
             private:
                UInt32 m_block_size;
                std::map<IntPtr, Byte*> m_data_list;
+               // In tag-only runs, every entry shares this zeroed block and
+               // the list only records which addresses have data in flight
+               Byte* m_shared_block;
 
             public:
-               DataList(UInt32 block_size);
+               DataList(UInt32 block_size, bool data_storage_enabled);
                ~DataList();
                
                void insert(IntPtr address, Byte* data);
@@ -91,7 +94,7 @@ namespace PrL1PrL2DramDirectoryMOSI
          void processWbRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_msg);
          void sendDataToDram(IntPtr address, tile_id_t requester, Byte* data_buf);
       
-         void sendShmemMsg(ShmemMsg::msg_t requester_msg_type, ShmemMsg::msg_t send_msg_type, IntPtr address, tile_id_t requester, tile_id_t single_receiver, pair<bool, vector<tile_id_t> >& sharers_list_pair);
+         void sendShmemMsg(ShmemMsg::msg_t requester_msg_type, ShmemMsg::msg_t send_msg_type, IntPtr address, tile_id_t requester, tile_id_t single_receiver, const pair<bool, vector<tile_id_t> >& sharers_list_pair);
          void restartShmemReq(tile_id_t sender, ShmemReq* shmem_req, DirectoryState::dstate_t curr_dstate);
 
          // Update Performance Counters
@@ -1,6 +1,10 @@
+#include <string.h>
+#include <algorithm>
+
 #include "l1_cache_cntlr.h"
 #include "l2_cache_cntlr.h" 
 #include "memory_manager.h"
+#include "config.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -12,10 +16,14 @@ L1CacheCntlr::L1CacheCntlr(tile_id_t tile_id,
       UInt32 cache_block_size,
       UInt32 l1_icache_size, UInt32 l1_icache_associativity,
       std::string l1_icache_replacement_policy,
+      UInt32 l1_icache_num_mshrs,
       UInt32 l1_dcache_size, UInt32 l1_dcache_associativity,
       std::string l1_dcache_replacement_policy,
+      UInt32 l1_dcache_num_mshrs,
+      Prefetcher* l1_dcache_prefetcher,
       ShmemPerfModel* shmem_perf_model) :
    m_memory_manager(memory_manager),
+   m_l1_dcache_prefetcher(l1_dcache_prefetcher),
    m_l2_cache_cntlr(NULL),
    m_tile_id(tile_id),
    m_cache_block_size(cache_block_size),
@@ -28,19 +36,76 @@ L1CacheCntlr::L1CacheCntlr(tile_id_t tile_id,
          l1_icache_associativity, 
          m_cache_block_size,
          l1_icache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->getEnableDataStorage());
    m_l1_dcache = new Cache("L1-D",
          l1_dcache_size,
          l1_dcache_associativity, 
          m_cache_block_size,
          l1_dcache_replacement_policy,
-         CacheBase::PR_L1_CACHE);
+         CacheBase::PR_L1_CACHE,
+         Config::getSingleton()->getEnableDataStorage());
+
+   m_l1_icache_set_versions = new UInt32[m_l1_icache->getNumSets()];
+   m_l1_dcache_set_versions = new UInt32[m_l1_dcache->getNumSets()];
+   memset(m_l1_icache_set_versions, 0, m_l1_icache->getNumSets() * sizeof(UInt32));
+   memset(m_l1_dcache_set_versions, 0, m_l1_dcache->getNumSets() * sizeof(UInt32));
+
+   m_l1_icache_mshr_perf_model = new MshrPerfModel(l1_icache_num_mshrs);
+   m_l1_dcache_mshr_perf_model = new MshrPerfModel(l1_dcache_num_mshrs);
+
+   // The PEP core has L1 Caches like the main core's, with no prefetcher
+   m_l1_pep_icache = NULL;
+   m_l1_pep_dcache = NULL;
+   m_l1_pep_icache_mshr_perf_model = NULL;
+   m_l1_pep_dcache_mshr_perf_model = NULL;
+   m_l1_pep_icache_set_versions = NULL;
+   m_l1_pep_dcache_set_versions = NULL;
+   if (Config::getSingleton()->getEnablePepCores())
+   {
+      m_l1_pep_icache = new Cache("PEP L1-I",
+            l1_icache_size,
+            l1_icache_associativity, 
+            m_cache_block_size,
+            l1_icache_replacement_policy,
+            CacheBase::PR_L1_CACHE,
+            Config::getSingleton()->getEnableDataStorage());
+      m_l1_pep_dcache = new Cache("PEP L1-D",
+            l1_dcache_size,
+            l1_dcache_associativity, 
+            m_cache_block_size,
+            l1_dcache_replacement_policy,
+            CacheBase::PR_L1_CACHE,
+            Config::getSingleton()->getEnableDataStorage());
+
+      m_l1_pep_icache_set_versions = new UInt32[m_l1_pep_icache->getNumSets()];
+      m_l1_pep_dcache_set_versions = new UInt32[m_l1_pep_dcache->getNumSets()];
+      memset(m_l1_pep_icache_set_versions, 0, m_l1_pep_icache->getNumSets() * sizeof(UInt32));
+      memset(m_l1_pep_dcache_set_versions, 0, m_l1_pep_dcache->getNumSets() * sizeof(UInt32));
+
+      m_l1_pep_icache_mshr_perf_model = new MshrPerfModel(l1_icache_num_mshrs);
+      m_l1_pep_dcache_mshr_perf_model = new MshrPerfModel(l1_dcache_num_mshrs);
+   }
 }
 
 L1CacheCntlr::~L1CacheCntlr()
 {
    delete m_l1_icache;
    delete m_l1_dcache;
+   delete [] m_l1_icache_set_versions;
+   delete [] m_l1_dcache_set_versions;
+   delete m_l1_icache_mshr_perf_model;
+   delete m_l1_dcache_mshr_perf_model;
+   delete m_l1_dcache_prefetcher;
+   if (m_l1_pep_icache)
+   {
+      delete m_l1_pep_icache;
+      delete m_l1_pep_dcache;
+      delete [] m_l1_pep_icache_set_versions;
+      delete [] m_l1_pep_dcache_set_versions;
+      delete m_l1_pep_icache_mshr_perf_model;
+      delete m_l1_pep_dcache_mshr_perf_model;
+   }
 }      
 
 void
@@ -61,8 +126,19 @@ L1CacheCntlr::processMemOpFromTile(
    LOG_PRINT("processMemOpFromTile(), lock_signal(%u), mem_op_type(%u), ca_address(0x%x)",
          lock_signal, mem_op_type, ca_address);
 
+   // Hits that need neither the L2 Cache nor the cache lock held across
+   // calls complete without taking the lock
+   if ((lock_signal == Core::NONE) && (mem_op_type != Core::WRITE) &&
+       processMemOpLockFree(mem_component, mem_op_type, ca_address, offset, data_buf, data_length, modeled))
+   {
+      return true;
+   }
+
    bool l1_cache_hit = true;
    UInt32 access_num = 0;
+   // Set when the miss lock is held; a retried access is counted once
+   bool miss_lock_held = false;
+   bool retried = false;
 
    while(1)
    {
@@ -72,6 +148,7 @@ L1CacheCntlr::processMemOpFromTile(
 
       if (lock_signal != Core::UNLOCK)
          acquireLock(mem_component);
+      applyPendingHits(mem_component);
 
       // Wake up the network thread after acquiring the lock
       if (access_num == 2)
@@ -79,26 +156,67 @@ L1CacheCntlr::processMemOpFromTile(
          wakeUpNetworkThread();
       }
 
-      if (operationPermissibleinL1Cache(mem_component, ca_address, mem_op_type, access_num, modeled))
+      if (operationPermissibleinL1Cache(mem_component, ca_address, mem_op_type, access_num, modeled && !retried))
       {
+         // A hit on a line whose fill is still in flight (in simulated
+         // time) completes together with the fill
+         if (access_num == 1)
+            getShmemPerfModel()->setCycleCount(getMshrPerfModel(mem_component)->getCompletionTime(ca_address,
+                     getShmemPerfModel()->getCycleCount()));
+
          // Increment Shared Mem Perf model cycle counts
          // L1 Cache
          getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
 
          accessCache(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
+
+         if (access_num == 2)
+            getMshrPerfModel(mem_component)->completeEntry(ca_address, getShmemPerfModel()->getCycleCount());
                  
          if (lock_signal != Core::LOCK)
             releaseLock(mem_component);
+         if (miss_lock_held)
+            m_miss_lock.release();
          return l1_cache_hit;
       }
 
-      getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_TAGS);
-
       if (lock_signal == Core::UNLOCK)
          LOG_PRINT_ERROR("Expected to find address(0x%x) in L1 Cache", ca_address);
 
+      // The other core of the tile may be waiting for the network thread with
+      // the miss lock held, and needs the L1 cache lock to finish. Wait for
+      // it without the L1 cache lock, then look up the cache again
+      if (!miss_lock_held)
+      {
+         miss_lock_held = m_miss_lock.tryLock();
+         if (!miss_lock_held)
+         {
+            releaseLock(mem_component);
+            m_miss_lock.acquire();
+            miss_lock_held = true;
+            retried = true;
+            access_num --;
+            continue;
+         }
+      }
+
+      getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_TAGS);
+
+      // Primary miss: wait for a free MSHR
+      getShmemPerfModel()->setCycleCount(getMshrPerfModel(mem_component)->allocateEntry(ca_address,
+               getShmemPerfModel()->getCycleCount()));
+
       m_l2_cache_cntlr->acquireLock();
  
+      // Train the L1-D prefetcher on the miss. The blocks it asks for
+      // are prefetched into the L2 Cache
+      if ((mem_component == MemComponent::L1_DCACHE) && (m_l1_dcache_prefetcher != NULL))
+      {
+         std::vector<IntPtr> prefetch_address_list;
+         m_l1_dcache_prefetcher->getPrefetchAddresses(ca_address, true, prefetch_address_list);
+         m_l2_cache_cntlr->queuePrefetches(MemComponent::L1_DCACHE, prefetch_address_list);
+      }
+
       ShmemMsg::msg_t shmem_msg_type = getShmemMsgType(mem_op_type);
 
       if (m_l2_cache_cntlr->processShmemReqFromL1Cache(mem_component, shmem_msg_type, ca_address, modeled))
@@ -113,8 +231,11 @@ L1CacheCntlr::processMemOpFromTile(
 
          accessCache(mem_component, mem_op_type, ca_address, offset, data_buf, data_length);
 
+         getMshrPerfModel(mem_component)->completeEntry(ca_address, getShmemPerfModel()->getCycleCount());
+
          if (lock_signal != Core::LOCK)
             releaseLock(mem_component);
+         m_miss_lock.release();
          return false;
       }
 
@@ -123,13 +244,22 @@ L1CacheCntlr::processMemOpFromTile(
       // Increment shared mem perf model cycle counts
       getMemoryManager()->incrCycleCount(MemComponent::L2_CACHE, CachePerfModel::ACCESS_CACHE_TAGS);
       
+      // A request for a block that is being prefetched waits for the prefetch
+      bool shmem_req_deferred = m_l2_cache_cntlr->isShmemReqDeferred(ca_address);
+
       m_l2_cache_cntlr->releaseLock();
       releaseLock(mem_component);
       
       // Send out a request to the network thread for the cache data
-      ShmemMsg shmem_msg(shmem_msg_type, mem_component, MemComponent::L2_CACHE,
-            m_tile_id, INVALID_TILE_ID, false, ca_address);
-      getMemoryManager()->sendMsg(m_tile_id, shmem_msg);
+      if (!shmem_req_deferred)
+      {
+         // A page touched for the first time may get its home here
+         getMemoryManager()->getDramDirectoryHomeLookup()->touch(ca_address);
+
+         ShmemMsg shmem_msg(shmem_msg_type, mem_component, MemComponent::L2_CACHE,
+               m_tile_id, INVALID_TILE_ID, false, ca_address);
+         getMemoryManager()->sendMsg(m_tile_id, shmem_msg);
+      }
 
       waitForNetworkThread();
    }
@@ -138,6 +268,149 @@ L1CacheCntlr::processMemOpFromTile(
    return false;
 }
 
+// Accesses the lines of [address, address + data_size) in order. Runs of
+// lines that hit are handled under one acquisition of the cache locks; a
+// line that misses (and every line, with a lock signal) goes through
+// processMemOpFromTile(). The protocol has one outstanding request per
+// user thread, so the misses are still issued one at a time
+UInt32
+L1CacheCntlr::processMemOpRangeFromTile(
+      MemComponent::component_t mem_component,
+      Core::lock_signal_t lock_signal,
+      Core::mem_op_t mem_op_type,
+      IntPtr address,
+      Byte* data_buf, UInt32 data_size,
+      bool modeled)
+{
+   Cache* l1_cache = getL1Cache(mem_component);
+   UInt32 num_misses = 0;
+
+   IntPtr end_address = address + data_size;
+   while (address < end_address)
+   {
+      IntPtr ca_address = address - (address % m_cache_block_size);
+      UInt32 offset = address - ca_address;
+      UInt32 length = std::min((IntPtr) (m_cache_block_size - offset), end_address - address);
+
+      // Read hits complete without the locks, line by line; the first line
+      // that needs them starts a locked run
+      if ((lock_signal == Core::NONE) && (mem_op_type != Core::WRITE) &&
+          processMemOpLockFree(mem_component, mem_op_type, ca_address, offset, data_buf, length, modeled))
+      {
+         address += length;
+         data_buf += length;
+         continue;
+      }
+
+      if (lock_signal == Core::NONE)
+      {
+         acquireLock(mem_component);
+         applyPendingHits(mem_component);
+         // Write-through: the L2 Cache is written along with the L1 Cache
+         if (mem_op_type == Core::WRITE)
+            m_l2_cache_cntlr->acquireLock();
+
+         // The counters of a line that misses are updated by processMemOpFromTile()
+         while (operationPermissibleinL1Cache(mem_component, ca_address, mem_op_type, 1, false))
+         {
+            if (modeled)
+               l1_cache->updateCounters(ca_address, true);
+
+            getShmemPerfModel()->setCycleCount(getMshrPerfModel(mem_component)->getCompletionTime(ca_address,
+                     getShmemPerfModel()->getCycleCount()));
+            getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+
+            if (mem_op_type == Core::WRITE)
+            {
+               l1_cache->accessSingleLine(ca_address + offset, Cache::STORE, data_buf, length);
+               m_l2_cache_cntlr->writeCacheBlock(ca_address, offset, data_buf, length);
+            }
+            else
+            {
+               l1_cache->accessSingleLine(ca_address + offset, Cache::LOAD, data_buf, length);
+            }
+
+            address += length;
+            data_buf += length;
+            if (address == end_address)
+               break;
+
+            ca_address = address;
+            offset = 0;
+            length = std::min((IntPtr) m_cache_block_size, end_address - address);
+         }
+
+         if (mem_op_type == Core::WRITE)
+            m_l2_cache_cntlr->releaseLock();
+         releaseLock(mem_component);
+
+         if (address == end_address)
+            break;
+      }
+
+      if (!processMemOpFromTile(mem_component, lock_signal, mem_op_type,
+               ca_address, offset, data_buf, length, modeled))
+      {
+         num_misses ++;
+      }
+
+      address += length;
+      data_buf += length;
+   }
+
+   return num_misses;
+}
+
+// Seqlock read of the set that holds 'ca_address': the state check and the
+// data copy are retried on the locked path if the network thread changed
+// the set in the meantime. Nothing is counted until the read is validated.
+// The read changes no shared state: the replacement update of the hit is
+// queued (see applyPendingHits()), and accesses that need the profiler or
+// may merge with an outstanding miss take the locked path
+bool
+L1CacheCntlr::processMemOpLockFree(MemComponent::component_t mem_component,
+      Core::mem_op_t mem_op_type,
+      IntPtr ca_address, UInt32 offset,
+      Byte* data_buf, UInt32 data_length,
+      bool modeled)
+{
+   Cache* l1_cache = getL1Cache(mem_component);
+
+   // The heatmap is also updated by invalidations, and the profiler by fills
+   if (l1_cache->hasHeatmap() || l1_cache->hasStackDistanceProfiler())
+      return false;
+
+   std::vector<IntPtr>& pending_hits = getPendingHits(mem_component);
+   if ((pending_hits.size() == MAX_PENDING_HITS) ||
+       !getMshrPerfModel(mem_component)->isIdleAt(getShmemPerfModel()->getCycleCount()))
+      return false;
+
+   volatile UInt32& set_version = getSetVersion(mem_component, ca_address);
+   UInt32 version = set_version;
+   __sync_synchronize();
+   if (version & 1)
+      return false;
+
+   CacheState cstate(getCacheState(mem_component, ca_address));
+   bool permissible = (mem_op_type == Core::READ) ? cstate.readable() : cstate.writable();
+   if (!permissible)
+      return false;
+
+   if (!l1_cache->readSingleLine(ca_address + offset, data_buf, data_length))
+      return false;
+
+   __sync_synchronize();
+   if (set_version != version)
+      return false;
+
+   if (modeled)
+      l1_cache->updateCounters(ca_address, true, true);
+
+   pending_hits.push_back(ca_address);
+   getMemoryManager()->incrCycleCount(mem_component, CachePerfModel::ACCESS_CACHE_DATA_AND_TAGS);
+   return true;
+}
+
 void
 L1CacheCntlr::accessCache(MemComponent::component_t mem_component,
       Core::mem_op_t mem_op_type, IntPtr ca_address, UInt32 offset,
@@ -194,7 +467,7 @@ L1CacheCntlr::operationPermissibleinL1Cache(
    if (modeled && (access_num == 1))
    {
       // Update the Cache Counters
-      getL1Cache(mem_component)->updateCounters(cache_hit);
+      getL1Cache(mem_component)->updateCounters(address, cache_hit);
    }
 
    return cache_hit;
@@ -205,13 +478,12 @@ L1CacheCntlr::insertCacheBlock(MemComponent::component_t mem_component,
       IntPtr address, CacheState::cstate_t cstate, Byte* data_buf,
       bool* eviction_ptr, IntPtr* evict_address_ptr)
 {
-   __attribute(__unused__) PrL1CacheBlockInfo evict_block_info;
-   __attribute(__unused__) Byte evict_buf[getCacheBlockSize()];
-
+   // The L1 is write-through, so the evicted data is never needed
    Cache* l1_cache = getL1Cache(mem_component);
-   l1_cache->insertSingleLine(address, data_buf,
-         eviction_ptr, evict_address_ptr, &evict_block_info, evict_buf);
-   setCacheState(mem_component, address, cstate);
+   beginSetUpdate(mem_component, address);
+   l1_cache->insertSingleLine<PrL1CacheBlockInfo>(address, cstate, data_buf,
+         eviction_ptr, evict_address_ptr, NULL);
+   endSetUpdate(mem_component, address);
 }
 
 CacheState::cstate_t
@@ -231,7 +503,9 @@ L1CacheCntlr::setCacheState(MemComponent::component_t mem_component, IntPtr addr
    PrL1CacheBlockInfo* l1_cache_block_info = (PrL1CacheBlockInfo*) l1_cache->peekSingleLine(address);
    assert(l1_cache_block_info);
 
+   beginSetUpdate(mem_component, address);
    l1_cache_block_info->setCState(cstate);
+   endSetUpdate(mem_component, address);
 }
 
 void
@@ -239,7 +513,9 @@ L1CacheCntlr::invalidateCacheBlock(MemComponent::component_t mem_component, IntP
 {
    Cache* l1_cache = getL1Cache(mem_component);
 
+   beginSetUpdate(mem_component, address);
    l1_cache->invalidateSingleLine(address);
+   endSetUpdate(mem_component, address);
 }
 
 ShmemMsg::msg_t
@@ -271,6 +547,99 @@ L1CacheCntlr::getL1Cache(MemComponent::component_t mem_component)
       case MemComponent::L1_DCACHE:
          return m_l1_dcache;
 
+      case MemComponent::L1_PEP_ICACHE:
+         return m_l1_pep_icache;
+
+      case MemComponent::L1_PEP_DCACHE:
+         return m_l1_pep_dcache;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized Memory Component(%u)", mem_component);
+         return NULL;
+   }
+}
+
+volatile UInt32&
+L1CacheCntlr::getSetVersion(MemComponent::component_t mem_component, IntPtr address)
+{
+   IntPtr tag;
+   UInt32 set_index;
+   getL1Cache(mem_component)->splitAddress(address, tag, set_index);
+
+   switch (mem_component)
+   {
+      case MemComponent::L1_ICACHE:
+         return m_l1_icache_set_versions[set_index];
+      case MemComponent::L1_PEP_ICACHE:
+         return m_l1_pep_icache_set_versions[set_index];
+      case MemComponent::L1_PEP_DCACHE:
+         return m_l1_pep_dcache_set_versions[set_index];
+      default:
+         return m_l1_dcache_set_versions[set_index];
+   }
+}
+
+// Called with the L1 cache lock held; the atomic increments also order the
+// change against the lock-free readers
+void
+L1CacheCntlr::beginSetUpdate(MemComponent::component_t mem_component, IntPtr address)
+{
+   __sync_fetch_and_add(&getSetVersion(mem_component, address), 1);
+}
+
+void
+L1CacheCntlr::endSetUpdate(MemComponent::component_t mem_component, IntPtr address)
+{
+   __sync_fetch_and_add(&getSetVersion(mem_component, address), 1);
+}
+
+std::vector<IntPtr>&
+L1CacheCntlr::getPendingHits(MemComponent::component_t mem_component)
+{
+   switch (mem_component)
+   {
+      case MemComponent::L1_ICACHE:
+         return m_l1_icache_pending_hits;
+      case MemComponent::L1_PEP_ICACHE:
+         return m_l1_pep_icache_pending_hits;
+      case MemComponent::L1_PEP_DCACHE:
+         return m_l1_pep_dcache_pending_hits;
+      default:
+         return m_l1_dcache_pending_hits;
+   }
+}
+
+// Called by the user thread with the L1 cache lock held
+void
+L1CacheCntlr::applyPendingHits(MemComponent::component_t mem_component)
+{
+   std::vector<IntPtr>& pending_hits = getPendingHits(mem_component);
+   if (pending_hits.empty())
+      return;
+
+   Cache* l1_cache = getL1Cache(mem_component);
+   for (std::vector<IntPtr>::iterator it = pending_hits.begin(); it != pending_hits.end(); it++)
+      l1_cache->touchSingleLine(*it);
+   pending_hits.clear();
+}
+
+MshrPerfModel*
+L1CacheCntlr::getMshrPerfModel(MemComponent::component_t mem_component)
+{
+   switch(mem_component)
+   {
+      case MemComponent::L1_ICACHE:
+         return m_l1_icache_mshr_perf_model;
+
+      case MemComponent::L1_DCACHE:
+         return m_l1_dcache_mshr_perf_model;
+
+      case MemComponent::L1_PEP_ICACHE:
+         return m_l1_pep_icache_mshr_perf_model;
+
+      case MemComponent::L1_PEP_DCACHE:
+         return m_l1_pep_dcache_mshr_perf_model;
+
       default:
          LOG_PRINT_ERROR("Unrecognized Memory Component(%u)", mem_component);
          return NULL;
@@ -283,9 +652,11 @@ L1CacheCntlr::acquireLock(MemComponent::component_t mem_component)
    switch(mem_component)
    {
       case MemComponent::L1_ICACHE:
+      case MemComponent::L1_PEP_ICACHE:
          m_l1_icache_lock.acquire();
          break;
       case MemComponent::L1_DCACHE:
+      case MemComponent::L1_PEP_DCACHE:
          m_l1_dcache_lock.acquire();
          break;
       default:
@@ -301,9 +672,11 @@ L1CacheCntlr::releaseLock(MemComponent::component_t mem_component)
    switch(mem_component)
    {
       case MemComponent::L1_ICACHE:
+      case MemComponent::L1_PEP_ICACHE:
          m_l1_icache_lock.release();
          break;
       case MemComponent::L1_DCACHE:
+      case MemComponent::L1_PEP_DCACHE:
          m_l1_dcache_lock.release();
          break;
       default:
@@ -7,6 +7,8 @@ namespace PrL1PrL2DramDirectoryMOSI
    class MemoryManager;
 }
 
+#include <vector>
+
 #include "tile.h"
 #include "cache.h"
 #include "pr_l1_cache_block_info.h"
@@ -16,6 +18,8 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "lock.h"
 #include "fixed_types.h"
 #include "shmem_perf_model.h"
+#include "mshr_perf_model.h"
+#include "prefetcher.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -25,13 +29,42 @@ namespace PrL1PrL2DramDirectoryMOSI
          MemoryManager* m_memory_manager;
          Cache* m_l1_icache;
          Cache* m_l1_dcache;
+         MshrPerfModel* m_l1_icache_mshr_perf_model;
+         MshrPerfModel* m_l1_dcache_mshr_perf_model;
+         // L1 Caches of the PEP core (NULL if general/enable_pep_cores is not set)
+         Cache* m_l1_pep_icache;
+         Cache* m_l1_pep_dcache;
+         MshrPerfModel* m_l1_pep_icache_mshr_perf_model;
+         MshrPerfModel* m_l1_pep_dcache_mshr_perf_model;
+         Prefetcher* m_l1_dcache_prefetcher;
          L2CacheCntlr* m_l2_cache_cntlr;
 
          tile_id_t m_tile_id;
          UInt32 m_cache_block_size;
 
+         // The L1 Caches of the PEP core share the locks of the main core's
+         // L1 Caches, so a line is never changed in both at the same time
          Lock m_l1_icache_lock;
          Lock m_l1_dcache_lock;
+         // The main and PEP cores have one outstanding miss between them:
+         // the user and network threads hand over the reply through one
+         // pair of semaphores
+         Lock m_miss_lock;
+         // Per-set versions for the lock-free hit path. A version is odd
+         // while the set is being changed (always under the L1 cache lock)
+         UInt32* m_l1_icache_set_versions;
+         UInt32* m_l1_dcache_set_versions;
+         UInt32* m_l1_pep_icache_set_versions;
+         UInt32* m_l1_pep_dcache_set_versions;
+         // Lines hit on the lock-free path whose replacement state is updated
+         // the next time the L1 cache lock is taken. Each list belongs to the
+         // user thread of its core, and the lists are applied before the core
+         // misses, i.e., before any line is inserted into its L1 Caches
+         static const UInt32 MAX_PENDING_HITS = 64;
+         std::vector<IntPtr> m_l1_icache_pending_hits;
+         std::vector<IntPtr> m_l1_dcache_pending_hits;
+         std::vector<IntPtr> m_l1_pep_icache_pending_hits;
+         std::vector<IntPtr> m_l1_pep_dcache_pending_hits;
          Semaphore* m_user_thread_sem;
          Semaphore* m_network_thread_sem;
 
@@ -42,12 +75,22 @@ namespace PrL1PrL2DramDirectoryMOSI
                Core::mem_op_t mem_op_type, 
                IntPtr ca_address, UInt32 offset,
                Byte* data_buf, UInt32 data_length);
+         bool processMemOpLockFree(MemComponent::component_t mem_component,
+               Core::mem_op_t mem_op_type,
+               IntPtr ca_address, UInt32 offset,
+               Byte* data_buf, UInt32 data_length,
+               bool modeled);
          bool operationPermissibleinL1Cache(
                MemComponent::component_t mem_component, 
                IntPtr address, Core::mem_op_t mem_op_type,
                UInt32 access_num, bool modeled);
 
          Cache* getL1Cache(MemComponent::component_t mem_component);
+         volatile UInt32& getSetVersion(MemComponent::component_t mem_component, IntPtr address);
+         void beginSetUpdate(MemComponent::component_t mem_component, IntPtr address);
+         void endSetUpdate(MemComponent::component_t mem_component, IntPtr address);
+         std::vector<IntPtr>& getPendingHits(MemComponent::component_t mem_component);
+         void applyPendingHits(MemComponent::component_t mem_component);
          ShmemMsg::msg_t getShmemMsgType(Core::mem_op_t mem_op_type);
 
          // Get Cache Block Size
@@ -69,14 +112,21 @@ namespace PrL1PrL2DramDirectoryMOSI
                UInt32 cache_block_size,
                UInt32 l1_icache_size, UInt32 l1_icache_associativity,
                std::string l1_icache_replacement_policy,
+               UInt32 l1_icache_num_mshrs,
                UInt32 l1_dcache_size, UInt32 l1_dcache_associativity,
                std::string l1_dcache_replacement_policy,
+               UInt32 l1_dcache_num_mshrs,
+               Prefetcher* l1_dcache_prefetcher,
                ShmemPerfModel* shmem_perf_model);
          
          ~L1CacheCntlr();
 
          Cache* getL1ICache() { return m_l1_icache; }
          Cache* getL1DCache() { return m_l1_dcache; }
+         Cache* getL1PepICache() { return m_l1_pep_icache; }
+         Cache* getL1PepDCache() { return m_l1_pep_dcache; }
+         MshrPerfModel* getMshrPerfModel(MemComponent::component_t mem_component);
+         Prefetcher* getL1DCachePrefetcher() { return m_l1_dcache_prefetcher; }
 
          void setL2CacheCntlr(L2CacheCntlr* l2_cache_cntlr);
 
@@ -87,6 +137,14 @@ namespace PrL1PrL2DramDirectoryMOSI
                IntPtr ca_address, UInt32 offset,
                Byte* data_buf, UInt32 data_length,
                bool modeled);
+         // Returns the number of lines that missed
+         UInt32 processMemOpRangeFromTile(
+               MemComponent::component_t mem_component,
+               Core::lock_signal_t lock_signal,
+               Core::mem_op_t mem_op_type,
+               IntPtr address,
+               Byte* data_buf, UInt32 data_size,
+               bool modeled);
 
          void insertCacheBlock(MemComponent::component_t mem_component,
                IntPtr address, CacheState::cstate_t cstate, Byte* data_buf,
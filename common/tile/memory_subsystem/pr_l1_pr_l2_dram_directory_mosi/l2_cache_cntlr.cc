@@ -2,6 +2,7 @@
 #include "l2_cache_cntlr.h"
 #include "log.h"
 #include "memory_manager.h"
+#include "config.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -15,10 +16,15 @@ L2CacheCntlr::L2CacheCntlr(tile_id_t tile_id,
       UInt32 cache_block_size,
       UInt32 l2_cache_size, UInt32 l2_cache_associativity,
       std::string l2_cache_replacement_policy,
+      UInt32 l2_cache_num_mshrs,
+      Prefetcher* l2_cache_prefetcher,
       ShmemPerfModel* shmem_perf_model):
    m_memory_manager(memory_manager),
    m_l1_cache_cntlr(l1_cache_cntlr),
    m_dram_directory_home_lookup(dram_directory_home_lookup),
+   m_l2_cache_prefetcher(l2_cache_prefetcher),
+   m_max_outstanding_prefetches(l2_cache_num_mshrs - 1),
+   m_deferred_shmem_msg(NULL),
    m_tile_id(tile_id),
    m_cache_block_size(cache_block_size),
    m_user_thread_sem(user_thread_sem),
@@ -30,12 +36,17 @@ L2CacheCntlr::L2CacheCntlr(tile_id_t tile_id,
          l2_cache_associativity, 
          m_cache_block_size, 
          l2_cache_replacement_policy, 
-         CacheBase::PR_L2_CACHE);
+         CacheBase::PR_L2_CACHE,
+         Config::getSingleton()->getEnableDataStorage());
+
+   m_mshr_perf_model = new MshrPerfModel(l2_cache_num_mshrs);
 }
 
 L2CacheCntlr::~L2CacheCntlr()
 {
    delete m_l2_cache;
+   delete m_mshr_perf_model;
+   delete m_l2_cache_prefetcher;
 }
 
 PrL2CacheBlockInfo*
@@ -60,6 +71,7 @@ L2CacheCntlr::setCacheState(PrL2CacheBlockInfo* l2_cache_block_info, CacheState:
 void
 L2CacheCntlr::invalidateCacheBlock(IntPtr address)
 {
+   recordPrefetchEviction(getCacheBlockInfo(address));
    m_l2_cache->invalidateSingleLine(address);
 }
 
@@ -81,19 +93,19 @@ PrL2CacheBlockInfo*
 L2CacheCntlr::insertCacheBlock(IntPtr address, CacheState::cstate_t cstate, Byte* data_buf)
 {
    bool eviction;
-   IntPtr evict_address;
-   PrL2CacheBlockInfo evict_block_info;
+   IntPtr evict_address = INVALID_ADDRESS;
    Byte evict_buf[getCacheBlockSize()];
+   PrL2CacheBlockInfo* l2_cache_block_info;
 
-   m_l2_cache->insertSingleLine(address, data_buf,
-         &eviction, &evict_address, &evict_block_info, evict_buf);
-   PrL2CacheBlockInfo* l2_cache_block_info = getCacheBlockInfo(address);
-   setCacheState(l2_cache_block_info, cstate);
+   PrL2CacheBlockInfo evict_block_info = m_l2_cache->insertSingleLine<PrL2CacheBlockInfo>(
+         address, cstate, data_buf,
+         &eviction, &evict_address, evict_buf, &l2_cache_block_info);
 
    if (eviction)
    {
       LOG_PRINT("Eviction: addr(0x%x)", evict_address);
-      invalidateCacheBlockInL1(evict_block_info.getCachedLoc(), evict_address);
+      recordPrefetchEviction(&evict_block_info);
+      invalidateCacheBlockInL1(evict_block_info.getCachedLocBitVec(), evict_address);
 
       UInt32 home_node_id = getHome(evict_address);
       CacheState::cstate_t evict_cstate = evict_block_info.getCState();
@@ -130,17 +142,23 @@ L2CacheCntlr::getCacheStateInL1(MemComponent::component_t mem_component, IntPtr
 }
 
 void
-L2CacheCntlr::setCacheStateInL1(MemComponent::component_t mem_component, IntPtr address, CacheState::cstate_t cstate)
+L2CacheCntlr::setCacheStateInL1(UInt32 cached_loc_bitvec, IntPtr address, CacheState::cstate_t cstate)
 {
-   if (mem_component != MemComponent::INVALID_MEM_COMPONENT)
-      m_l1_cache_cntlr->setCacheState(mem_component, address, cstate);
+   for (UInt32 loc = MemComponent::MIN_MEM_COMPONENT; loc <= MemComponent::MAX_MEM_COMPONENT; loc++)
+   {
+      if (cached_loc_bitvec & (((UInt32) 1) << loc))
+         m_l1_cache_cntlr->setCacheState((MemComponent::component_t) loc, address, cstate);
+   }
 }
 
 void
-L2CacheCntlr::invalidateCacheBlockInL1(MemComponent::component_t mem_component, IntPtr address)
+L2CacheCntlr::invalidateCacheBlockInL1(UInt32 cached_loc_bitvec, IntPtr address)
 {
-   if (mem_component != MemComponent::INVALID_MEM_COMPONENT)
-      m_l1_cache_cntlr->invalidateCacheBlock(mem_component, address);
+   for (UInt32 loc = MemComponent::MIN_MEM_COMPONENT; loc <= MemComponent::MAX_MEM_COMPONENT; loc++)
+   {
+      if (cached_loc_bitvec & (((UInt32) 1) << loc))
+         m_l1_cache_cntlr->invalidateCacheBlock((MemComponent::component_t) loc, address);
+   }
 }
 
 void
@@ -149,7 +167,7 @@ L2CacheCntlr::insertCacheBlockInL1(MemComponent::component_t mem_component,
       CacheState::cstate_t cstate, Byte* data_buf)
 {
    bool eviction;
-   IntPtr evict_address;
+   IntPtr evict_address = INVALID_ADDRESS;
 
    // Insert the Cache Block in L1 Cache
    m_l1_cache_cntlr->insertCacheBlock(mem_component, address, cstate, data_buf, &eviction, &evict_address);
@@ -165,24 +183,210 @@ L2CacheCntlr::insertCacheBlockInL1(MemComponent::component_t mem_component,
    }
 }
 
+MemComponent::component_t
+L2CacheCntlr::getSiblingL1Cache(MemComponent::component_t mem_component)
+{
+   switch (mem_component)
+   {
+      case MemComponent::L1_ICACHE:
+         return MemComponent::L1_PEP_ICACHE;
+      case MemComponent::L1_DCACHE:
+         return MemComponent::L1_PEP_DCACHE;
+      case MemComponent::L1_PEP_ICACHE:
+         return MemComponent::L1_ICACHE;
+      case MemComponent::L1_PEP_DCACHE:
+         return MemComponent::L1_DCACHE;
+      default:
+         LOG_PRINT_ERROR("Unrecognized L1 Cache(%u)", mem_component);
+         return MemComponent::INVALID_MEM_COMPONENT;
+   }
+}
+
+bool
+L2CacheCntlr::isCachedInL1(MemComponent::component_t mem_component, PrL2CacheBlockInfo* l2_cache_block_info)
+{
+   return ((l2_cache_block_info != NULL) &&
+           (l2_cache_block_info->getCachedLocBitVec() & (((UInt32) 1) << mem_component)));
+}
+
+void
+L2CacheCntlr::updateSiblingL1Cache(MemComponent::component_t req_mem_component, ShmemMsg::msg_t msg_type,
+      IntPtr address, PrL2CacheBlockInfo* l2_cache_block_info)
+{
+   // The L1 Caches of the main and the PEP core share the tile's L2 Cache.
+   // They are kept coherent here, under the L1 Cache lock they also share
+   MemComponent::component_t sibling_mem_component = getSiblingL1Cache(req_mem_component);
+   if (!isCachedInL1(sibling_mem_component, l2_cache_block_info))
+      return;
+
+   getMemoryManager()->incrCycleCount(sibling_mem_component, CachePerfModel::ACCESS_CACHE_TAGS);
+   if (msg_type == ShmemMsg::EX_REQ)
+   {
+      m_l1_cache_cntlr->invalidateCacheBlock(sibling_mem_component, address);
+      l2_cache_block_info->clearCachedLoc(sibling_mem_component);
+   }
+   else if (CacheState(m_l1_cache_cntlr->getCacheState(sibling_mem_component, address)).writable())
+   {
+      m_l1_cache_cntlr->setCacheState(sibling_mem_component, address, CacheState::SHARED);
+   }
+}
+
+ShmemPerfModel::Thread_t
+L2CacheCntlr::getUserThread(MemComponent::component_t mem_component)
+{
+   return ((mem_component == MemComponent::L1_PEP_ICACHE) || (mem_component == MemComponent::L1_PEP_DCACHE)) ?
+      ShmemPerfModel::_HELPER_THREAD : ShmemPerfModel::_USER_THREAD;
+}
+
 bool
 L2CacheCntlr::processShmemReqFromL1Cache(MemComponent::component_t req_mem_component, ShmemMsg::msg_t msg_type, IntPtr address, bool modeled)
 {
    PrL2CacheBlockInfo* l2_cache_block_info = getCacheBlockInfo(address);
+   updateSiblingL1Cache(req_mem_component, msg_type, address, l2_cache_block_info);
+
    CacheState::cstate_t cstate = getCacheState(l2_cache_block_info);
 
-   bool shmem_req_ends_in_l2_cache = shmemReqEndsInL2Cache(msg_type, cstate, modeled);
+   recordPrefetchUse(l2_cache_block_info);
+
+   bool shmem_req_ends_in_l2_cache = shmemReqEndsInL2Cache(msg_type, address, cstate, modeled);
+
+   // Train the L2 prefetcher on every request from the L1 Caches
+   if (m_l2_cache_prefetcher != NULL)
+   {
+      std::vector<IntPtr> prefetch_address_list;
+      m_l2_cache_prefetcher->getPrefetchAddresses(address, !shmem_req_ends_in_l2_cache, prefetch_address_list);
+      queuePrefetches(MemComponent::L2_CACHE, prefetch_address_list);
+   }
+
    if (shmem_req_ends_in_l2_cache)
    {
+      // Merge with a fill of the line that is still in flight
+      getShmemPerfModel()->setCycleCount(m_mshr_perf_model->getCompletionTime(address,
+               getShmemPerfModel()->getCycleCount()));
+
       Byte data_buf[getCacheBlockSize()];
       retrieveCacheBlock(address, data_buf);
 
-      insertCacheBlockInL1(req_mem_component, address, l2_cache_block_info, cstate, data_buf);
+      // A block cached in both L1 Caches is only readable in them
+      CacheState::cstate_t l1_cstate = (isCachedInL1(getSiblingL1Cache(req_mem_component), l2_cache_block_info) &&
+            CacheState(cstate).writable()) ? CacheState::SHARED : cstate;
+      // An L1 Cache keeps its readable copy when it asks for write access
+      if (isCachedInL1(req_mem_component, l2_cache_block_info))
+         m_l1_cache_cntlr->setCacheState(req_mem_component, address, l1_cstate);
+      else
+         insertCacheBlockInL1(req_mem_component, address, l2_cache_block_info, l1_cstate, data_buf);
+
+      issuePrefetches(address);
+   }
+   else if (m_outstanding_prefetch_map.count(address) > 0)
+   {
+      // The block is being prefetched. The request completes with the prefetch
+      getPrefetcher(m_outstanding_prefetch_map[address])->recordLate();
+
+      assert(m_deferred_shmem_msg == NULL);
+      m_deferred_shmem_msg = new ShmemMsg(msg_type, req_mem_component, MemComponent::L2_CACHE,
+            m_tile_id, INVALID_TILE_ID, false, address);
    }
    
    return shmem_req_ends_in_l2_cache;
 }
 
+bool
+L2CacheCntlr::isShmemReqDeferred(IntPtr address)
+{
+   return ((m_deferred_shmem_msg != NULL) && (m_deferred_shmem_msg->getAddress() == address));
+}
+
+Prefetcher*
+L2CacheCntlr::getPrefetcher(MemComponent::component_t prefetch_mem_component)
+{
+   switch (prefetch_mem_component)
+   {
+      case MemComponent::L1_DCACHE:
+         return m_l1_cache_cntlr->getL1DCachePrefetcher();
+
+      case MemComponent::L2_CACHE:
+         return m_l2_cache_prefetcher;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized Prefetcher Mem Component(%u)", prefetch_mem_component);
+         return NULL;
+   }
+}
+
+void
+L2CacheCntlr::queuePrefetches(MemComponent::component_t prefetch_mem_component, std::vector<IntPtr>& prefetch_address_list)
+{
+   for (std::vector<IntPtr>::iterator it = prefetch_address_list.begin(); it != prefetch_address_list.end(); it++)
+   {
+      // Drop the oldest prefetches when the queue is full
+      if (m_prefetch_queue.size() == MAX_PREFETCH_QUEUE_SIZE)
+         m_prefetch_queue.pop_front();
+      m_prefetch_queue.push_back(std::make_pair(*it, prefetch_mem_component));
+   }
+}
+
+void
+L2CacheCntlr::issuePrefetches(IntPtr demand_address)
+{
+   // Prefetches have a lower priority than the demand requests. They are
+   // only sent out behind a demand request and never hold up one: they
+   // leave an MSHR free for it and do not advance its clock
+   while ((!m_prefetch_queue.empty()) && (m_outstanding_prefetch_map.size() < m_max_outstanding_prefetches))
+   {
+      IntPtr address = m_prefetch_queue.front().first;
+      MemComponent::component_t prefetch_mem_component = m_prefetch_queue.front().second;
+      m_prefetch_queue.pop_front();
+
+      if ((address == demand_address) ||
+          (getCacheState(getCacheBlockInfo(address)) != CacheState::INVALID) ||
+          (m_outstanding_prefetch_map.count(address) > 0) ||
+          (!m_dram_directory_home_lookup->isHomeKnown(address)))
+         continue;
+
+      LOG_PRINT("Prefetch: addr(%#llx)", address);
+      m_outstanding_prefetch_map[address] = prefetch_mem_component;
+      getPrefetcher(prefetch_mem_component)->recordIssued();
+      m_mshr_perf_model->allocateEntry(address, getShmemPerfModel()->getCycleCount());
+
+      ShmemMsg send_shmem_msg(ShmemMsg::SH_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIR,
+            m_tile_id, INVALID_TILE_ID, false, address);
+      getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
+   }
+}
+
+bool
+L2CacheCntlr::isPrefetchRep(ShmemMsg::msg_t msg_type, IntPtr address)
+{
+   if (msg_type != ShmemMsg::SH_REP)
+      return false;
+
+   acquireLock();
+   bool prefetch_rep = (m_outstanding_prefetch_map.count(address) > 0);
+   releaseLock();
+   return prefetch_rep;
+}
+
+void
+L2CacheCntlr::recordPrefetchUse(PrL2CacheBlockInfo* l2_cache_block_info)
+{
+   if ((l2_cache_block_info != NULL) && (l2_cache_block_info->getPrefetchSource() != MemComponent::INVALID_MEM_COMPONENT))
+   {
+      getPrefetcher(l2_cache_block_info->getPrefetchSource())->recordUseful();
+      l2_cache_block_info->setPrefetchSource(MemComponent::INVALID_MEM_COMPONENT);
+   }
+}
+
+void
+L2CacheCntlr::recordPrefetchEviction(PrL2CacheBlockInfo* l2_cache_block_info)
+{
+   if ((l2_cache_block_info != NULL) && (l2_cache_block_info->getPrefetchSource() != MemComponent::INVALID_MEM_COMPONENT))
+   {
+      getPrefetcher(l2_cache_block_info->getPrefetchSource())->recordUseless();
+      l2_cache_block_info->setPrefetchSource(MemComponent::INVALID_MEM_COMPONENT);
+   }
+}
+
 void
 L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
 {
@@ -207,10 +411,16 @@ L2CacheCntlr::handleMsgFromL1Cache(ShmemMsg* shmem_msg)
    m_outstanding_shmem_msg.setSenderMemComponent(sender_mem_component);
    m_outstanding_shmem_msg.setMsgType(shmem_msg_type);
 
+   // Wait for a free MSHR before sending the request out
+   getShmemPerfModel()->setCycleCount(m_mshr_perf_model->allocateEntry(address,
+            getShmemPerfModel()->getCycleCount()));
+
    ShmemMsg send_shmem_msg(shmem_msg_type, MemComponent::L2_CACHE, MemComponent::DRAM_DIR,
          m_tile_id, INVALID_TILE_ID, false, address); 
    getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
 
+   issuePrefetches(address);
+
    releaseLock();
 }
 
@@ -221,19 +431,33 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
    IntPtr address = shmem_msg->getAddress();
 
    // Acquire Locks
-   MemComponent::component_t caching_mem_component = acquireL1CacheLock(shmem_msg_type, address);
+   // A prefetched block can evict a block cached in either L1 Cache
+   bool prefetch_rep = isPrefetchRep(shmem_msg_type, address);
+   MemComponent::component_t caching_mem_component = MemComponent::INVALID_MEM_COMPONENT;
+   if (prefetch_rep)
+   {
+      m_l1_cache_cntlr->acquireLock(MemComponent::L1_ICACHE);
+      m_l1_cache_cntlr->acquireLock(MemComponent::L1_DCACHE);
+   }
+   else
+   {
+      caching_mem_component = acquireL1CacheLock(shmem_msg_type, address);
+   }
    acquireLock();
 
+   bool shmem_req_completed = false;
    switch (shmem_msg_type)
    {
       case ShmemMsg::EX_REP:
          processExRepFromDramDirectory(sender, shmem_msg);
+         shmem_req_completed = true;
          break;
       case ShmemMsg::SH_REP:
-         processShRepFromDramDirectory(sender, shmem_msg);
+         shmem_req_completed = processShRepFromDramDirectory(sender, shmem_msg);
          break;
       case ShmemMsg::UPGRADE_REP:
          processUpgradeRepFromDramDirectory(sender, shmem_msg);
+         shmem_req_completed = true;
          break;
       case ShmemMsg::INV_REQ:
          processInvReqFromDramDirectory(sender, shmem_msg);
@@ -254,10 +478,17 @@ L2CacheCntlr::handleMsgFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
 
    // Release Locks
    releaseLock();
-   if (caching_mem_component != MemComponent::INVALID_MEM_COMPONENT)
+   if (prefetch_rep)
+   {
+      m_l1_cache_cntlr->releaseLock(MemComponent::L1_DCACHE);
+      m_l1_cache_cntlr->releaseLock(MemComponent::L1_ICACHE);
+   }
+   else if (caching_mem_component != MemComponent::INVALID_MEM_COMPONENT)
+   {
       m_l1_cache_cntlr->releaseLock(caching_mem_component);
+   }
 
-   if ((shmem_msg_type == ShmemMsg::EX_REP) || (shmem_msg_type == ShmemMsg::SH_REP) || (shmem_msg_type == ShmemMsg::UPGRADE_REP))
+   if (shmem_req_completed)
    {
       wakeUpUserThread();
       waitForUserThread();
@@ -279,6 +510,7 @@ L2CacheCntlr::processExRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_ms
    Byte* data_buf = shmem_msg->getDataBuf();
 
    PrL2CacheBlockInfo* l2_cache_block_info = insertCacheBlock(address, CacheState::MODIFIED, data_buf);
+   m_mshr_perf_model->completeEntry(address, getShmemPerfModel()->getCycleCount());
 
    // Insert Cache Block in L1 Cache
    // Support for non-blocking caches can be added in this way
@@ -287,17 +519,17 @@ L2CacheCntlr::processExRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_ms
          address, m_outstanding_shmem_msg.getAddress());
 
    MemComponent::component_t mem_component = m_outstanding_shmem_msg.getSenderMemComponent();
-   assert(mem_component == MemComponent::L1_DCACHE);
+   assert((mem_component == MemComponent::L1_DCACHE) || (mem_component == MemComponent::L1_PEP_DCACHE));
 
    insertCacheBlockInL1(mem_component, address, l2_cache_block_info, CacheState::MODIFIED, data_buf);
 
    // Set the Counters in the Shmem Perf model accordingly
    // Set the counter value in the USER thread to that in the SIM thread
-   getShmemPerfModel()->setCycleCount(ShmemPerfModel::_USER_THREAD, 
+   getShmemPerfModel()->setCycleCount(getUserThread(mem_component), 
          getShmemPerfModel()->getCycleCount());
 }
 
-void
+bool
 L2CacheCntlr::processShRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg)
 {
    // Update Shared Mem perf counters for access to L2 Cache
@@ -308,21 +540,65 @@ L2CacheCntlr::processShRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_ms
 
    // Insert Cache Block in L2 Cache
    PrL2CacheBlockInfo* l2_cache_block_info = insertCacheBlock(address, CacheState::SHARED, data_buf);
+   m_mshr_perf_model->completeEntry(address, getShmemPerfModel()->getCycleCount());
 
-   // Insert Cache Block in L1 Cache
-   // Support for non-blocking caches can be added in this way
-   LOG_ASSERT_ERROR(address == m_outstanding_shmem_msg.getAddress(), 
-         "Got Address(%#llx), Expected Address(%#llx) from Directory",
-         address, m_outstanding_shmem_msg.getAddress());
+   MemComponent::component_t mem_component;
 
-   MemComponent::component_t mem_component = m_outstanding_shmem_msg.getSenderMemComponent();
+   std::map<IntPtr, MemComponent::component_t>::iterator prefetch_it = m_outstanding_prefetch_map.find(address);
+   if (prefetch_it != m_outstanding_prefetch_map.end())
+   {
+      MemComponent::component_t prefetch_mem_component = prefetch_it->second;
+      m_outstanding_prefetch_map.erase(prefetch_it);
+
+      if (!isShmemReqDeferred(address))
+      {
+         // Remember the prefetcher until the first demand access to the block
+         l2_cache_block_info->setPrefetchSource(prefetch_mem_component);
+         return false;
+      }
+
+      // A request from the L1 Cache was waiting for the prefetch
+      ShmemMsg* deferred_shmem_msg = m_deferred_shmem_msg;
+      m_deferred_shmem_msg = NULL;
+      mem_component = deferred_shmem_msg->getSenderMemComponent();
+      if (deferred_shmem_msg->getMsgType() == ShmemMsg::EX_REQ)
+      {
+         // The block is only readable. Ask the Dram Directory for an upgrade
+         m_outstanding_shmem_msg.setAddress(address);
+         m_outstanding_shmem_msg.setSenderMemComponent(mem_component);
+         m_outstanding_shmem_msg.setMsgType(ShmemMsg::EX_REQ);
+
+         getShmemPerfModel()->setCycleCount(m_mshr_perf_model->allocateEntry(address,
+                  getShmemPerfModel()->getCycleCount()));
+
+         ShmemMsg send_shmem_msg(ShmemMsg::EX_REQ, MemComponent::L2_CACHE, MemComponent::DRAM_DIR,
+               m_tile_id, INVALID_TILE_ID, false, address);
+         getMemoryManager()->sendMsg(getHome(address), send_shmem_msg);
+
+         delete deferred_shmem_msg;
+         return false;
+      }
+      delete deferred_shmem_msg;
+   }
+   else
+   {
+      // Insert Cache Block in L1 Cache
+      // Support for non-blocking caches can be added in this way
+      LOG_ASSERT_ERROR(address == m_outstanding_shmem_msg.getAddress(), 
+            "Got Address(%#llx), Expected Address(%#llx) from Directory",
+            address, m_outstanding_shmem_msg.getAddress());
+
+      mem_component = m_outstanding_shmem_msg.getSenderMemComponent();
+   }
    
    insertCacheBlockInL1(mem_component, address, l2_cache_block_info, CacheState::SHARED, data_buf);
    
    // Set the Counters in the Shmem Perf model accordingly
    // Set the counter value in the USER thread to that in the SIM thread
-   getShmemPerfModel()->setCycleCount(ShmemPerfModel::_USER_THREAD, 
+   getShmemPerfModel()->setCycleCount(getUserThread(mem_component), 
          getShmemPerfModel()->getCycleCount());
+
+   return true;
 }
 
 void
@@ -344,6 +620,7 @@ L2CacheCntlr::processUpgradeRepFromDramDirectory(tile_id_t sender, ShmemMsg* shm
          "Address(%#llx), State(%u)", address, curr_cstate);
 
    setCacheState(l2_cache_block_info, CacheState::MODIFIED);
+   m_mshr_perf_model->completeEntry(address, getShmemPerfModel()->getCycleCount());
 
    // In L1
    LOG_ASSERT_ERROR(address == m_outstanding_shmem_msg.getAddress(), 
@@ -351,25 +628,25 @@ L2CacheCntlr::processUpgradeRepFromDramDirectory(tile_id_t sender, ShmemMsg* shm
          address, m_outstanding_shmem_msg.getAddress());
 
    MemComponent::component_t mem_component = m_outstanding_shmem_msg.getSenderMemComponent();
-   assert(mem_component == MemComponent::L1_DCACHE);
+   assert((mem_component == MemComponent::L1_DCACHE) || (mem_component == MemComponent::L1_PEP_DCACHE));
    
    CacheState::cstate_t l1_cstate = getCacheStateInL1(mem_component, address);
    if (l1_cstate == CacheState::INVALID)
    {
-      assert(l2_cache_block_info->getCachedLoc() == MemComponent::INVALID_MEM_COMPONENT);
+      assert(!isCachedInL1(mem_component, l2_cache_block_info));
       Byte data_buf[getCacheBlockSize()];
       retrieveCacheBlock(address, data_buf);
       insertCacheBlockInL1(mem_component, address, l2_cache_block_info, CacheState::MODIFIED, data_buf);
    }
    else
    {
-      assert(l2_cache_block_info->getCachedLoc() != MemComponent::INVALID_MEM_COMPONENT);
-      setCacheStateInL1(mem_component, address, CacheState::MODIFIED);
+      assert(isCachedInL1(mem_component, l2_cache_block_info));
+      m_l1_cache_cntlr->setCacheState(mem_component, address, CacheState::MODIFIED);
    }
 
    // Set the Counters in the Shmem Perf model accordingly
    // Set the counter value in the USER thread to that in the SIM thread
-   getShmemPerfModel()->setCycleCount(ShmemPerfModel::_USER_THREAD,
+   getShmemPerfModel()->setCycleCount(getUserThread(mem_component),
          getShmemPerfModel()->getCycleCount());
 }
 
@@ -391,7 +668,7 @@ L2CacheCntlr::processInvReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_m
 
       // SHARED -> INVALID 
       // Invalidate the line in L1 Cache
-      invalidateCacheBlockInL1(l2_cache_block_info->getCachedLoc(), address);
+      invalidateCacheBlockInL1(l2_cache_block_info->getCachedLocBitVec(), address);
       // Invalidate the line in the L2 cache also
       invalidateCacheBlock(address);
 
@@ -429,7 +706,7 @@ L2CacheCntlr::processFlushReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem
 
       // Invalidate the line in L1 Cache
       // (MODIFIED, OWNED, SHARED) -> INVALID
-      invalidateCacheBlockInL1(l2_cache_block_info->getCachedLoc(), address);
+      invalidateCacheBlockInL1(l2_cache_block_info->getCachedLocBitVec(), address);
 
       // Flush the line
       Byte data_buf[getCacheBlockSize()];
@@ -474,7 +751,7 @@ L2CacheCntlr::processWbReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_ms
       CacheState::cstate_t new_cstate = (cstate == CacheState::MODIFIED) ? CacheState::OWNED : cstate;
       // Set the Appropriate Cache State in L1 also
       // MODIFIED -> OWNED, OWNED -> OWNED, SHARED -> SHARED
-      setCacheStateInL1(l2_cache_block_info->getCachedLoc(), address, new_cstate);
+      setCacheStateInL1(l2_cache_block_info->getCachedLocBitVec(), address, new_cstate);
 
       // Write-Back the line
       Byte data_buf[getCacheBlockSize()];
@@ -509,7 +786,7 @@ L2CacheCntlr::processInvFlushCombinedReqFromDramDirectory(tile_id_t sender, Shme
 }
 
 bool
-L2CacheCntlr::shmemReqEndsInL2Cache(ShmemMsg::msg_t shmem_msg_type, CacheState::cstate_t cstate, bool modeled)
+L2CacheCntlr::shmemReqEndsInL2Cache(ShmemMsg::msg_t shmem_msg_type, IntPtr address, CacheState::cstate_t cstate, bool modeled)
 {
    bool cache_hit = false;
 
@@ -530,7 +807,7 @@ L2CacheCntlr::shmemReqEndsInL2Cache(ShmemMsg::msg_t shmem_msg_type, CacheState::
 
    if (modeled)
    {
-      m_l2_cache->updateCounters(cache_hit);
+      m_l2_cache->updateCounters(address, cache_hit);
    }
 
    return cache_hit;
@@ -563,7 +840,7 @@ L2CacheCntlr::acquireL1CacheLock(ShmemMsg::msg_t msg_type, IntPtr address)
             
             releaseLock();
 
-            assert(caching_mem_component != MemComponent::L1_ICACHE);
+            assert((caching_mem_component != MemComponent::L1_ICACHE) && (caching_mem_component != MemComponent::L1_PEP_ICACHE));
             if (caching_mem_component != MemComponent::INVALID_MEM_COMPONENT)
             {
                m_l1_cache_cntlr->acquireLock(caching_mem_component);
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <map>
+#include <deque>
+#include <vector>
+
 // Forward declarations
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -17,6 +21,8 @@ namespace PrL1PrL2DramDirectoryMOSI
 #include "lock.h"
 #include "fixed_types.h"
 #include "shmem_perf_model.h"
+#include "mshr_perf_model.h"
+#include "prefetcher.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
@@ -26,12 +32,25 @@ namespace PrL1PrL2DramDirectoryMOSI
          // Data Members
          MemoryManager* m_memory_manager;
          Cache* m_l2_cache;
+         MshrPerfModel* m_mshr_perf_model;
          L1CacheCntlr* m_l1_cache_cntlr;
          AddressHomeLookup* m_dram_directory_home_lookup;
 
          // Outstanding ShmemReq info
          ShmemMsg m_outstanding_shmem_msg;
 
+         // Prefetching
+         static const UInt32 MAX_PREFETCH_QUEUE_SIZE = 32;
+         Prefetcher* m_l2_cache_prefetcher;
+         // Prefetches waiting to be issued, with the prefetcher that asked for them
+         std::deque<std::pair<IntPtr, MemComponent::component_t> > m_prefetch_queue;
+         // Prefetches sent to the Dram Directory, with the prefetcher that asked for them
+         std::map<IntPtr, MemComponent::component_t> m_outstanding_prefetch_map;
+         // Prefetches use the MSHRs left over by the demand request
+         UInt32 m_max_outstanding_prefetches;
+         // Request from the L1 Cache that waits for a prefetch to the same block
+         ShmemMsg* m_deferred_shmem_msg;
+
          tile_id_t m_tile_id;
          UInt32 m_cache_block_size;
 
@@ -49,6 +68,13 @@ namespace PrL1PrL2DramDirectoryMOSI
          void setCacheState(PrL2CacheBlockInfo* l2_cache_block_info, CacheState::cstate_t cstate);
 
          PrL2CacheBlockInfo* getCacheBlockInfo(IntPtr address);
+
+         // Prefetching
+         Prefetcher* getPrefetcher(MemComponent::component_t prefetch_mem_component);
+         void issuePrefetches(IntPtr demand_address);
+         bool isPrefetchRep(ShmemMsg::msg_t msg_type, IntPtr address);
+         void recordPrefetchUse(PrL2CacheBlockInfo* l2_cache_block_info);
+         void recordPrefetchEviction(PrL2CacheBlockInfo* l2_cache_block_info);
          
          // L2 Cache data operations
          void invalidateCacheBlock(IntPtr address);
@@ -57,17 +83,25 @@ namespace PrL1PrL2DramDirectoryMOSI
 
          // L1 Cache data manipulations
          CacheState::cstate_t getCacheStateInL1(MemComponent::component_t mem_component, IntPtr address);
-         void setCacheStateInL1(MemComponent::component_t mem_component, IntPtr address, CacheState::cstate_t cstate);
-         void invalidateCacheBlockInL1(MemComponent::component_t mem_component, IntPtr address);
+         void setCacheStateInL1(UInt32 cached_loc_bitvec, IntPtr address, CacheState::cstate_t cstate);
+         void invalidateCacheBlockInL1(UInt32 cached_loc_bitvec, IntPtr address);
          void insertCacheBlockInL1(MemComponent::component_t mem_component, IntPtr address, PrL2CacheBlockInfo* l2_cache_block_info, CacheState::cstate_t cstate, Byte* data_buf);
 
+         // The main and the PEP core's L1 Caches of the same kind
+         MemComponent::component_t getSiblingL1Cache(MemComponent::component_t mem_component);
+         bool isCachedInL1(MemComponent::component_t mem_component, PrL2CacheBlockInfo* l2_cache_block_info);
+         void updateSiblingL1Cache(MemComponent::component_t req_mem_component, ShmemMsg::msg_t msg_type,
+               IntPtr address, PrL2CacheBlockInfo* l2_cache_block_info);
+         // Thread waiting on a request from an L1 Cache
+         ShmemPerfModel::Thread_t getUserThread(MemComponent::component_t mem_component);
+
          // Process Request from L1 Cache
          // Check if msg from L1 ends in the L2 cache
-         bool shmemReqEndsInL2Cache(ShmemMsg::msg_t msg_type, CacheState::cstate_t cstate, bool modeled);
+         bool shmemReqEndsInL2Cache(ShmemMsg::msg_t msg_type, IntPtr address, CacheState::cstate_t cstate, bool modeled);
 
          // Process Request from Dram Dir
          void processExRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
-         void processShRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
+         bool processShRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
          void processUpgradeRepFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
          void processInvReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
          void processFlushReqFromDramDirectory(tile_id_t sender, ShmemMsg* shmem_msg);
@@ -102,17 +136,27 @@ namespace PrL1PrL2DramDirectoryMOSI
                UInt32 cache_block_size,
                UInt32 l2_cache_size, UInt32 l2_cache_associativity,
                std::string l2_cache_replacement_policy,
+               UInt32 l2_cache_num_mshrs,
+               Prefetcher* l2_cache_prefetcher,
                ShmemPerfModel* shmem_perf_model);
          
          ~L2CacheCntlr();
 
          Cache* getL2Cache() { return m_l2_cache; }
+         MshrPerfModel* getMshrPerfModel() { return m_mshr_perf_model; }
+         Prefetcher* getL2CachePrefetcher() { return m_l2_cache_prefetcher; }
 
          // Handle Request from L1 Cache - This is done for better simulator performance
          bool processShmemReqFromL1Cache(MemComponent::component_t req_mem_component, ShmemMsg::msg_t msg_type, IntPtr address, bool modeled);
          // Write-through Cache. Hence needs to be written by user thread
          void writeCacheBlock(IntPtr address, UInt32 offset, Byte* data_buf, UInt32 data_length);
 
+         // Is the request to 'address' waiting for a prefetch of the block?
+         bool isShmemReqDeferred(IntPtr address);
+         // Queue the blocks asked for by a prefetcher. They are prefetched
+         // into the L2 Cache when MSHRs are available
+         void queuePrefetches(MemComponent::component_t prefetch_mem_component, std::vector<IntPtr>& prefetch_address_list);
+
          // Handle message from L1 Cache
          void handleMsgFromL1Cache(ShmemMsg* shmem_msg);
          // Handle message from Dram Dir
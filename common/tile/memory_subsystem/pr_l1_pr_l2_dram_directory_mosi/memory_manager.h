@@ -69,11 +69,19 @@ namespace PrL1PrL2DramDirectoryMOSI
                IntPtr address, UInt32 offset,
                Byte* data_buf, UInt32 data_length,
                bool modeled);
+         UInt32 coreInitiateMemoryAccessRange(
+               MemComponent::component_t mem_component,
+               Core::lock_signal_t lock_signal,
+               Core::mem_op_t mem_op_type,
+               IntPtr address,
+               Byte* data_buf, UInt32 data_size,
+               bool modeled);
 
          void handleMsgFromNetwork(NetPacket& packet);
 
          void sendMsg(tile_id_t receiver, ShmemMsg& shmem_msg);
          void broadcastMsg(ShmemMsg& shmem_msg);
+         void multicastMsg(const vector<tile_id_t>& receivers, ShmemMsg& shmem_msg);
        
          void updateInternalVariablesOnFrequencyChange(volatile float frequency);
 
@@ -81,6 +89,9 @@ namespace PrL1PrL2DramDirectoryMOSI
          void disableModels();
          void resetModels();
 
+         void saveSnapshot(std::string filename);
+         void loadSnapshot(std::string filename);
+
          UInt32 getModeledLength(const void* pkt_data)
          { return ((ShmemMsg*) pkt_data)->getModeledLength(); }
          bool isModeled(const void* pkt_data)
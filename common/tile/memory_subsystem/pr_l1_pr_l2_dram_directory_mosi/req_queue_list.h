@@ -1,20 +1,36 @@
 #pragma once
 
-#include <map>
-#include <queue>
-
 #include "shmem_req.h"
+#include "address_hash_map.h"
 
 namespace PrL1PrL2DramDirectoryMOSI
 {
+   // FIFO queues of requests, one per address with outstanding requests.
+   // The queues are kept in an address hash map and thread the requests
+   // through ShmemReq::m_next. The requests are recycled through a free list
    class ReqQueueList
    {
       private:
-         std::map<IntPtr, std::queue<ShmemReq*>* > m_req_queue_list;
+         struct ReqQueue
+         {
+            ShmemReq* head;
+            ShmemReq* tail;
+            UInt32 size;
+
+            ReqQueue(): head(NULL), tail(NULL), size(0) {}
+         };
+
+         AddressHashMap<ReqQueue> m_req_queue_list;
+         ShmemReq* m_free_req_list;
 
       public:
-         void enqueue(IntPtr address, ShmemReq* shmem_req);
-         ShmemReq* dequeue(IntPtr address);
+         ReqQueueList();
+         ~ReqQueueList();
+
+         // Queues a copy of shmem_msg
+         ShmemReq* enqueue(IntPtr address, ShmemMsg* shmem_msg, UInt64 time);
+         // Removes and recycles the front request
+         void dequeue(IntPtr address);
          ShmemReq* front(IntPtr address);
          UInt32 size(IntPtr address);
          bool empty(IntPtr address);
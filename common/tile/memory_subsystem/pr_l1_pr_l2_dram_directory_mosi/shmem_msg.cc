@@ -62,28 +62,21 @@ namespace PrL1PrL2DramDirectoryMOSI
    ShmemMsg*
    ShmemMsg::getShmemMsg(Byte* msg_buf)
    {
-      ShmemMsg* shmem_msg = new ShmemMsg();
-      memcpy((void*) shmem_msg, msg_buf, sizeof(*shmem_msg));
+      ShmemMsg* shmem_msg = (ShmemMsg*) msg_buf;
       if (shmem_msg->getDataLength() > 0)
-      {
-         shmem_msg->setDataBuf(new Byte[shmem_msg->getDataLength()]);
-         memcpy((void*) shmem_msg->getDataBuf(), msg_buf + sizeof(*shmem_msg), shmem_msg->getDataLength());
-      }
+         shmem_msg->setDataBuf(msg_buf + sizeof(*shmem_msg));
       return shmem_msg;
    }
 
-   Byte*
-   ShmemMsg::makeMsgBuf()
+   void
+   ShmemMsg::writeMsgBuf(Byte* msg_buf)
    {
-      Byte* msg_buf = new Byte[getMsgLen()];
       memcpy(msg_buf, (void*) this, sizeof(*this));
       if (m_data_length > 0)
       {
          LOG_ASSERT_ERROR(m_data_buf != NULL, "m_data_buf(%p)", m_data_buf);
          memcpy(msg_buf + sizeof(*this), (void*) m_data_buf, m_data_length); 
       }
-
-      return msg_buf; 
    }
 
    UInt32
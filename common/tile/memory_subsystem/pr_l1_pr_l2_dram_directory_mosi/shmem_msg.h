@@ -57,8 +57,10 @@ namespace PrL1PrL2DramDirectoryMOSI
          ~ShmemMsg();
 
          void clone(ShmemMsg* shmem_msg);
+         // The message and its data stay in 'msg_buf', which must outlive it
          static ShmemMsg* getShmemMsg(Byte* msg_buf);
-         Byte* makeMsgBuf();
+         // Writes the message and its data into 'msg_buf' (getMsgLen() bytes)
+         void writeMsgBuf(Byte* msg_buf);
          UInt32 getMsgLen();
 
          // Modeled Parameters
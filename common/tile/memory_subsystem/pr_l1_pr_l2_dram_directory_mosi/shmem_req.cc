@@ -5,23 +5,26 @@ namespace PrL1PrL2DramDirectoryMOSI
 {
    ShmemReq::ShmemReq():
       m_time(0),
-      m_tile_id(INVALID_TILE_ID)
-   {
-      m_shmem_msg = new ShmemMsg();
-   }
+      m_tile_id(INVALID_TILE_ID),
+      m_next(NULL)
+   {}
 
    ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time):
-      m_time(time),
-      m_tile_id(INVALID_TILE_ID)
+      m_tile_id(INVALID_TILE_ID),
+      m_next(NULL)
    {
-      // Make a local copy of the shmem_msg
-      m_shmem_msg = new ShmemMsg(shmem_msg);
-      LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
-            "Shmem Reqs should not have data payloads");
+      init(shmem_msg, time);
    }
 
    ShmemReq::~ShmemReq()
+   {}
+
+   void
+   ShmemReq::init(ShmemMsg* shmem_msg, UInt64 time)
    {
-      delete m_shmem_msg;
+      LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
+            "Shmem Reqs should not have data payloads");
+      m_shmem_msg = *shmem_msg;
+      m_time = time;
    }
 }
@@ -8,20 +8,27 @@ namespace PrL1PrL2DramDirectoryMOSI
    class ShmemReq
    {
       private:
-         ShmemMsg* m_shmem_msg;
+         ShmemMsg m_shmem_msg;
          UInt64 m_time;
          tile_id_t m_tile_id;
 
+         // Next request in a ReqQueueList queue (or free list)
+         ShmemReq* m_next;
+         friend class ReqQueueList;
+
       public:
          ShmemReq();
          ShmemReq(ShmemMsg* shmem_msg, UInt64 time);
          ~ShmemReq();
 
-         ShmemMsg* getShmemMsg() { return m_shmem_msg; }
+         // Makes a local copy of the shmem_msg
+         void init(ShmemMsg* shmem_msg, UInt64 time);
+
+         ShmemMsg* getShmemMsg() { return &m_shmem_msg; }
          UInt64 getTime() { return m_time; }
          tile_id_t getTileId() { return m_tile_id; }
         
-         void setShmemMsg(ShmemMsg* shmem_msg) { m_shmem_msg = shmem_msg; } 
+         void setShmemMsg(ShmemMsg* shmem_msg) { m_shmem_msg = *shmem_msg; } 
          void setTime(UInt64 time) { m_time = time; }
          void updateTime(UInt64 time)
          {
@@ -30,4 +37,5 @@ namespace PrL1PrL2DramDirectoryMOSI
          }
          void setTileId(tile_id_t tile_id) { m_tile_id = tile_id; }
    };
+
 }
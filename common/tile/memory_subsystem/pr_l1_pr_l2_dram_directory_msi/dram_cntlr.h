@@ -1,7 +1,5 @@
 #pragma once
 
-#include <map>
-
 // Forward Decls
 namespace PrL1PrL2DramDirectoryMSI
 {
@@ -11,6 +9,9 @@ namespace PrL1PrL2DramDirectoryMSI
 #include "dram_perf_model.h"
 #include "shmem_perf_model.h"
 #include "shmem_msg.h"
+#include "snapshot.h"
+#include "dram_backing_store.h"
+#include "dram_access_counter.h"
 #include "fixed_types.h"
 
 namespace PrL1PrL2DramDirectoryMSI
@@ -27,21 +28,26 @@ namespace PrL1PrL2DramDirectoryMSI
 
       private:
          MemoryManager* m_memory_manager;
-         std::map<IntPtr, Byte*> m_data_map;
+         // False in tag-only runs: no data is kept and only timing is modeled
+         bool m_data_storage_enabled;
+         DramBackingStore* m_backing_store;
          DramPerfModel* m_dram_perf_model;
          UInt32 m_cache_block_size;
          ShmemPerfModel* m_shmem_perf_model;
 
-         typedef std::map<IntPtr,UInt64> AccessCountMap;
-         AccessCountMap* m_dram_access_count;
+         // NULL unless the per-address access counts are enabled
+         DramAccessCounter* m_dram_access_counter;
 
          UInt32 getCacheBlockSize() { return m_cache_block_size; }
          MemoryManager* getMemoryManager() { return m_memory_manager; }
          ShmemPerfModel* getShmemPerfModel() { return m_shmem_perf_model; }
-         UInt64 runDramPerfModel(tile_id_t requester);
+         UInt64 runDramPerfModel(IntPtr address, tile_id_t requester);
 
-         void addToDramAccessCount(IntPtr address, access_t access_type);
-         void printDramAccessCount(void);
+         void addToDramAccessCount(IntPtr address, access_t access_type)
+         {
+            if (m_dram_access_counter != NULL)
+               m_dram_access_counter->increment(address, access_type);
+         }
 
       public:
          DramCntlr(MemoryManager* memory_manager,
@@ -58,5 +64,9 @@ namespace PrL1PrL2DramDirectoryMSI
 
          void getDataFromDram(IntPtr address, tile_id_t requester, Byte* data_buf);
          void putDataToDram(IntPtr address, tile_id_t requester, Byte* data_buf);
+
+         // Backing data (nothing in tag-only runs)
+         void saveSnapshot(SnapshotWriter& writer);
+         void loadSnapshot(SnapshotReader& reader);
    };
 }
@@ -156,11 +156,10 @@ DramDirectoryCache::replaceDirectoryEntry(IntPtr replaced_address, IntPtr addres
       DirectoryEntry* replaced_directory_entry = m_directory->getDirectoryEntry(set_index * m_associativity + i);
       if (replaced_directory_entry->getAddress() == replaced_address)
       {
-         m_replaced_directory_entry_list.push_back(replaced_directory_entry);
+         m_replaced_directory_entry_list.push_back(m_directory->spillDirectoryEntry(set_index * m_associativity + i));
 
-         DirectoryEntry* directory_entry = m_directory->createDirectoryEntry();
+         DirectoryEntry* directory_entry = replaced_directory_entry;
          directory_entry->setAddress(address);
-         m_directory->setDirectoryEntry(set_index * m_associativity + i, directory_entry);
 
 #ifdef DETAILED_TRACKING_ENABLED
          m_replaced_address_map[replaced_address] ++;
@@ -183,7 +182,7 @@ DramDirectoryCache::invalidateDirectoryEntry(IntPtr address)
    {
       if ((*it)->getAddress() == address)
       {
-         delete (*it);
+         m_directory->releaseDirectoryEntry(*it);
          m_replaced_directory_entry_list.erase(it);
 
          return;
@@ -232,6 +231,24 @@ DramDirectoryCache::updateInternalVariablesOnFrequencyChange(volatile float core
       static_cast<UInt64>(ceil(static_cast<float>(m_dram_directory_cache_access_delay_in_ns) * core_frequency));
 }
 
+// Entries that are being replaced (m_replaced_directory_entry_list) belong to
+// requests in flight and are not saved
+void
+DramDirectoryCache::saveSnapshot(SnapshotWriter& writer)
+{
+   writer.write<UInt32>(m_associativity);
+   m_directory->saveSnapshot(writer);
+}
+
+void
+DramDirectoryCache::loadSnapshot(SnapshotReader& reader)
+{
+   UInt32 associativity = reader.read<UInt32>();
+   LOG_ASSERT_ERROR(associativity == m_associativity, "Dram directory snapshot associativity(%u), expected(%u)",
+         associativity, m_associativity);
+   m_directory->loadSnapshot(reader);
+}
+
 void
 DramDirectoryCache::outputSummary(ostream& out)
 {
@@ -75,6 +75,9 @@ namespace PrL1PrL2DramDirectoryMSI
 
          void updateInternalVariablesOnFrequencyChange(volatile float core_frequency);
 
+         void saveSnapshot(SnapshotWriter& writer);
+         void loadSnapshot(SnapshotReader& reader);
+
          void outputSummary(std::ostream& os);
          static void dummyOutputSummary(std::ostream& os);
    };
@@ -61,8 +61,7 @@ DramDirectoryCntlr::handleMsgFromL2Cache(tile_id_t sender, ShmemMsg* shmem_msg)
             IntPtr address = shmem_msg->getAddress();
             
             // Add request onto a queue
-            ShmemReq* shmem_req = new ShmemReq(shmem_msg, msg_time);
-            m_dram_directory_req_queue_list->enqueue(address, shmem_req);
+            ShmemReq* shmem_req = m_dram_directory_req_queue_list->enqueue(address, shmem_msg, msg_time);
             if (m_dram_directory_req_queue_list->size(address) == 1)
             {
                if (shmem_msg_type == ShmemMsg::EX_REQ)
@@ -99,8 +98,7 @@ DramDirectoryCntlr::processNextReqFromL2Cache(IntPtr address)
    LOG_PRINT("Start processNextReqFromL2Cache(0x%x)", address);
 
    assert(m_dram_directory_req_queue_list->size(address) >= 1);
-   ShmemReq* completed_shmem_req = m_dram_directory_req_queue_list->dequeue(address);
-   delete completed_shmem_req;
+   m_dram_directory_req_queue_list->dequeue(address);
 
    if (! m_dram_directory_req_queue_list->empty(address))
    {
@@ -155,8 +153,7 @@ DramDirectoryCntlr::processDirectoryEntryAllocationReq(ShmemReq* shmem_req)
 
    ShmemMsg nullify_msg(ShmemMsg::NULLIFY_REQ, MemComponent::DRAM_DIR, MemComponent::DRAM_DIR, requester, replaced_address, NULL, 0);
 
-   ShmemReq* nullify_req = new ShmemReq(&nullify_msg, msg_time);
-   m_dram_directory_req_queue_list->enqueue(replaced_address, nullify_req);
+   ShmemReq* nullify_req = m_dram_directory_req_queue_list->enqueue(replaced_address, &nullify_msg, msg_time);
 
    assert(m_dram_directory_req_queue_list->size(replaced_address) == 1);
    processNullifyReq(nullify_req);
@@ -173,8 +170,7 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req)
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -201,15 +197,12 @@ DramDirectoryCntlr::processNullifyReq(ShmemReq* shmem_req)
             }
             else
             {
-               // Send Invalidation Request to only a specific set of sharers
-               for (UInt32 i = 0; i < sharers_list_pair.second.size(); i++)
-               {
-                  getMemoryManager()->sendMsg(ShmemMsg::INV_REQ, 
-                        MemComponent::DRAM_DIR, MemComponent::L2_CACHE, 
-                        requester /* requester */, 
-                        sharers_list_pair.second[i] /* receiver */, 
-                        address);
-               }
+               // Multicast Invalidation Request to only a specific set of sharers
+               getMemoryManager()->multicastMsg(ShmemMsg::INV_REQ, 
+                     MemComponent::DRAM_DIR, MemComponent::L2_CACHE, 
+                     requester /* requester */, 
+                     sharers_list_pair.second /* receivers */, 
+                     address);
             }
          }
          break;
@@ -243,8 +236,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, Byte* cached_da
       directory_entry = processDirectoryEntryAllocationReq(shmem_req);
    }
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -273,15 +265,12 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, Byte* cached_da
             }
             else
             {
-               // Send Invalidation Request to only a specific set of sharers
-               for (UInt32 i = 0; i < sharers_list_pair.second.size(); i++)
-               {
-                  getMemoryManager()->sendMsg(ShmemMsg::INV_REQ, 
-                        MemComponent::DRAM_DIR, MemComponent::L2_CACHE, 
-                        requester /* requester */, 
-                        sharers_list_pair.second[i] /* receiver */, 
-                        address);
-               }
+               // Multicast Invalidation Request to only a specific set of sharers
+               getMemoryManager()->multicastMsg(ShmemMsg::INV_REQ, 
+                     MemComponent::DRAM_DIR, MemComponent::L2_CACHE, 
+                     requester /* requester */, 
+                     sharers_list_pair.second /* receivers */, 
+                     address);
             }
          }
          break;
@@ -293,7 +282,7 @@ DramDirectoryCntlr::processExReqFromL2Cache(ShmemReq* shmem_req, Byte* cached_da
             bool add_result = directory_entry->addSharer(requester);
             assert(add_result == true);
             directory_entry->setOwner(requester);
-            directory_block_info->setDState(DirectoryState::MODIFIED);
+            directory_entry->setDState(DirectoryState::MODIFIED);
 
             retrieveDataAndSendToL2Cache(ShmemMsg::EX_REP, requester, address, cached_data_buf);
 
@@ -320,8 +309,7 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, Byte* cached_da
       directory_entry = processDirectoryEntryAllocationReq(shmem_req);
    }
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   DirectoryState::dstate_t curr_dstate = directory_block_info->getDState();
+   DirectoryState::dstate_t curr_dstate = directory_entry->getDState();
 
    switch (curr_dstate)
    {
@@ -364,7 +352,7 @@ DramDirectoryCntlr::processShReqFromL2Cache(ShmemReq* shmem_req, Byte* cached_da
             // Modifiy the directory entry contents
             bool add_result = directory_entry->addSharer(requester);
             assert(add_result == true);
-            directory_block_info->setDState(DirectoryState::SHARED);
+            directory_entry->setDState(DirectoryState::SHARED);
 
             retrieveDataAndSendToL2Cache(ShmemMsg::SH_REP, requester, address, cached_data_buf);
       
@@ -420,13 +408,12 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   assert(directory_block_info->getDState() == DirectoryState::SHARED);
+   assert(directory_entry->getDState() == DirectoryState::SHARED);
 
    directory_entry->removeSharer(sender);
    if (directory_entry->getNumSharers() == 0)
    {
-      directory_block_info->setDState(DirectoryState::UNCACHED);
+      directory_entry->setDState(DirectoryState::UNCACHED);
    }
 
    if (m_dram_directory_req_queue_list->size(address) > 0)
@@ -440,7 +427,7 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
       if (shmem_req->getShmemMsg()->getMsgType() == ShmemMsg::EX_REQ)
       {
          // An ShmemMsg::EX_REQ caused the invalidation
-         if (directory_block_info->getDState() == DirectoryState::UNCACHED)
+         if (directory_entry->getDState() == DirectoryState::UNCACHED)
          {
             processExReqFromL2Cache(shmem_req);
          }
@@ -452,7 +439,7 @@ DramDirectoryCntlr::processInvRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_m
       }
       else // shmem_req->getShmemMsg()->getMsgType() == ShmemMsg::NULLIFY_REQ
       {
-         if (directory_block_info->getDState() == DirectoryState::UNCACHED)
+         if (directory_entry->getDState() == DirectoryState::UNCACHED)
          {
             processNullifyReq(shmem_req);
          }
@@ -468,12 +455,11 @@ DramDirectoryCntlr::processFlushRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
 
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
-   assert(directory_block_info->getDState() == DirectoryState::MODIFIED);
+   assert(directory_entry->getDState() == DirectoryState::MODIFIED);
 
    directory_entry->removeSharer(sender);
    directory_entry->setOwner(INVALID_TILE_ID);
-   directory_block_info->setDState(DirectoryState::UNCACHED);
+   directory_entry->setDState(DirectoryState::UNCACHED);
 
    if (m_dram_directory_req_queue_list->size(address) != 0)
    {
@@ -517,13 +503,12 @@ DramDirectoryCntlr::processWbRepFromL2Cache(tile_id_t sender, ShmemMsg* shmem_ms
    DirectoryEntry* directory_entry = m_dram_directory_cache->getDirectoryEntry(address);
    assert(directory_entry);
    
-   DirectoryBlockInfo* directory_block_info = directory_entry->getDirectoryBlockInfo();
 
-   assert(directory_block_info->getDState() == DirectoryState::MODIFIED);
+   assert(directory_entry->getDState() == DirectoryState::MODIFIED);
    assert(directory_entry->hasSharer(sender));
    
    directory_entry->setOwner(INVALID_TILE_ID);
-   directory_block_info->setDState(DirectoryState::SHARED);
+   directory_entry->setDState(DirectoryState::SHARED);
 
    if (m_dram_directory_req_queue_list->size(address) != 0)
    {
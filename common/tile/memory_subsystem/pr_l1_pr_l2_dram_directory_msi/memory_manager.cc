@@ -20,6 +20,9 @@ MemoryManager::MemoryManager(Tile* tile,
    UInt32 l1_icache_size = 0;
    UInt32 l1_icache_associativity = 0;
    std::string l1_icache_replacement_policy;
+   UInt32 l1_icache_num_mshrs = 0;
+   volatile float l1_icache_stack_distance_sampling_rate = 0.0;
+   bool l1_icache_heatmap_enabled = false;
    UInt32 l1_icache_data_access_time = 0;
    UInt32 l1_icache_tags_access_time = 0;
    std::string l1_icache_perf_model_type;
@@ -28,6 +31,12 @@ MemoryManager::MemoryManager(Tile* tile,
    UInt32 l1_dcache_size = 0;
    UInt32 l1_dcache_associativity = 0;
    std::string l1_dcache_replacement_policy;
+   UInt32 l1_dcache_num_mshrs = 0;
+   volatile float l1_dcache_stack_distance_sampling_rate = 0.0;
+   bool l1_dcache_heatmap_enabled = false;
+   std::string l1_dcache_prefetcher_type;
+   UInt32 l1_dcache_prefetch_degree = 0;
+   UInt32 l1_dcache_prefetch_distance = 0;
    UInt32 l1_dcache_data_access_time = 0;
    UInt32 l1_dcache_tags_access_time = 0;
    std::string l1_dcache_perf_model_type;
@@ -36,6 +45,12 @@ MemoryManager::MemoryManager(Tile* tile,
    UInt32 l2_cache_size = 0;
    UInt32 l2_cache_associativity = 0;
    std::string l2_cache_replacement_policy;
+   UInt32 l2_cache_num_mshrs = 0;
+   volatile float l2_cache_stack_distance_sampling_rate = 0.0;
+   bool l2_cache_heatmap_enabled = false;
+   std::string l2_cache_prefetcher_type;
+   UInt32 l2_cache_prefetch_degree = 0;
+   UInt32 l2_cache_prefetch_distance = 0;
    UInt32 l2_cache_data_access_time = 0;
    UInt32 l2_cache_tags_access_time = 0;
    std::string l2_cache_perf_model_type;
@@ -63,6 +78,9 @@ MemoryManager::MemoryManager(Tile* tile,
       l1_icache_size = Sim()->getCfg()->getInt(l1_icache_type + "/cache_size");
       l1_icache_associativity = Sim()->getCfg()->getInt(l1_icache_type + "/associativity");
       l1_icache_replacement_policy = Sim()->getCfg()->getString(l1_icache_type + "/replacement_policy");
+      l1_icache_num_mshrs = Sim()->getCfg()->getInt(l1_icache_type + "/num_mshrs");
+      l1_icache_stack_distance_sampling_rate = Sim()->getCfg()->getFloat(l1_icache_type + "/stack_distance_sampling_rate");
+      l1_icache_heatmap_enabled = Sim()->getCfg()->getBool(l1_icache_type + "/heatmap");
       l1_icache_data_access_time = Sim()->getCfg()->getInt(l1_icache_type + "/data_access_time");
       l1_icache_tags_access_time = Sim()->getCfg()->getInt(l1_icache_type + "/tags_access_time");
       l1_icache_perf_model_type = Sim()->getCfg()->getString(l1_icache_type + "/perf_model_type");
@@ -72,6 +90,12 @@ MemoryManager::MemoryManager(Tile* tile,
       l1_dcache_size = Sim()->getCfg()->getInt(l1_dcache_type + "/cache_size");
       l1_dcache_associativity = Sim()->getCfg()->getInt(l1_dcache_type + "/associativity");
       l1_dcache_replacement_policy = Sim()->getCfg()->getString(l1_dcache_type + "/replacement_policy");
+      l1_dcache_num_mshrs = Sim()->getCfg()->getInt(l1_dcache_type + "/num_mshrs");
+      l1_dcache_stack_distance_sampling_rate = Sim()->getCfg()->getFloat(l1_dcache_type + "/stack_distance_sampling_rate");
+      l1_dcache_heatmap_enabled = Sim()->getCfg()->getBool(l1_dcache_type + "/heatmap");
+      l1_dcache_prefetcher_type = Sim()->getCfg()->getString(l1_dcache_type + "/prefetcher");
+      l1_dcache_prefetch_degree = Sim()->getCfg()->getInt(l1_dcache_type + "/prefetch_degree");
+      l1_dcache_prefetch_distance = Sim()->getCfg()->getInt(l1_dcache_type + "/prefetch_distance");
       l1_dcache_data_access_time = Sim()->getCfg()->getInt(l1_dcache_type + "/data_access_time");
       l1_dcache_tags_access_time = Sim()->getCfg()->getInt(l1_dcache_type + "/tags_access_time");
       l1_dcache_perf_model_type = Sim()->getCfg()->getString(l1_dcache_type + "/perf_model_type");
@@ -81,6 +105,12 @@ MemoryManager::MemoryManager(Tile* tile,
       l2_cache_size = Sim()->getCfg()->getInt(l2_cache_type + "/cache_size");
       l2_cache_associativity = Sim()->getCfg()->getInt(l2_cache_type + "/associativity");
       l2_cache_replacement_policy = Sim()->getCfg()->getString(l2_cache_type + "/replacement_policy");
+      l2_cache_num_mshrs = Sim()->getCfg()->getInt(l2_cache_type + "/num_mshrs");
+      l2_cache_stack_distance_sampling_rate = Sim()->getCfg()->getFloat(l2_cache_type + "/stack_distance_sampling_rate");
+      l2_cache_heatmap_enabled = Sim()->getCfg()->getBool(l2_cache_type + "/heatmap");
+      l2_cache_prefetcher_type = Sim()->getCfg()->getString(l2_cache_type + "/prefetcher");
+      l2_cache_prefetch_degree = Sim()->getCfg()->getInt(l2_cache_type + "/prefetch_degree");
+      l2_cache_prefetch_distance = Sim()->getCfg()->getInt(l2_cache_type + "/prefetch_distance");
       l2_cache_data_access_time = Sim()->getCfg()->getInt(l2_cache_type + "/data_access_time");
       l2_cache_tags_access_time = Sim()->getCfg()->getInt(l2_cache_type + "/tags_access_time");
       l2_cache_perf_model_type = Sim()->getCfg()->getString(l2_cache_type + "/perf_model_type");
@@ -149,7 +179,14 @@ MemoryManager::MemoryManager(Tile* tile,
    }
 
 
-   m_dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_dram_controllers, getCacheBlockSize());
+   m_dram_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, tile_list_with_dram_controllers, getCacheBlockSize(),
+         getTile()->getId(), getNetwork());
+
+   // Prefetchers (NULL if disabled). The cache controllers own them
+   Prefetcher* l1_dcache_prefetcher = Prefetcher::create("L1-D", l1_dcache_prefetcher_type,
+         getCacheBlockSize(), l1_dcache_prefetch_degree, l1_dcache_prefetch_distance);
+   Prefetcher* l2_cache_prefetcher = Prefetcher::create("L2", l2_cache_prefetcher_type,
+         getCacheBlockSize(), l2_cache_prefetch_degree, l2_cache_prefetch_distance);
 
    m_l1_cache_cntlr = new L1CacheCntlr(getTile()->getId(),
          this,
@@ -158,8 +195,11 @@ MemoryManager::MemoryManager(Tile* tile,
          getCacheBlockSize(),
          l1_icache_size, l1_icache_associativity,
          l1_icache_replacement_policy,
+         l1_icache_num_mshrs,
          l1_dcache_size, l1_dcache_associativity,
          l1_dcache_replacement_policy,
+         l1_dcache_num_mshrs,
+         l1_dcache_prefetcher,
          getShmemPerfModel());
    
    m_l2_cache_cntlr = new L2CacheCntlr(getTile()->getId(),
@@ -171,10 +211,31 @@ MemoryManager::MemoryManager(Tile* tile,
          getCacheBlockSize(),
          l2_cache_size, l2_cache_associativity,
          l2_cache_replacement_policy,
+         l2_cache_num_mshrs,
+         l2_cache_prefetcher,
          getShmemPerfModel());
 
    m_l1_cache_cntlr->setL2CacheCntlr(m_l2_cache_cntlr);
 
+   // Stack Distance Profilers (miss rate curves)
+   if (l1_icache_stack_distance_sampling_rate > 0.0)
+      m_l1_cache_cntlr->getL1ICache()->setStackDistanceProfiler(
+            new StackDistanceProfiler(getCacheBlockSize(), l1_icache_stack_distance_sampling_rate));
+   if (l1_dcache_stack_distance_sampling_rate > 0.0)
+      m_l1_cache_cntlr->getL1DCache()->setStackDistanceProfiler(
+            new StackDistanceProfiler(getCacheBlockSize(), l1_dcache_stack_distance_sampling_rate));
+   if (l2_cache_stack_distance_sampling_rate > 0.0)
+      m_l2_cache_cntlr->getL2Cache()->setStackDistanceProfiler(
+            new StackDistanceProfiler(getCacheBlockSize(), l2_cache_stack_distance_sampling_rate));
+
+   // Per-set hit/miss/eviction heatmaps
+   if (l1_icache_heatmap_enabled)
+      attachCacheHeatmap(m_l1_cache_cntlr->getL1ICache());
+   if (l1_dcache_heatmap_enabled)
+      attachCacheHeatmap(m_l1_cache_cntlr->getL1DCache());
+   if (l2_cache_heatmap_enabled)
+      attachCacheHeatmap(m_l2_cache_cntlr->getL2Cache());
+
    // Create Cache Performance Models
    volatile float core_frequency = Config::getSingleton()->getCoreFrequency(getTile()->getMainCoreId());
    m_l1_icache_perf_model = CachePerfModel::create(l1_icache_perf_model_type,
@@ -228,6 +289,23 @@ MemoryManager::coreInitiateMemoryAccess(
          modeled);
 }
 
+UInt32
+MemoryManager::coreInitiateMemoryAccessRange(
+      MemComponent::component_t mem_component,
+      Core::lock_signal_t lock_signal,
+      Core::mem_op_t mem_op_type,
+      IntPtr address,
+      Byte* data_buf, UInt32 data_size,
+      bool modeled)
+{
+   return m_l1_cache_cntlr->processMemOpRangeFromTile(mem_component,
+         lock_signal,
+         mem_op_type,
+         address,
+         data_buf, data_size,
+         modeled);
+}
+
 void
 MemoryManager::handleMsgFromNetwork(NetPacket& packet)
 {
@@ -253,6 +331,8 @@ MemoryManager::handleMsgFromNetwork(NetPacket& packet)
          {
             case MemComponent::L1_ICACHE:
             case MemComponent::L1_DCACHE:
+            case MemComponent::L1_PEP_ICACHE:
+            case MemComponent::L1_PEP_DCACHE:
                assert(sender.tile_id == getTile()->getId());
                m_l2_cache_cntlr->handleMsgFromL1Cache(shmem_msg);
                break;
@@ -290,16 +370,8 @@ MemoryManager::handleMsgFromNetwork(NetPacket& packet)
          break;
    }
 
-   // Delete the allocated Shared Memory Message
-   // First delete 'data_buf' if it is present
+   // The message lives in the packet buffer, which the network frees
    // LOG_PRINT("Finished handling Shmem Msg");
-
-   if (shmem_msg->getDataLength() > 0)
-   {
-      assert(shmem_msg->getDataBuf());
-      delete [] shmem_msg->getDataBuf();
-   }
-   delete shmem_msg;
 }
 
 void
@@ -308,7 +380,9 @@ MemoryManager::sendMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sende
    assert((data_buf == NULL) == (data_length == 0));
    ShmemMsg shmem_msg(msg_type, sender_mem_component, receiver_mem_component, requester, address, data_buf, data_length);
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // Built in place in the network buffer
+   Byte* msg_buf = NetPacket::allocPayload(shmem_msg.getMsgLen());
+   shmem_msg.writeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    if (m_enabled)
@@ -319,10 +393,7 @@ MemoryManager::sendMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sende
    NetPacket packet(msg_time, SHARED_MEM_1,
          getTile()->getId(), receiver,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
-   getNetwork()->netSend(packet);
-
-   // Delete the Msg Buf
-   delete [] msg_buf;
+   getNetwork()->netSendBuffer(packet);
 }
 
 void
@@ -331,7 +402,9 @@ MemoryManager::broadcastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t
    assert((data_buf == NULL) == (data_length == 0));
    ShmemMsg shmem_msg(msg_type, sender_mem_component, receiver_mem_component, requester, address, data_buf, data_length);
 
-   Byte* msg_buf = shmem_msg.makeMsgBuf();
+   // Built in place in the network buffer
+   Byte* msg_buf = NetPacket::allocPayload(shmem_msg.getMsgLen());
+   shmem_msg.writeMsgBuf(msg_buf);
    UInt64 msg_time = getShmemPerfModel()->getCycleCount();
 
    if (m_enabled)
@@ -342,10 +415,38 @@ MemoryManager::broadcastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t
    NetPacket packet(msg_time, SHARED_MEM_1,
          getTile()->getId(), NetPacket::BROADCAST,
          shmem_msg.getMsgLen(), (const void*) msg_buf);
-   getNetwork()->netSend(packet);
+   getNetwork()->netSendBuffer(packet);
+}
 
-   // Delete the Msg Buf
-   delete [] msg_buf;
+void
+MemoryManager::multicastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, tile_id_t requester, const vector<tile_id_t>& receivers, IntPtr address, Byte* data_buf, UInt32 data_length)
+{
+   assert((data_buf == NULL) == (data_length == 0));
+
+   // A single receiver, or a network that has no multicast, gets unicasts
+   if ((receivers.size() < 2) || !getNetwork()->isMulticastSupported(SHARED_MEM_1))
+   {
+      for (UInt32 i = 0; i < receivers.size(); i++)
+         sendMsg(msg_type, sender_mem_component, receiver_mem_component, requester, receivers[i], address, data_buf, data_length);
+      return;
+   }
+
+   ShmemMsg shmem_msg(msg_type, sender_mem_component, receiver_mem_component, requester, address, data_buf, data_length);
+
+   // Built in place in the network buffer, once for all the receivers
+   Byte* msg_buf = NetPacket::allocMulticastPayload(shmem_msg.getMsgLen());
+   shmem_msg.writeMsgBuf(msg_buf);
+   UInt64 msg_time = getShmemPerfModel()->getCycleCount();
+
+   if (m_enabled)
+   {
+      LOG_PRINT("Sending Msg: type(%u), address(0x%x), sender_mem_component(%u), receiver_mem_component(%u), requester(%i), sender(%i), num receivers(%u)", msg_type, address, sender_mem_component, receiver_mem_component, requester, getTile()->getId(), receivers.size());
+   }
+
+   NetPacket packet(msg_time, SHARED_MEM_1,
+         getTile()->getId(), NetPacket::MULTICAST,
+         shmem_msg.getMsgLen(), (const void*) msg_buf);
+   getNetwork()->netMulticastBuffer(packet, receivers);
 }
 
 void
@@ -353,11 +454,14 @@ MemoryManager::incrCycleCount(MemComponent::component_t mem_component, CachePerf
 {
    switch (mem_component)
    {
+      // The PEP core's L1 Caches have the same parameters as the main core's
       case MemComponent::L1_ICACHE:
+      case MemComponent::L1_PEP_ICACHE:
          getShmemPerfModel()->incrCycleCount(m_l1_icache_perf_model->getLatency(access_type));
          break;
 
       case MemComponent::L1_DCACHE:
+      case MemComponent::L1_PEP_DCACHE:
          getShmemPerfModel()->incrCycleCount(m_l1_dcache_perf_model->getLatency(access_type));
          break;
 
@@ -390,12 +494,27 @@ MemoryManager::enableModels()
 
    m_l1_cache_cntlr->getL1ICache()->enable();
    m_l1_icache_perf_model->enable();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_ICACHE)->enable();
    
    m_l1_cache_cntlr->getL1DCache()->enable();
    m_l1_dcache_perf_model->enable();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_DCACHE)->enable();
+   if (m_l1_cache_cntlr->getL1DCachePrefetcher())
+      m_l1_cache_cntlr->getL1DCachePrefetcher()->enable();
+
+   if (m_l1_cache_cntlr->getL1PepICache())
+   {
+      m_l1_cache_cntlr->getL1PepICache()->enable();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_ICACHE)->enable();
+      m_l1_cache_cntlr->getL1PepDCache()->enable();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_DCACHE)->enable();
+   }
    
    m_l2_cache_cntlr->getL2Cache()->enable();
    m_l2_cache_perf_model->enable();
+   m_l2_cache_cntlr->getMshrPerfModel()->enable();
+   if (m_l2_cache_cntlr->getL2CachePrefetcher())
+      m_l2_cache_cntlr->getL2CachePrefetcher()->enable();
 
    if (m_dram_cntlr_present)
    {
@@ -410,12 +529,27 @@ MemoryManager::disableModels()
 
    m_l1_cache_cntlr->getL1ICache()->disable();
    m_l1_icache_perf_model->disable();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_ICACHE)->disable();
 
    m_l1_cache_cntlr->getL1DCache()->disable();
    m_l1_dcache_perf_model->disable();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_DCACHE)->disable();
+   if (m_l1_cache_cntlr->getL1DCachePrefetcher())
+      m_l1_cache_cntlr->getL1DCachePrefetcher()->disable();
+
+   if (m_l1_cache_cntlr->getL1PepICache())
+   {
+      m_l1_cache_cntlr->getL1PepICache()->disable();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_ICACHE)->disable();
+      m_l1_cache_cntlr->getL1PepDCache()->disable();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_DCACHE)->disable();
+   }
 
    m_l2_cache_cntlr->getL2Cache()->disable();
    m_l2_cache_perf_model->disable();
+   m_l2_cache_cntlr->getMshrPerfModel()->disable();
+   if (m_l2_cache_cntlr->getL2CachePrefetcher())
+      m_l2_cache_cntlr->getL2CachePrefetcher()->disable();
 
    if (m_dram_cntlr_present)
    {
@@ -429,6 +563,20 @@ MemoryManager::resetModels()
    m_l1_cache_cntlr->getL1ICache()->reset();
    m_l1_cache_cntlr->getL1DCache()->reset();
    m_l2_cache_cntlr->getL2Cache()->reset();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_ICACHE)->reset();
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_DCACHE)->reset();
+   if (m_l1_cache_cntlr->getL1DCachePrefetcher())
+      m_l1_cache_cntlr->getL1DCachePrefetcher()->reset();
+   if (m_l1_cache_cntlr->getL1PepICache())
+   {
+      m_l1_cache_cntlr->getL1PepICache()->reset();
+      m_l1_cache_cntlr->getL1PepDCache()->reset();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_ICACHE)->reset();
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_DCACHE)->reset();
+   }
+   m_l2_cache_cntlr->getMshrPerfModel()->reset();
+   if (m_l2_cache_cntlr->getL2CachePrefetcher())
+      m_l2_cache_cntlr->getL2CachePrefetcher()->reset();
 
    if (m_dram_cntlr_present)
    {
@@ -436,13 +584,82 @@ MemoryManager::resetModels()
    }
 }
 
+void
+MemoryManager::saveSnapshot(std::string filename)
+{
+   SnapshotWriter writer(getTile()->getId());
+
+   m_l1_cache_cntlr->getL1ICache()->saveSnapshot(writer);
+   m_l1_cache_cntlr->getL1DCache()->saveSnapshot(writer);
+   writer.write<bool>(m_l1_cache_cntlr->getL1PepICache() != NULL);
+   if (m_l1_cache_cntlr->getL1PepICache())
+   {
+      m_l1_cache_cntlr->getL1PepICache()->saveSnapshot(writer);
+      m_l1_cache_cntlr->getL1PepDCache()->saveSnapshot(writer);
+   }
+   m_l2_cache_cntlr->getL2Cache()->saveSnapshot(writer);
+
+   writer.write<bool>(m_dram_cntlr_present);
+   if (m_dram_cntlr_present)
+   {
+      m_dram_directory_cntlr->getDramDirectoryCache()->saveSnapshot(writer);
+      m_dram_cntlr->saveSnapshot(writer);
+   }
+
+   writer.writeToFile(filename);
+}
+
+void
+MemoryManager::loadSnapshot(std::string filename)
+{
+   SnapshotReader reader(filename, getTile()->getId());
+
+   m_l1_cache_cntlr->getL1ICache()->loadSnapshot(reader);
+   m_l1_cache_cntlr->getL1DCache()->loadSnapshot(reader);
+   bool pep_core_present = reader.read<bool>();
+   LOG_ASSERT_ERROR(pep_core_present == (m_l1_cache_cntlr->getL1PepICache() != NULL),
+         "Snapshot(%s): PEP cores differ", filename.c_str());
+   if (pep_core_present)
+   {
+      m_l1_cache_cntlr->getL1PepICache()->loadSnapshot(reader);
+      m_l1_cache_cntlr->getL1PepDCache()->loadSnapshot(reader);
+   }
+   m_l2_cache_cntlr->getL2Cache()->loadSnapshot(reader);
+
+   bool dram_cntlr_present = reader.read<bool>();
+   LOG_ASSERT_ERROR(dram_cntlr_present == m_dram_cntlr_present,
+         "Snapshot(%s): memory controller placement differs", filename.c_str());
+   if (m_dram_cntlr_present)
+   {
+      m_dram_directory_cntlr->getDramDirectoryCache()->loadSnapshot(reader);
+      m_dram_cntlr->loadSnapshot(reader);
+   }
+
+   reader.finish();
+   LOG_PRINT("Loaded snapshot(%s)", filename.c_str());
+}
+
 void
 MemoryManager::outputSummary(std::ostream &os)
 {
    os << "Cache Summary:\n";
    m_l1_cache_cntlr->getL1ICache()->outputSummary(os);
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_ICACHE)->outputSummary(os);
    m_l1_cache_cntlr->getL1DCache()->outputSummary(os);
+   m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_DCACHE)->outputSummary(os);
+   if (m_l1_cache_cntlr->getL1DCachePrefetcher())
+      m_l1_cache_cntlr->getL1DCachePrefetcher()->outputSummary(os);
+   if (m_l1_cache_cntlr->getL1PepICache())
+   {
+      m_l1_cache_cntlr->getL1PepICache()->outputSummary(os);
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_ICACHE)->outputSummary(os);
+      m_l1_cache_cntlr->getL1PepDCache()->outputSummary(os);
+      m_l1_cache_cntlr->getMshrPerfModel(MemComponent::L1_PEP_DCACHE)->outputSummary(os);
+   }
    m_l2_cache_cntlr->getL2Cache()->outputSummary(os);
+   m_l2_cache_cntlr->getMshrPerfModel()->outputSummary(os);
+   if (m_l2_cache_cntlr->getL2CachePrefetcher())
+      m_l2_cache_cntlr->getL2CachePrefetcher()->outputSummary(os);
 
    if (m_dram_cntlr_present)
    {      
@@ -57,12 +57,20 @@ namespace PrL1PrL2DramDirectoryMSI
                IntPtr address, UInt32 offset,
                Byte* data_buf, UInt32 data_length,
                bool modeled);
+         UInt32 coreInitiateMemoryAccessRange(
+               MemComponent::component_t mem_component,
+               Core::lock_signal_t lock_signal,
+               Core::mem_op_t mem_op_type,
+               IntPtr address,
+               Byte* data_buf, UInt32 data_size,
+               bool modeled);
 
          void handleMsgFromNetwork(NetPacket& packet);
 
          void sendMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, tile_id_t requester, tile_id_t receiver, IntPtr address, Byte* data_buf = NULL, UInt32 data_length = 0);
 
          void broadcastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, tile_id_t requester, IntPtr address, Byte* data_buf = NULL, UInt32 data_length = 0);
+         void multicastMsg(ShmemMsg::msg_t msg_type, MemComponent::component_t sender_mem_component, MemComponent::component_t receiver_mem_component, tile_id_t requester, const vector<tile_id_t>& receivers, IntPtr address, Byte* data_buf = NULL, UInt32 data_length = 0);
         
          void updateInternalVariablesOnFrequencyChange(volatile float frequency);
 
@@ -70,6 +78,9 @@ namespace PrL1PrL2DramDirectoryMSI
          void disableModels();
          void resetModels();
 
+         void saveSnapshot(std::string filename);
+         void loadSnapshot(std::string filename);
+
          tile_id_t getShmemRequester(const void* pkt_data)
          { return ((ShmemMsg*) pkt_data)->getRequester(); }
 
@@ -5,60 +5,82 @@ using namespace std;
 
 namespace PrL1PrL2DramDirectoryMSI
 {
-   ReqQueueList::ReqQueueList() {}
+   ReqQueueList::ReqQueueList():
+      m_free_req_list(NULL)
+   {}
 
-   ReqQueueList::~ReqQueueList() {}
-
-   void
-   ReqQueueList::enqueue(IntPtr address, ShmemReq* shmem_req)
+   ReqQueueList::~ReqQueueList()
    {
-      if (m_req_queue_list[address] == NULL)
+      while (m_free_req_list)
       {
-         m_req_queue_list[address] = new queue<ShmemReq*>();
+         ShmemReq* shmem_req = m_free_req_list;
+         m_free_req_list = shmem_req->m_next;
+         delete shmem_req;
       }
-      m_req_queue_list[address]->push(shmem_req);
    }
 
    ShmemReq*
+   ReqQueueList::enqueue(IntPtr address, ShmemMsg* shmem_msg, UInt64 time)
+   {
+      ShmemReq* shmem_req = m_free_req_list;
+      if (shmem_req)
+         m_free_req_list = shmem_req->m_next;
+      else
+         shmem_req = new ShmemReq();
+      shmem_req->init(shmem_msg, time);
+      shmem_req->m_next = NULL;
+
+      ReqQueue& req_queue = m_req_queue_list[address];
+      if (req_queue.tail)
+         req_queue.tail->m_next = shmem_req;
+      else
+         req_queue.head = shmem_req;
+      req_queue.tail = shmem_req;
+      req_queue.size ++;
+
+      return shmem_req;
+   }
+
+   void
    ReqQueueList::dequeue(IntPtr address)
    {
-      LOG_ASSERT_ERROR(m_req_queue_list[address] != NULL,
+      ReqQueue* req_queue = m_req_queue_list.find(address);
+      LOG_ASSERT_ERROR(req_queue != NULL,
             "Could not find a Shmem request with address(0x%x)", address);
 
-      ShmemReq* shmem_req = m_req_queue_list[address]->front();
-      m_req_queue_list[address]->pop();
-      if (m_req_queue_list[address]->empty())
-      {
-         delete m_req_queue_list[address];
-         m_req_queue_list[address] = NULL;
-      }
-      return shmem_req;
+      ShmemReq* shmem_req = req_queue->head;
+      req_queue->head = shmem_req->m_next;
+      req_queue->size --;
+      if (req_queue->head == NULL)
+         m_req_queue_list.erase(address);
+
+      shmem_req->m_next = m_free_req_list;
+      m_free_req_list = shmem_req;
    }
 
    ShmemReq*
    ReqQueueList::front(IntPtr address)
    {
-      LOG_ASSERT_ERROR(m_req_queue_list[address] != NULL,
+      ReqQueue* req_queue = m_req_queue_list.find(address);
+      LOG_ASSERT_ERROR(req_queue != NULL,
             "Could not find a Shmem request with address(0x%x)", address);
 
-      return m_req_queue_list[address]->front();
+      return req_queue->head;
    }
 
    UInt32
    ReqQueueList::size(IntPtr address)
    {
-      if (m_req_queue_list[address] == NULL)
+      ReqQueue* req_queue = m_req_queue_list.find(address);
+      if (req_queue == NULL)
          return 0;
       else
-         return m_req_queue_list[address]->size();
+         return req_queue->size;
    }
 
    bool
    ReqQueueList::empty(IntPtr address)
    {
-      if (m_req_queue_list[address] == NULL)
-         return true;
-      else
-         return false;
+      return (m_req_queue_list.find(address) == NULL);
    }
 }
@@ -3,17 +3,26 @@
 
 namespace PrL1PrL2DramDirectoryMSI
 {
+   ShmemReq::ShmemReq():
+      m_time(0),
+      m_next(NULL)
+   {}
+
    ShmemReq::ShmemReq(ShmemMsg* shmem_msg, UInt64 time):
-      m_time(time)
+      m_next(NULL)
    {
-      // Make a local copy of the shmem_msg
-      m_shmem_msg = new ShmemMsg(shmem_msg);
-      LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
-            "Shmem Reqs should not have data payloads");
+      init(shmem_msg, time);
    }
 
    ShmemReq::~ShmemReq()
+   {}
+
+   void
+   ShmemReq::init(ShmemMsg* shmem_msg, UInt64 time)
    {
-      delete m_shmem_msg;
+      LOG_ASSERT_ERROR(shmem_msg->getDataBuf() == NULL, 
+            "Shmem Reqs should not have data payloads");
+      m_shmem_msg = *shmem_msg;
+      m_time = time;
    }
 }
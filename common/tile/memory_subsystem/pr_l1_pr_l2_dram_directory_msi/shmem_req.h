@@ -8,14 +8,22 @@ namespace PrL1PrL2DramDirectoryMSI
    class ShmemReq
    {
       private:
-         ShmemMsg* m_shmem_msg;
+         ShmemMsg m_shmem_msg;
          UInt64 m_time;
 
+         // Next request in a ReqQueueList queue (or free list)
+         ShmemReq* m_next;
+         friend class ReqQueueList;
+
       public:
+         ShmemReq();
          ShmemReq(ShmemMsg* shmem_msg, UInt64 time);
          ~ShmemReq();
 
-         ShmemMsg* getShmemMsg() { return m_shmem_msg; }
+         // Makes a local copy of the shmem_msg
+         void init(ShmemMsg* shmem_msg, UInt64 time);
+
+         ShmemMsg* getShmemMsg() { return &m_shmem_msg; }
          UInt64 getTime() { return m_time; }
          
          void setTime(UInt64 time) { m_time = time; }
@@ -0,0 +1,16 @@
+#include "next_line_prefetcher.h"
+
+NextLinePrefetcher::NextLinePrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance):
+   Prefetcher(name, cache_block_size, degree, distance)
+{}
+
+NextLinePrefetcher::~NextLinePrefetcher()
+{}
+
+void
+NextLinePrefetcher::getPrefetchAddresses(IntPtr address, bool miss,
+      std::vector<IntPtr>& prefetch_address_list)
+{
+   if (miss)
+      addPrefetchAddresses(address, 1, prefetch_address_list);
+}
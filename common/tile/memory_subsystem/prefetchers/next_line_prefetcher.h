@@ -0,0 +1,17 @@
+#ifndef __NEXT_LINE_PREFETCHER_H__
+#define __NEXT_LINE_PREFETCHER_H__
+
+#include "prefetcher.h"
+
+// On every miss, fetch the blocks that follow the missing one
+class NextLinePrefetcher : public Prefetcher
+{
+   public:
+      NextLinePrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance);
+      ~NextLinePrefetcher();
+
+      void getPrefetchAddresses(IntPtr address, bool miss,
+            std::vector<IntPtr>& prefetch_address_list);
+};
+
+#endif /* __NEXT_LINE_PREFETCHER_H__ */
@@ -0,0 +1,102 @@
+#include "prefetcher.h"
+#include "next_line_prefetcher.h"
+#include "stride_prefetcher.h"
+#include "stream_prefetcher.h"
+#include "log.h"
+
+Prefetcher::Prefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance):
+   m_cache_block_size(cache_block_size),
+   m_degree(degree),
+   m_distance(distance),
+   m_name(name),
+   m_enabled(false)
+{
+   LOG_ASSERT_ERROR(m_distance > 0, "Prefetcher %s: prefetch distance must be > 0", m_name.c_str());
+   initializePerformanceCounters();
+}
+
+Prefetcher::~Prefetcher()
+{}
+
+Prefetcher*
+Prefetcher::create(std::string name, std::string type,
+      UInt32 cache_block_size, UInt32 degree, UInt32 distance)
+{
+   if (type == "none")
+      return (Prefetcher*) NULL;
+
+   Prefetcher* prefetcher = (Prefetcher*) NULL;
+   switch (parseType(type))
+   {
+      case NEXT_LINE:
+         prefetcher = new NextLinePrefetcher(name, cache_block_size, degree, distance);
+         break;
+
+      case STRIDE:
+         prefetcher = new StridePrefetcher(name, cache_block_size, degree, distance);
+         break;
+
+      case STREAM:
+         prefetcher = new StreamPrefetcher(name, cache_block_size, degree, distance);
+         break;
+
+      default:
+         LOG_PRINT_ERROR("Unrecognized Prefetcher Type(%s)", type.c_str());
+         break;
+   }
+
+   prefetcher->m_type = type;
+   return prefetcher;
+}
+
+Prefetcher::Type
+Prefetcher::parseType(std::string type)
+{
+   if (type == "next_line")
+      return NEXT_LINE;
+   else if (type == "stride")
+      return STRIDE;
+   else if (type == "stream")
+      return STREAM;
+   else
+      return NUM_PREFETCHER_TYPES;
+}
+
+void
+Prefetcher::addPrefetchAddresses(IntPtr address, SInt64 stride,
+      std::vector<IntPtr>& prefetch_address_list)
+{
+   IntPtr page = address & ~(PAGE_SIZE - 1);
+   for (UInt32 i = 0; i < m_degree; i++)
+   {
+      IntPtr prefetch_address = address + (SInt64) (m_distance + i) * stride * (SInt64) m_cache_block_size;
+      if ((prefetch_address & ~(PAGE_SIZE - 1)) != page)
+         break;
+      prefetch_address_list.push_back(prefetch_address);
+   }
+}
+
+void
+Prefetcher::initializePerformanceCounters()
+{
+   m_num_issued = 0;
+   m_num_useful = 0;
+   m_num_late = 0;
+   m_num_useless = 0;
+}
+
+void
+Prefetcher::reset()
+{
+   initializePerformanceCounters();
+}
+
+void
+Prefetcher::outputSummary(std::ostream& out)
+{
+   out << "  Prefetcher " << m_name << " (" << m_type << "):" << std::endl;
+   out << "    num prefetches issued: " << m_num_issued << std::endl;
+   out << "    num useful prefetches: " << m_num_useful << std::endl;
+   out << "    num late prefetches: " << m_num_late << std::endl;
+   out << "    num useless prefetches: " << m_num_useless << std::endl;
+}
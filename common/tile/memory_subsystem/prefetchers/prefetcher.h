@@ -0,0 +1,77 @@
+#ifndef __PREFETCHER_H__
+#define __PREFETCHER_H__
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "fixed_types.h"
+
+// Hardware prefetcher of a cache controller. It is trained on the demand
+// accesses seen by the controller and returns the cache lines to fetch
+// ahead of them. Prefetches never cross a page boundary
+class Prefetcher
+{
+   public:
+      enum Type
+      {
+         NEXT_LINE = 0,
+         STRIDE,
+         STREAM,
+         NUM_PREFETCHER_TYPES
+      };
+
+      Prefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance);
+      virtual ~Prefetcher();
+
+      // Returns NULL if 'type' is "none"
+      static Prefetcher* create(std::string name, std::string type,
+            UInt32 cache_block_size, UInt32 degree, UInt32 distance);
+      static Type parseType(std::string type);
+
+      // 'address' is cache block aligned. Appends the addresses of the cache
+      // blocks to prefetch to 'prefetch_address_list'
+      virtual void getPrefetchAddresses(IntPtr address, bool miss,
+            std::vector<IntPtr>& prefetch_address_list) = 0;
+
+      // Prefetch Counters
+      void recordIssued() { if (m_enabled) m_num_issued ++; }
+      // A demand access found the prefetched block in the cache
+      void recordUseful() { if (m_enabled) m_num_useful ++; }
+      // A demand access found the prefetch still in flight
+      void recordLate() { if (m_enabled) m_num_late ++; }
+      // The prefetched block left the cache before any demand access
+      void recordUseless() { if (m_enabled) m_num_useless ++; }
+
+      void enable() { m_enabled = true; }
+      void disable() { m_enabled = false; }
+      void reset();
+
+      void outputSummary(std::ostream& out);
+
+   protected:
+      static const IntPtr PAGE_SIZE = 4096;
+
+      UInt32 m_cache_block_size;
+      UInt32 m_degree;
+      UInt32 m_distance;
+
+      // Appends 'm_degree' blocks, 'stride' blocks apart, starting
+      // 'm_distance' strides away from 'address'
+      void addPrefetchAddresses(IntPtr address, SInt64 stride,
+            std::vector<IntPtr>& prefetch_address_list);
+
+   private:
+      std::string m_name;
+      std::string m_type;
+      bool m_enabled;
+
+      UInt64 m_num_issued;
+      UInt64 m_num_useful;
+      UInt64 m_num_late;
+      UInt64 m_num_useless;
+
+      void initializePerformanceCounters();
+};
+
+#endif /* __PREFETCHER_H__ */
@@ -0,0 +1,72 @@
+#include "stream_prefetcher.h"
+
+StreamPrefetcher::StreamPrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance):
+   Prefetcher(name, cache_block_size, degree, distance),
+   m_num_accesses(0)
+{
+   m_streams = new Stream[NUM_STREAMS];
+   for (UInt32 i = 0; i < NUM_STREAMS; i++)
+   {
+      m_streams[i].m_last_block = 0;
+      m_streams[i].m_direction = 0;
+      m_streams[i].m_confidence = 0;
+      m_streams[i].m_last_use = 0;
+      m_streams[i].m_valid = false;
+   }
+}
+
+StreamPrefetcher::~StreamPrefetcher()
+{
+   delete [] m_streams;
+}
+
+void
+StreamPrefetcher::getPrefetchAddresses(IntPtr address, bool miss,
+      std::vector<IntPtr>& prefetch_address_list)
+{
+   IntPtr block = address / m_cache_block_size;
+   m_num_accesses ++;
+
+   // Find the stream this access belongs to, or the least recently used one
+   UInt32 victim = 0;
+   for (UInt32 i = 0; i < NUM_STREAMS; i++)
+   {
+      Stream& stream = m_streams[i];
+      if (stream.m_valid)
+      {
+         SInt64 delta = (SInt64) (block - stream.m_last_block);
+         if ((delta != 0) && (delta >= -TRAINING_WINDOW) && (delta <= TRAINING_WINDOW))
+         {
+            SInt64 direction = (delta > 0) ? 1 : -1;
+            if (direction == stream.m_direction)
+               stream.m_confidence ++;
+            else
+            {
+               stream.m_direction = direction;
+               stream.m_confidence = 1;
+            }
+            stream.m_last_block = block;
+            stream.m_last_use = m_num_accesses;
+
+            if (stream.m_confidence >= PREFETCH_CONFIDENCE)
+               addPrefetchAddresses(address, stream.m_direction, prefetch_address_list);
+            return;
+         }
+      }
+
+      if (!m_streams[victim].m_valid)
+         continue;
+      if ((!stream.m_valid) || (stream.m_last_use < m_streams[victim].m_last_use))
+         victim = i;
+   }
+
+   // Only misses start new streams
+   if (miss)
+   {
+      m_streams[victim].m_last_block = block;
+      m_streams[victim].m_direction = 0;
+      m_streams[victim].m_confidence = 0;
+      m_streams[victim].m_last_use = m_num_accesses;
+      m_streams[victim].m_valid = true;
+   }
+}
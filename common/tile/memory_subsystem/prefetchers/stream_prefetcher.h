@@ -0,0 +1,38 @@
+#ifndef __STREAM_PREFETCHER_H__
+#define __STREAM_PREFETCHER_H__
+
+#include "prefetcher.h"
+
+// Stream prefetcher: tracks a few streams of misses that move through
+// memory in one direction. Once a stream has advanced twice in the same
+// direction, every further access to it prefetches ahead of it
+class StreamPrefetcher : public Prefetcher
+{
+   public:
+      StreamPrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance);
+      ~StreamPrefetcher();
+
+      void getPrefetchAddresses(IntPtr address, bool miss,
+            std::vector<IntPtr>& prefetch_address_list);
+
+   private:
+      static const UInt32 NUM_STREAMS = 16;
+      // A miss within this many blocks of a stream's head belongs to it
+      static const SInt64 TRAINING_WINDOW = 16;
+      static const UInt32 PREFETCH_CONFIDENCE = 2;
+
+      class Stream
+      {
+         public:
+            IntPtr m_last_block;
+            SInt64 m_direction;
+            UInt32 m_confidence;
+            UInt64 m_last_use;
+            bool m_valid;
+      };
+
+      Stream* m_streams;
+      UInt64 m_num_accesses;
+};
+
+#endif /* __STREAM_PREFETCHER_H__ */
@@ -0,0 +1,58 @@
+#include "stride_prefetcher.h"
+
+StridePrefetcher::StridePrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance):
+   Prefetcher(name, cache_block_size, degree, distance)
+{
+   m_table = new TableEntry[NUM_TABLE_ENTRIES];
+   for (UInt32 i = 0; i < NUM_TABLE_ENTRIES; i++)
+   {
+      m_table[i].m_page = ~((IntPtr) 0);
+      m_table[i].m_last_block = 0;
+      m_table[i].m_stride = 0;
+      m_table[i].m_confidence = 0;
+   }
+}
+
+StridePrefetcher::~StridePrefetcher()
+{
+   delete [] m_table;
+}
+
+void
+StridePrefetcher::getPrefetchAddresses(IntPtr address, bool miss,
+      std::vector<IntPtr>& prefetch_address_list)
+{
+   IntPtr page = address / PAGE_SIZE;
+   IntPtr block = address / m_cache_block_size;
+   TableEntry& entry = m_table[page % NUM_TABLE_ENTRIES];
+
+   if (entry.m_page != page)
+   {
+      entry.m_page = page;
+      entry.m_last_block = block;
+      entry.m_stride = 0;
+      entry.m_confidence = 0;
+      return;
+   }
+
+   SInt64 stride = (SInt64) (block - entry.m_last_block);
+   if (stride == 0)
+      return;
+
+   if (stride == entry.m_stride)
+   {
+      if (entry.m_confidence < MAX_CONFIDENCE)
+         entry.m_confidence ++;
+   }
+   else
+   {
+      if (entry.m_confidence > 0)
+         entry.m_confidence --;
+      if (entry.m_confidence == 0)
+         entry.m_stride = stride;
+   }
+   entry.m_last_block = block;
+
+   if (entry.m_confidence >= PREFETCH_CONFIDENCE)
+      addPrefetchAddresses(address, entry.m_stride, prefetch_address_list);
+}
@@ -0,0 +1,36 @@
+#ifndef __STRIDE_PREFETCHER_H__
+#define __STRIDE_PREFETCHER_H__
+
+#include "prefetcher.h"
+
+// Stride prefetcher with a reference prediction table. Hardware IP-stride
+// prefetchers index the table by the instruction pointer, which does not
+// reach the memory system here, so the table is indexed by page instead:
+// each entry follows the stride between successive accesses to a page
+class StridePrefetcher : public Prefetcher
+{
+   public:
+      StridePrefetcher(std::string name, UInt32 cache_block_size, UInt32 degree, UInt32 distance);
+      ~StridePrefetcher();
+
+      void getPrefetchAddresses(IntPtr address, bool miss,
+            std::vector<IntPtr>& prefetch_address_list);
+
+   private:
+      static const UInt32 NUM_TABLE_ENTRIES = 64;
+      static const UInt32 MAX_CONFIDENCE = 3;
+      static const UInt32 PREFETCH_CONFIDENCE = 2;
+
+      class TableEntry
+      {
+         public:
+            IntPtr m_page;
+            IntPtr m_last_block;
+            SInt64 m_stride;
+            UInt32 m_confidence;
+      };
+
+      TableEntry* m_table;
+};
+
+#endif /* __STRIDE_PREFETCHER_H__ */
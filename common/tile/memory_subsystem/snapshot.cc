@@ -0,0 +1,163 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <sstream>
+
+#include "snapshot.h"
+#include "log.h"
+
+SnapshotWriter::SnapshotWriter(tile_id_t tile_id)
+{
+   write<UInt64>(Snapshot::MAGIC);
+   write<UInt32>(Snapshot::VERSION);
+   write<SInt32>(tile_id);
+}
+
+SnapshotWriter::~SnapshotWriter()
+{}
+
+void
+SnapshotWriter::writeBytes(const void* buf, UInt64 size)
+{
+   const Byte* bytes = (const Byte*) buf;
+   m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+void
+SnapshotWriter::writeString(const std::string& str)
+{
+   write<UInt32>(str.size());
+   writeBytes(str.data(), str.size());
+}
+
+UInt64
+SnapshotWriter::beginSection()
+{
+   UInt64 section_offset = m_buffer.size();
+   write<UInt64>(0);
+   return section_offset;
+}
+
+void
+SnapshotWriter::endSection(UInt64 section_offset)
+{
+   UInt64 section_length = m_buffer.size() - (section_offset + sizeof(UInt64));
+   memcpy(&m_buffer[section_offset], &section_length, sizeof(UInt64));
+}
+
+void
+SnapshotWriter::writeToFile(const std::string& filename)
+{
+   int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+   LOG_ASSERT_ERROR(fd != -1, "Could not create snapshot(%s): %s", filename.c_str(), strerror(errno));
+
+   int ret = ftruncate(fd, m_buffer.size());
+   LOG_ASSERT_ERROR(ret == 0, "Could not size snapshot(%s): %s", filename.c_str(), strerror(errno));
+
+   void* mapping = mmap(NULL, m_buffer.size(), PROT_WRITE, MAP_SHARED, fd, 0);
+   LOG_ASSERT_ERROR(mapping != MAP_FAILED, "Could not map snapshot(%s): %s", filename.c_str(), strerror(errno));
+
+   memcpy(mapping, &m_buffer[0], m_buffer.size());
+
+   munmap(mapping, m_buffer.size());
+   close(fd);
+
+   LOG_PRINT("Wrote snapshot(%s), %llu bytes", filename.c_str(), (UInt64) m_buffer.size());
+}
+
+SnapshotReader::SnapshotReader(const std::string& filename, tile_id_t tile_id):
+   m_filename(filename),
+   m_offset(0)
+{
+   int fd = open(filename.c_str(), O_RDONLY);
+   LOG_ASSERT_ERROR(fd != -1, "Could not open snapshot(%s): %s", filename.c_str(), strerror(errno));
+
+   struct stat file_stat;
+   int ret = fstat(fd, &file_stat);
+   LOG_ASSERT_ERROR(ret == 0, "Could not stat snapshot(%s): %s", filename.c_str(), strerror(errno));
+   m_size = file_stat.st_size;
+
+   void* mapping = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   LOG_ASSERT_ERROR(mapping != MAP_FAILED, "Could not map snapshot(%s): %s", filename.c_str(), strerror(errno));
+   close(fd);
+   m_data = (Byte*) mapping;
+
+   UInt64 magic = read<UInt64>();
+   UInt32 version = read<UInt32>();
+   SInt32 snapshot_tile_id = read<SInt32>();
+   LOG_ASSERT_ERROR(magic == Snapshot::MAGIC, "%s is not a snapshot", filename.c_str());
+   LOG_ASSERT_ERROR(version == Snapshot::VERSION, "Snapshot(%s) version(%u), expected(%u)",
+         filename.c_str(), version, Snapshot::VERSION);
+   LOG_ASSERT_ERROR(snapshot_tile_id == tile_id, "Snapshot(%s) was taken on tile(%i), loading on tile(%i)",
+         filename.c_str(), snapshot_tile_id, tile_id);
+}
+
+SnapshotReader::~SnapshotReader()
+{
+   munmap(m_data, m_size);
+}
+
+void
+SnapshotReader::readBytes(void* buf, UInt64 size)
+{
+   LOG_ASSERT_ERROR(m_offset + size <= m_size, "Snapshot(%s) is truncated: offset(%llu), size(%llu), file size(%llu)",
+         m_filename.c_str(), m_offset, size, m_size);
+   memcpy(buf, &m_data[m_offset], size);
+   m_offset += size;
+}
+
+std::string
+SnapshotReader::readString()
+{
+   UInt32 length = read<UInt32>();
+   LOG_ASSERT_ERROR(m_offset + length <= m_size, "Snapshot(%s) is truncated", m_filename.c_str());
+   std::string str((const char*) &m_data[m_offset], length);
+   m_offset += length;
+   return str;
+}
+
+void
+SnapshotReader::skip(UInt64 size)
+{
+   LOG_ASSERT_ERROR(m_offset + size <= m_size, "Snapshot(%s) is truncated", m_filename.c_str());
+   m_offset += size;
+}
+
+UInt64
+SnapshotReader::beginSection()
+{
+   UInt64 section_length = read<UInt64>();
+   LOG_ASSERT_ERROR(m_offset + section_length <= m_size, "Snapshot(%s) is truncated", m_filename.c_str());
+   return m_offset + section_length;
+}
+
+void
+SnapshotReader::endSection(UInt64 section_end)
+{
+   LOG_ASSERT_ERROR(m_offset == section_end, "Snapshot(%s): section ends at(%llu), read up to(%llu)",
+         m_filename.c_str(), section_end, m_offset);
+}
+
+void
+SnapshotReader::skipSection(UInt64 section_end)
+{
+   m_offset = section_end;
+}
+
+void
+SnapshotReader::finish()
+{
+   LOG_ASSERT_ERROR(m_offset == m_size, "Snapshot(%s): %llu trailing bytes",
+         m_filename.c_str(), m_size - m_offset);
+}
+
+std::string
+Snapshot::getFilename(const std::string& dir, tile_id_t tile_id)
+{
+   std::ostringstream filename;
+   filename << dir << "/tile_" << tile_id << ".snapshot";
+   return filename.str();
+}
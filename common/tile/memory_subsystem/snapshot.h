@@ -0,0 +1,74 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include <string>
+#include <vector>
+
+#include "fixed_types.h"
+
+// Binary snapshot of the warmed state of a tile's memory system (cache tags
+// and state, directory entries, DRAM backing data). Each tile writes its own
+// file, so that the tiles of a process can be saved in parallel.
+//
+// File layout: a header (magic, version, tile id) followed by the raw
+// records written by the memory components in a fixed order. Records that a
+// loader may have to skip (e.g., replacement state when the policy differs)
+// are wrapped in a length-prefixed section.
+
+class SnapshotWriter
+{
+   public:
+      SnapshotWriter(tile_id_t tile_id);
+      ~SnapshotWriter();
+
+      void writeBytes(const void* buf, UInt64 size);
+      template <class T> void write(const T& value) { writeBytes(&value, sizeof(T)); }
+      void writeString(const std::string& str);
+
+      // Reserves the length field of a section; returns its offset
+      UInt64 beginSection();
+      void endSection(UInt64 section_offset);
+
+      // Sizes the file, maps it and copies the buffered snapshot in one go
+      void writeToFile(const std::string& filename);
+
+   private:
+      std::vector<Byte> m_buffer;
+};
+
+class SnapshotReader
+{
+   public:
+      // Maps the file read-only and checks the header
+      SnapshotReader(const std::string& filename, tile_id_t tile_id);
+      ~SnapshotReader();
+
+      void readBytes(void* buf, UInt64 size);
+      template <class T> T read() { T value; readBytes(&value, sizeof(T)); return value; }
+      std::string readString();
+      void skip(UInt64 size);
+
+      // Returns the offset at which the section ends
+      UInt64 beginSection();
+      void endSection(UInt64 section_end);
+      void skipSection(UInt64 section_end);
+
+      // Every byte of the snapshot must have been consumed
+      void finish();
+
+   private:
+      std::string m_filename;
+      Byte* m_data;
+      UInt64 m_size;
+      UInt64 m_offset;
+};
+
+namespace Snapshot
+{
+   static const UInt64 MAGIC = 0x544f4853504e5347ULL;   // "GSNPSHOT"
+   static const UInt32 VERSION = 3;
+
+   std::string getFilename(const std::string& dir, tile_id_t tile_id);
+}
+
+#endif /* __SNAPSHOT_H__ */
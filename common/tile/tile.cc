@@ -27,12 +27,19 @@ Tile::Tile(SInt32 id)
    m_memory_manager = (MemoryManagerBase *) NULL;
 
    m_main_core = Core::create(this, MAIN_CORE_TYPE);
+
+   // The PEP core uses the memory models created by the main core
+   m_pep_core = (Core*) NULL;
+   if (Config::getSingleton()->getEnablePepCores())
+      m_pep_core = Core::create(this, PEP_CORE_TYPE);
 }
 
 Tile::~Tile()
 {
 
    LOG_PRINT("Deleting tile with id %d", this->getId());
+   if (m_pep_core)
+      delete m_pep_core;
    delete m_main_core;
 }
 
@@ -62,6 +69,8 @@ void Tile::enablePerformanceModels()
    getCore()->getShmemPerfModel()->enable();
    getCore()->getMemoryManager()->enableModels();
    getCore()->getPerformanceModel()->enable();
+   if (m_pep_core)
+      m_pep_core->getPerformanceModel()->enable();
 }
 
 void Tile::disablePerformanceModels()
@@ -74,6 +83,8 @@ void Tile::disablePerformanceModels()
    getCore()->getShmemPerfModel()->disable();
    getCore()->getMemoryManager()->disableModels();
    getCore()->getPerformanceModel()->disable();
+   if (m_pep_core)
+      m_pep_core->getPerformanceModel()->disable();
 }
 
 void Tile::resetPerformanceModels()
@@ -85,12 +96,16 @@ void Tile::resetPerformanceModels()
    getCore()->getMemoryManager()->resetModels();
    getCore()->getNetwork()->resetModels();
    getCore()->getPerformanceModel()->reset();
+   if (m_pep_core)
+      m_pep_core->getPerformanceModel()->reset();
 }
 
 void
 Tile::updateInternalVariablesOnFrequencyChange(volatile float frequency)
 {
    getCore()->getPerformanceModel()->updateInternalVariablesOnFrequencyChange(frequency);
+   if (m_pep_core)
+      m_pep_core->getPerformanceModel()->updateInternalVariablesOnFrequencyChange(frequency);
    getCore()->getShmemPerfModel()->updateInternalVariablesOnFrequencyChange(frequency);
    getCore()->getMemoryManager()->updateInternalVariablesOnFrequencyChange(frequency);
 }
@@ -101,6 +116,8 @@ Core* Tile::getCore(core_id_t core_id)
 
    if (this->isMainCore(core_id))
       res = m_main_core;
+   else if (this->isPepCore(core_id))
+      res = m_pep_core;
 
    LOG_ASSERT_ERROR(res != NULL, "Invalid core id!");
    return res;
@@ -109,6 +126,8 @@ Core* Tile::getCore(core_id_t core_id)
 // This method is used for differentiating different cores if you decide to add different types of cores per tile.
 Core* Tile::getCurrentCore()
 {
+   if (m_pep_core && Sim()->getTileManager()->amiHelperThread())
+      return m_pep_core;
    return getCore();
 }
 
@@ -116,8 +135,18 @@ core_id_t Tile::getMainCoreId()
 {
    return (core_id_t) {m_tile_id, MAIN_CORE_TYPE};
 }
+core_id_t Tile::getPepCoreId()
+{
+   return (core_id_t) {m_tile_id, PEP_CORE_TYPE};
+}
+
 bool Tile::isMainCore(core_id_t core_id)
 {
    return (core_id.core_type == MAIN_CORE_TYPE);
 }
 
+bool Tile::isPepCore(core_id_t core_id)
+{
+   return (core_id.core_type == PEP_CORE_TYPE);
+}
+
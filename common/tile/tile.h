@@ -39,11 +39,14 @@ class Tile
       Core* getCore(core_id_t core_id);
       Core* getCurrentCore();
       Core* getCore() {return m_main_core; }
+      Core* getPepCore() { return m_pep_core; }
       MemoryManagerBase *getMemoryManager() { return m_memory_manager; }
       ShmemPerfModel* getShmemPerfModel() { return m_shmem_perf_model; }
 
       core_id_t getMainCoreId();
+      core_id_t getPepCoreId();
       bool isMainCore(core_id_t core_id);
+      bool isPepCore(core_id_t core_id);
 
       void setMemoryManager(MemoryManagerBase *memory_manager) { m_memory_manager = memory_manager; }
       void setShmemPerfModel(ShmemPerfModel *shmem_perf_model) { m_shmem_perf_model = shmem_perf_model; }
@@ -59,6 +62,8 @@ class Tile
       MemoryManagerBase *m_memory_manager;
       Network *m_network;
       Core *m_main_core;
+      // NULL if general/enable_pep_cores is not set
+      Core *m_pep_core;
       ShmemPerfModel* m_shmem_perf_model;
 
 };
@@ -2,6 +2,7 @@
 
 #include "smtransport.h"
 #include "config.h"
+#include "msg_pool.h"
 #include "log.h"
 
 // -- SmTransport -- //
@@ -72,6 +73,7 @@ void SmTransport::clearNodeForId(tile_id_t tile_id)
 
 SmTransport::SmNode::SmNode(tile_id_t tile_id, SmTransport *smt)
    : Node(tile_id)
+   , m_queue(QUEUE_SIZE)
    , m_smt(smt)
 {
 }
@@ -95,51 +97,45 @@ void SmTransport::SmNode::send(SInt32 dest_id, const void* buffer, UInt32 length
    send(dest_node, buffer, length);
 }
 
+void SmTransport::SmNode::sendBuffer(SInt32 dest_id, Byte* buffer, UInt32 length)
+{
+   SmNode *dest_node = m_smt->getNodeFromId(dest_id);
+   LOG_ASSERT_ERROR(dest_node != NULL, "Attempt to send to non-existent node: %d", dest_id);
+   enqueue(dest_node, buffer, length);
+}
+
 void SmTransport::SmNode::send(SmNode *dest_node, const void *buffer, UInt32 length)
 {
-   Byte *data = new Byte[length];
+   // Tile nodes receive MsgPool buffers, the global node heap buffers
+   Byte *data = (dest_node->getTileId() >= 0) ? MsgPool::allocBuffer(length) : new Byte[length];
    memcpy(data, buffer, length);
+   enqueue(dest_node, data, length);
+}
 
+void SmTransport::SmNode::enqueue(SmNode *dest_node, Byte *data, UInt32 length)
+{
    LOG_PRINT("sending msg -- size: %i, data: %p, dest: %p", length, data, dest_node);
 
-   dest_node->m_lock.acquire();
    dest_node->m_queue.push(data);
-   dest_node->m_lock.release();
-   dest_node->m_cond.broadcast();
 }
 
 Byte* SmTransport::SmNode::recv()
 {
    LOG_PRINT("attempting recv -- this: %p", this);
 
-   m_lock.acquire();
+   Byte *data = m_queue.pop();
 
-   while (true)
-   {
-      if (!m_queue.empty())
-      {
-         Byte *data = m_queue.front();
-         m_queue.pop();
-         m_lock.release();
+   LOG_PRINT("msg recv'd -- data: %p, this: %p", data, this);
 
-         LOG_PRINT("msg recv'd -- data: %p, this: %p", data, this);
+   return data;
+}
 
-         return data;
-      }
-      else
-      {
-         m_cond.wait(m_lock);
-      }
-   }
+UInt32 SmTransport::SmNode::recvBatch(Byte** buffers, UInt32 max_buffers)
+{
+   return m_queue.popBatch(buffers, max_buffers);
 }
 
 bool SmTransport::SmNode::query()
 {
-   bool result = false;
-
-   m_lock.acquire();
-   result = !m_queue.empty();
-   m_lock.release();
-
-   return result;
+   return !m_queue.empty();
 }
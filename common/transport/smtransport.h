@@ -1,10 +1,8 @@
 #ifndef SMTRANSPORT_H
 #define SMTRANSPORT_H
 
-#include <queue>
-
 #include "transport.h"
-#include "cond.h"
+#include "mpsc_queue.h"
 
 class SmTransport : public Transport
 {
@@ -20,15 +18,19 @@ public:
 
       void globalSend(SInt32, const void*, UInt32);
       void send(tile_id_t, const void*, UInt32);
+      void sendBuffer(tile_id_t, Byte*, UInt32);
       Byte* recv();
+      UInt32 recvBatch(Byte** buffers, UInt32 max_buffers);
       bool query();
 
    private:
+      static const UInt32 QUEUE_SIZE = 1024;
+
       void send(SmNode *dest, const void *buffer, UInt32 length);
+      void enqueue(SmNode *dest, Byte *data, UInt32 length);
 
-      std::queue<Byte*> m_queue;
-      Lock m_lock;
-      ConditionVariable m_cond;
+      // Only the thread of the node receives
+      MpscQueue<Byte*> m_queue;
       SmTransport *m_smt;
    };
 
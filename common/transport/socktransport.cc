@@ -14,6 +14,7 @@
 #include "config.h"
 #include "simulator.h" //interface to config file singleton
 #include "socktransport.h"
+#include "msg_pool.h"
 
 // #define __CHECKSUM_ENABLED__     1
 
@@ -119,14 +120,9 @@ void SockTransport::initBufferLists()
       = Config::getSingleton()->getTotalTiles() // for tiles
       + 1; // for global node
 
-   m_buffer_lists = new buffer_list[m_num_lists];
-
-#ifdef __CHECKSUM_ENABLED__
-   m_header_lists = new std::list<Header*>[m_num_lists];
-#endif // __CHECKSUM_ENABLED__
-
-   m_buffer_list_locks = new Lock[m_num_lists];
-   m_buffer_list_sems = new Semaphore[m_num_lists];
+   m_buffer_queues = new buffer_queue* [m_num_lists];
+   for (SInt32 i = 0; i < m_num_lists; i++)
+      m_buffer_queues[i] = new buffer_queue(BUFFER_QUEUE_SIZE);
 }
 
 void SockTransport::updateThreadFunc(void *vp)
@@ -168,7 +164,7 @@ void SockTransport::updateBufferLists()
          m_recv_sockets[i].recv(&tag, sizeof(tag), true);
 
          // now receive packet
-         Byte *buffer = new Byte[length];
+         Byte *buffer = allocBuffer(tag, length);
          m_recv_sockets[i].recv(buffer, length, true);
 
 #ifdef __CHECKSUM_ENABLED__
@@ -221,16 +217,33 @@ void SockTransport::insertInBufferList(SInt32 tag, Byte *buffer, Header* header)
       tag = m_num_lists - 1;
 
    LOG_ASSERT_ERROR(0 <= tag && tag < m_num_lists, "Unexpected tag value: %d", tag);
-   m_buffer_list_locks[tag].acquire();
-   m_buffer_lists[tag].push_back(buffer);
 
+   QueuedBuffer queued_buffer;
+   queued_buffer.buffer = buffer;
+   queued_buffer.header = header;
+   m_buffer_queues[tag]->push(queued_buffer);
+}
+
+Byte* SockTransport::getCheckedBuffer(const QueuedBuffer& queued_buffer)
+{
 #ifdef __CHECKSUM_ENABLED__
-   m_header_lists[tag].push_back(header);
+   Header* header = queued_buffer.header;
+   LOG_ASSERT_ERROR(header->m_checksum == computeCheckSum(queued_buffer.buffer, header->m_length),
+         "Checksum Error: computed checksum(%llu), received checksum(%llu), received length(%u)",
+         computeCheckSum(queued_buffer.buffer, header->m_length), header->m_checksum, header->m_length);
+
+   delete header;
 #endif // __CHECKSUM_ENABLED__
-   
-   m_buffer_list_locks[tag].release();
-   
-   m_buffer_list_sems[tag].signal();
+
+   return queued_buffer.buffer;
+}
+
+Byte* SockTransport::allocBuffer(SInt32 tag, UInt32 length)
+{
+   if (tag >= 0)
+      return MsgPool::allocBuffer(length);
+   else
+      return new Byte[length];
 }
 
 void SockTransport::terminateUpdateThread()
@@ -257,14 +270,9 @@ SockTransport::~SockTransport()
    terminateUpdateThread();
    delete m_update_thread;
 
-   delete [] m_buffer_list_sems;
-   delete [] m_buffer_list_locks;
-
-#ifdef __CHECKSUM_ENABLED__
-   delete [] m_header_lists;
-#endif // __CHECKSUM_ENABLED__
-
-   delete [] m_buffer_lists;
+   for (SInt32 i = 0; i < m_num_lists; i++)
+      delete m_buffer_queues[i];
+   delete [] m_buffer_queues;
 
    for (SInt32 i = 0; i < m_num_procs; i++)
    {
@@ -348,54 +356,60 @@ void SockTransport::SockNode::send(tile_id_t dest_tile,
    send(dest_proc, dest_tile, buffer, length);
 }
 
-Byte* SockTransport::SockNode::recv()
+void SockTransport::SockNode::sendBuffer(tile_id_t dest_tile,
+                                         Byte *buffer,
+                                         UInt32 length)
 {
-   LOG_PRINT("Entering recv");
-
-   tile_id_t tag = getTileId();
-   tag = (tag == GLOBAL_TAG) ? m_transport->m_num_lists - 1 : tag;
-   
-   m_transport->m_buffer_list_sems[tag].wait();
+   int dest_proc = Config::getSingleton()->getProcessNumForTile(dest_tile);
 
-   Lock &lock = m_transport->m_buffer_list_locks[tag];
-   lock.acquire();
-   
-   buffer_list &list = m_transport->m_buffer_lists[tag];
-   LOG_ASSERT_ERROR(!list.empty(), "Buffer list empty after waiting on semaphore.");
-   Byte* buffer = list.front();
-   list.pop_front();
+   if (dest_proc != m_transport->m_proc_index)
+   {
+      send(dest_proc, dest_tile, buffer, length);
+      MsgPool::freeBuffer(buffer);
+      return;
+   }
 
+   // Same process: the buffer itself is queued for the receiver
 #ifdef __CHECKSUM_ENABLED__
-   std::list<Header*> &header_list = m_transport->m_header_lists[tag];
-   Header* header = header_list.front();
-   header_list.pop_front();
-   
-   LOG_ASSERT_ERROR(header->m_checksum == computeCheckSum(buffer, header->m_length),
-         "Checksum Error: computed checksum(%llu), received checksum(%llu), received length(%u)",
-         computeCheckSum(buffer, header->m_length), header->m_checksum, header->m_length);
-
-   delete header;
+   Header* header = new Header(length, computeCheckSum(buffer, length));
+   m_transport->insertInBufferList(dest_tile, buffer, header);
+#else
+   m_transport->insertInBufferList(dest_tile, buffer);
 #endif // __CHECKSUM_ENABLED__
 
-   lock.release();
+   LOG_PRINT("Message buffer sent.");
+}
+
+SInt32 SockTransport::SockNode::getQueueIndex()
+{
+   tile_id_t tag = getTileId();
+   return (tag == GLOBAL_TAG) ? m_transport->m_num_lists - 1 : tag;
+}
+
+Byte* SockTransport::SockNode::recv()
+{
+   LOG_PRINT("Entering recv");
+
+   Byte* buffer = getCheckedBuffer(m_transport->m_buffer_queues[getQueueIndex()]->pop());
 
    LOG_PRINT("Message recv'd");
 
    return buffer;
 }
 
-bool SockTransport::SockNode::query()
+UInt32 SockTransport::SockNode::recvBatch(Byte** buffers, UInt32 max_buffers)
 {
-   tile_id_t tag = getTileId();
-   tag = (tag == GLOBAL_TAG) ? m_transport->m_num_lists - 1 : tag;
-
-   buffer_list &list = m_transport->m_buffer_lists[tag];
-   Lock &lock = m_transport->m_buffer_list_locks[tag];
+   if (m_queued_buffers.size() < max_buffers)
+      m_queued_buffers.resize(max_buffers);
+   UInt32 num_buffers = m_transport->m_buffer_queues[getQueueIndex()]->popBatch(&m_queued_buffers[0], max_buffers);
+   for (UInt32 i = 0; i < num_buffers; i++)
+      buffers[i] = getCheckedBuffer(m_queued_buffers[i]);
+   return num_buffers;
+}
 
-   lock.acquire();
-   bool result = !list.empty();
-   lock.release();
-   return result;
+bool SockTransport::SockNode::query()
+{
+   return !m_transport->m_buffer_queues[getQueueIndex()]->empty();
 }
 
 void SockTransport::SockNode::send(SInt32 dest_proc, 
@@ -413,7 +427,7 @@ void SockTransport::SockNode::send(SInt32 dest_proc,
 
    if (dest_proc == m_transport->m_proc_index)
    {
-      Byte *buff_cpy = new Byte[length];
+      Byte *buff_cpy = allocBuffer(tag, length);
       memcpy(buff_cpy, buffer, length);
 
 #ifdef __CHECKSUM_ENABLED__
@@ -4,11 +4,23 @@
 #include "transport.h"
 #include "thread.h"
 #include "semaphore.h"
+#include "mpsc_queue.h"
 
 #include <list>
+#include <vector>
 
 class SockTransport : public Transport
 {
+private:
+   struct Header;
+
+   // A buffer queued for a node (with its checksum header, if enabled)
+   struct QueuedBuffer
+   {
+      Byte *buffer;
+      Header *header;
+   };
+
 public:
    SockTransport();
    ~SockTransport();
@@ -21,13 +33,18 @@ public:
 
       void globalSend(SInt32 dest_proc, const void *buffer, UInt32 length);
       void send(tile_id_t dest_tile, const void *buffer, UInt32 length);
+      void sendBuffer(tile_id_t dest_tile, Byte *buffer, UInt32 length);
       Byte* recv();
+      UInt32 recvBatch(Byte** buffers, UInt32 max_buffers);
       bool query();
 
    private:
       void send(SInt32 dest_proc, UInt32 tag, const void *buffer, UInt32 length);
+      SInt32 getQueueIndex();
 
       SockTransport *m_transport;
+      // recvBatch() pops into it; only the thread of the node uses it
+      std::vector<QueuedBuffer> m_queued_buffers;
    };
 
    Node *createNode(tile_id_t tile_id);
@@ -56,6 +73,8 @@ private:
    void initSockets();
    void initBufferLists();
    void insertInBufferList(SInt32 tag, Byte *buffer, Header* header = NULL);
+   // Tile buffers come from the MsgPool, the others from the heap
+   static Byte* allocBuffer(SInt32 tag, UInt32 length);
 
    static void updateThreadFunc(void *vp);
    void updateBufferLists();
@@ -114,13 +133,14 @@ private:
    Thread *m_update_thread;
    UpdateThreadState m_update_thread_state;
 
-   typedef std::list<Byte*> buffer_list;
+   static const UInt32 BUFFER_QUEUE_SIZE = 1024;
+
+   // Only the thread of a node receives from its queue
+   typedef MpscQueue<QueuedBuffer> buffer_queue;
    SInt32 m_num_lists;
-   buffer_list *m_buffer_lists;
-   std::list<Header*> *m_header_lists;
+   buffer_queue **m_buffer_queues;
 
-   Lock *m_buffer_list_locks;
-   Semaphore *m_buffer_list_sems;
+   static Byte* getCheckedBuffer(const QueuedBuffer& queued_buffer);
 };
 
 #endif // SOCK_TRANSPORT_H
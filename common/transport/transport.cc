@@ -8,6 +8,7 @@
 #include "socktransport.h"
 
 #include "config.h"
+#include "msg_pool.h"
 #include "log.h"
 
 // -- Transport -- //
@@ -52,6 +53,23 @@ Transport::Node::Node(tile_id_t tile_id)
 {
 }
 
+void Transport::Node::sendBuffer(tile_id_t dest, Byte *buffer, UInt32 length)
+{
+   send(dest, buffer, length);
+   MsgPool::freeBuffer(buffer);
+}
+
+UInt32 Transport::Node::recvBatch(Byte** buffers, UInt32 max_buffers)
+{
+   assert(max_buffers > 0);
+
+   buffers[0] = recv();
+   UInt32 num_buffers = 1;
+   while ((num_buffers < max_buffers) && query())
+      buffers[num_buffers ++] = recv();
+   return num_buffers;
+}
+
 tile_id_t Transport::Node::getTileId()
 {
    return m_tile_id;
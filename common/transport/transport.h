@@ -17,7 +17,14 @@ public:
 
       virtual void globalSend(SInt32 dest_proc, const void *buffer, UInt32 length) = 0;
       virtual void send(tile_id_t dest, const void *buffer, UInt32 length) = 0;
+      // Hands a MsgPool buffer over to the transport, which frees it.
+      // Within a process the buffer itself reaches the receiver
+      virtual void sendBuffer(tile_id_t dest, Byte *buffer, UInt32 length);
+      // Buffers received by a tile node are MsgPool buffers (free them with
+      // MsgPool::freeBuffer()); those received by the global node are new[]'d
       virtual Byte* recv() = 0;
+      // Waits for a buffer, then also takes the ones already queued
+      virtual UInt32 recvBatch(Byte** buffers, UInt32 max_buffers);
       virtual bool query() = 0;
 
    protected:
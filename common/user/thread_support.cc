@@ -38,6 +38,16 @@ void CarbonJoinThread(carbon_thread_t tid)
    Sim()->getThreadManager()->joinThread(tid);
 }
 
+carbon_thread_t CarbonSpawnHelperThread(thread_func_t func, void *arg)
+{
+   return Sim()->getThreadManager()->spawnHelperThread(func, arg);
+}
+
+void CarbonJoinHelperThread(carbon_thread_t tid)
+{
+   Sim()->getThreadManager()->joinHelperThread(tid);
+}
+
 // Support functions provided by the simulator
 void CarbonThreadStart(ThreadSpawnRequest *req)
 {
@@ -31,6 +31,10 @@ extern "C" {
 carbon_thread_t CarbonSpawnThread(thread_func_t func, void *arg);
 void CarbonJoinThread(carbon_thread_t tid);
 
+// Helper thread on the PEP core of the calling thread's tile
+carbon_thread_t CarbonSpawnHelperThread(thread_func_t func, void *arg);
+void CarbonJoinHelperThread(carbon_thread_t tid);
+
 #ifdef __cplusplus
 }
 #endif
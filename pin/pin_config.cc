@@ -84,7 +84,14 @@ core_id_t PinConfig::getCoreIDFromStackPtr(IntPtr stack_ptr)
    }     
 
    SInt32 tile_index = (SInt32) ((stack_ptr - m_stack_lower_limit) / m_stack_size_per_core);
-   return (TileManager::getMainCoreId(Config::getSingleton()->getTileIDFromIndex(m_current_process_num, tile_index)));
+   tile_id_t tile_id = Config::getSingleton()->getTileIDFromIndex(m_current_process_num, tile_index);
+
+   // The PEP core gets the lower half of the stack of the tile
+   if (Config::getSingleton()->getEnablePepCores() &&
+       (((stack_ptr - m_stack_lower_limit) % m_stack_size_per_core) < (m_stack_size_per_core / 2)))
+      return (core_id_t) {tile_id, PEP_CORE_TYPE};
+
+   return (TileManager::getMainCoreId(tile_id));
 }
 
 SInt32 PinConfig::getStackAttributesFromCoreID (core_id_t core_id, StackAttributes& stack_attr)
@@ -97,6 +104,14 @@ SInt32 PinConfig::getStackAttributesFromCoreID (core_id_t core_id, StackAttribut
    stack_attr.lower_limit = m_stack_lower_limit + (tile_index * m_stack_size_per_core);
    stack_attr.size = m_stack_size_per_core;
 
+   // The main core and the PEP core split the stack of the tile
+   if (Config::getSingleton()->getEnablePepCores())
+   {
+      stack_attr.size = m_stack_size_per_core / 2;
+      if (core_id.core_type != PEP_CORE_TYPE)
+         stack_attr.lower_limit += stack_attr.size;
+   }
+
    return 0;
 }
 
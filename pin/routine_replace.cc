@@ -58,6 +58,8 @@ bool replaceUserAPIFunction(RTN& rtn, string& name)
    else if (name == "CarbonStopSim") msg_ptr = AFUNPTR(replacementStopSim);
    else if (name == "CarbonSpawnThread") msg_ptr = AFUNPTR(replacementSpawnThread);
    else if (name == "CarbonJoinThread") msg_ptr = AFUNPTR(replacementJoinThread);
+   else if (name == "CarbonSpawnHelperThread") msg_ptr = AFUNPTR(replacementSpawnHelperThread);
+   else if (name == "CarbonJoinHelperThread") msg_ptr = AFUNPTR(replacementJoinHelperThread);
    
    // CAPI
    else if (name == "CAPI_Initialize") msg_ptr = AFUNPTR(replacement_CAPI_Initialize);
@@ -371,6 +373,37 @@ void replacementJoinThread (CONTEXT *ctxt)
    retFromReplacedRtn (ctxt, ret_val);
 }
 
+void replacementSpawnHelperThread (CONTEXT *ctxt)
+{
+   thread_func_t func;
+   void *arg;
+
+   initialize_replacement_args (ctxt,
+         IARG_PTR, &func,
+         IARG_PTR, &arg,
+         IARG_END);
+
+   LOG_PRINT("Calling SimSpawnHelperThread");
+   ADDRINT ret_val = (ADDRINT) CarbonSpawnHelperThread (func, arg);
+
+   retFromReplacedRtn (ctxt, ret_val);
+}
+
+void replacementJoinHelperThread (CONTEXT *ctxt)
+{
+   ADDRINT tid;
+
+   initialize_replacement_args (ctxt,
+         IARG_ADDRINT, &tid,
+         IARG_END);
+
+   ADDRINT ret_val = PIN_GetContextReg (ctxt, REG_GAX);
+
+   CarbonJoinHelperThread ((int) tid);
+
+   retFromReplacedRtn (ctxt, ret_val);
+}
+
 void replacement_CAPI_Initialize (CONTEXT *ctxt)
 {
    // Only the user-threads (all of which are cores) call